@@ -2482,6 +2482,22 @@ tsapi TSReturnCode TSHttpTxnConfigStringGet(TSHttpTxn txnp, TSOverridableConfigK
 
 tsapi TSReturnCode TSHttpTxnConfigFind(const char *name, int length, TSOverridableConfigKey *conf, TSRecordDataType *type);
 
+/*
+  Overlays of overridable configurations, for overrides that apply to many
+  transactions, such as those of a remap rule. The configuration with the
+  overrides applied is built once and shared by the transactions, instead of
+  each one copying the configuration and setting the values one at a time.
+  Setting values is not thread safe, so it should be done before the overlay
+  is applied to any transaction.
+*/
+tsapi TSHttpConfigOverlay TSHttpConfigOverlayCreate(void);
+tsapi void TSHttpConfigOverlayDestroy(TSHttpConfigOverlay overlay);
+tsapi TSReturnCode TSHttpConfigOverlayIntSet(TSHttpConfigOverlay overlay, TSOverridableConfigKey conf, TSMgmtInt value);
+tsapi TSReturnCode TSHttpConfigOverlayFloatSet(TSHttpConfigOverlay overlay, TSOverridableConfigKey conf, TSMgmtFloat value);
+tsapi TSReturnCode TSHttpConfigOverlayStringSet(TSHttpConfigOverlay overlay, TSOverridableConfigKey conf, const char *value,
+                                                int length);
+tsapi TSReturnCode TSHttpTxnConfigOverlayApply(TSHttpTxn txnp, TSHttpConfigOverlay overlay);
+
 /**
    This is a generalization of the old TSHttpTxnFollowRedirect(), but gives finer
    control over the behavior. Instead of using the Location: header for the new
@@ -98,6 +98,73 @@ private:
   pcre_extra *regex_extra = nullptr;
 };
 
+/** Prefilter for a list of patterns that are tried in order.
+ *
+ * Each pattern is reduced to a literal that every match of it must contain, and the literals of
+ * all the patterns are searched for in one pass over the subject with an Aho-Corasick automaton.
+ * The result is the patterns that could match, in their original order. A pattern without a usable
+ * literal is always a candidate. Containing the literal does not mean the pattern matches, so each
+ * candidate must still be executed.
+ */
+class RegexPrefilter
+{
+public:
+  /// Literals shorter than this filter too little to be worth searching for.
+  static constexpr size_t MIN_LITERAL_LENGTH = 3;
+
+  /** Add the next pattern.
+   *
+   * @param pattern Source pattern for a regular expression.
+   *
+   * Patterns are numbered from 0 in the order they are added.
+   */
+  void add(std::string_view pattern);
+
+  /// Build the automaton. This must be called after the last @c add and before @c candidates.
+  void build();
+
+  /** Find the patterns that could match @a str.
+   *
+   * @param str String to match against.
+   * @param result Set to the indices of the candidate patterns, in increasing order.
+   *
+   * It is safe to call this method concurrently on the same instance of @a this.
+   */
+  void candidates(std::string_view str, std::vector<int> &result) const;
+
+  /// @return The number of patterns added.
+  int
+  size() const
+  {
+    return _count;
+  }
+
+  /** Find a literal contained in every string that @a pattern matches.
+   *
+   * @param pattern Source pattern for a regular expression.
+   * @return The longest such literal found, in lower case, or an empty string if there is none.
+   *
+   * This is conservative: any construct that is not understood results in an empty string.
+   */
+  static std::string required_literal(std::string_view pattern);
+
+private:
+  struct State {
+    std::vector<std::pair<unsigned char, int>> next; ///< Transitions, sorted by character.
+    std::vector<int> patterns;                       ///< Patterns whose literal ends here.
+    int fail   = 0;                                  ///< State for the longest proper suffix.
+    int output = 0;                                  ///< Closest state on the fail chain with patterns.
+  };
+
+  /// @return The state reached from @a state on @a c, following fail links as needed.
+  int step(int state, unsigned char c) const;
+
+  std::vector<State> _states;
+  std::vector<int> _always; ///< Patterns without a literal.
+  std::vector<std::pair<std::string, int>> _literals;
+  int _count = 0;
+};
+
 /** Deterministic Finite state Automata container.
  *
  * This contains a set of patterns (which may be of size 1) and matches if any of the patterns
@@ -138,5 +205,12 @@ private:
    */
   bool build(std::string_view const &pattern, unsigned flags = 0);
 
+  /// Rebuild the prefilter after patterns are added.
+  void build_prefilter();
+
+  /// Pattern sets smaller than this are matched without the prefilter.
+  static constexpr size_t PREFILTER_MIN_PATTERNS = 16;
+
   std::vector<Pattern> _patterns;
+  RegexPrefilter _prefilter;
 };
@@ -74,6 +74,8 @@ int64_t cache_config_ram_cache_cutoff          = AGG_SIZE;
 int cache_config_max_disk_errors               = 5;
 int cache_config_hit_evacuate_percent          = 10;
 int cache_config_hit_evacuate_size_limit       = 0;
+int cache_config_evacuate_prefetch_size        = 0;
+int cache_config_evacuate_prefetch_rate        = 0;
 int cache_config_force_sector_size             = 0;
 int cache_config_target_fragment_size          = DEFAULT_TARGET_FRAGMENT_SIZE;
 int cache_config_agg_write_backlog             = AGG_SIZE * 2;
@@ -1754,6 +1756,10 @@ Vol::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
     ink_assert(!gvol[vol_no]);
     gvol[vol_no] = this;
     SET_HANDLER(&Vol::aggWrite);
+    if (cache_config_evacuate_prefetch_size > 0 && fd != -1) {
+      evac_prefetcher = new EvacuationPrefetcher(this);
+      eventProcessor.schedule_every(evac_prefetcher, EVACUATION_PREFETCH_PERIOD, ET_CALL);
+    }
     cache->vol_initialized(fd != -1);
     return EVENT_DONE;
   }
@@ -3103,6 +3109,8 @@ register_cache_stats(RecRawStatBlock *rsb, const char *prefix)
   REG_INT("hdr_marshal_bytes", cache_hdr_marshal_bytes_stat);
   REG_INT("gc_bytes_evacuated", cache_gc_bytes_evacuated_stat);
   REG_INT("gc_frags_evacuated", cache_gc_frags_evacuated_stat);
+  REG_INT("evacuate.prefetch", cache_evacuate_prefetch_stat);
+  REG_INT("evacuate.prefetch_hits", cache_evacuate_prefetch_hit_stat);
   REG_INT("wrap_count", cache_directory_wrap_stat);
   REG_INT("sync.count", cache_directory_sync_count_stat);
   REG_INT("sync.bytes", cache_directory_sync_bytes_stat);
@@ -3180,6 +3188,11 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_hit_evacuate_size_limit, "proxy.config.cache.hit_evacuate_size_limit");
   Debug("cache_init", "proxy.config.cache.hit_evacuate_size_limit = %d", cache_config_hit_evacuate_size_limit);
 
+  REC_ReadConfigInt32(cache_config_evacuate_prefetch_size, "proxy.config.cache.evacuate.prefetch_size");
+  Debug("cache_init", "proxy.config.cache.evacuate.prefetch_size = %d", cache_config_evacuate_prefetch_size);
+  REC_EstablishStaticConfigInt32(cache_config_evacuate_prefetch_rate, "proxy.config.cache.evacuate.prefetch_rate");
+  Debug("cache_init", "proxy.config.cache.evacuate.prefetch_rate = %d", cache_config_evacuate_prefetch_rate);
+
   REC_EstablishStaticConfigInt32(cache_config_force_sector_size, "proxy.config.cache.force_sector_size");
 
   ink_assert(REC_RegisterConfigUpdateFunc("proxy.config.cache.target_fragment_size", FragmentSizeUpdateCb, nullptr) !=
@@ -115,8 +115,7 @@ OpenDir::signal_readers(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   while ((c = delayed_readers.dequeue())) {
     CACHE_TRY_LOCK(lock, c->mutex, t);
     if (lock.is_locked()) {
-      c->f.open_read_timeout = 0;
-      c->handleEvent(EVENT_IMMEDIATE, nullptr);
+      c->wake_from_writer();
       continue;
     }
     newly_delayed_readers.push(c);
@@ -142,8 +141,7 @@ OpenDir::close_write(CacheVC *cont)
     unsigned int h = cont->first_key.slice32(0);
     int b          = h % OPEN_DIR_BUCKETS;
     bucket[b].remove(cont->od);
-    delayed_readers.append(cont->od->readers);
-    signal_readers(0, nullptr);
+    wake_readers(cont->od, cont->closed < 0 && !cont->f.update);
     cont->od->vector.clear();
     THREAD_FREE(cont->od, openDirEntryAllocator, cont->mutex->thread_holding);
   }
@@ -151,6 +149,21 @@ OpenDir::close_write(CacheVC *cont)
   return 0;
 }
 
+/*
+   Wake the readers waiting on the writers of d. If aborted is set, the
+   document they waited for is not going to be written.
+   */
+void
+OpenDir::wake_readers(OpenDirEntry *d, bool aborted)
+{
+  CacheVC *c = nullptr;
+  while ((c = d->readers.pop())) {
+    c->writer_wait = aborted ? CacheVC::WRITER_WAIT_ABORTED : CacheVC::WRITER_WAIT_WOKEN;
+    delayed_readers.enqueue(c);
+  }
+  signal_readers(0, nullptr);
+}
+
 OpenDirEntry *
 OpenDir::open_read(const CryptoHash *key) const
 {
@@ -168,9 +181,10 @@ int
 OpenDirEntry::wait(CacheVC *cont, int msec)
 {
   ink_assert(cont->vol->mutex->thread_holding == this_ethread());
-  cont->f.open_read_timeout = 1;
+  ink_assert(cont->writer_wait == CacheVC::WRITER_WAIT_NONE);
+  cont->writer_wait = CacheVC::WRITER_WAIT_PARKED;
   ink_assert(!cont->trigger);
-  cont->trigger = cont->vol->mutex->thread_holding->schedule_in_local(cont, HRTIME_MSECONDS(msec));
+  cont->trigger = cont->mutex->thread_holding->schedule_in_local(cont, HRTIME_MSECONDS(msec));
   readers.push(cont);
   return EVENT_CONT;
 }
@@ -59,6 +59,7 @@ CacheHTTPInfoVector::insert(CacheHTTPInfo *info, int index)
   }
 
   data(index).alternate.copy_shallow(info);
+  data[index].vary_key = CacheVaryKey();
   return index;
 }
 
@@ -215,6 +216,7 @@ CacheHTTPInfoVector::unmarshal(const char *buf, int length, RefCountObj *block_p
     buf        += tmp;
 
     data(xcount).alternate = info;
+    data[xcount].vary_key  = CacheVaryKey();
     xcount++;
   }
 
@@ -243,6 +245,7 @@ CacheHTTPInfoVector::get_handles(const char *buf, int length, RefCountObj *block
     buf += tmp;
 
     data(xcount).alternate = info;
+    data[xcount].vary_key  = CacheVaryKey();
     xcount++;
   }
 
@@ -191,6 +191,67 @@ CacheVC::openReadFromWriterFailure(int event, Event *e)
   return EVENT_DONE;
 }
 
+bool
+CacheVC::coalesce_on_writer() const
+{
+  return frag_type == CACHE_FRAG_TYPE_HTTP && params && params->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_COALESCE;
+}
+
+int
+CacheVC::writer_wait_timeout_ms() const
+{
+  // The writer's origin connection times out first, and then wakes us up.
+  return static_cast<int>(params->transaction_no_activity_timeout_out) * 1000;
+}
+
+/*
+   Take a reader that waited on a writer off the list it is queued on.
+   Returns true if the writer never signaled, i.e. the wait timed out.
+   */
+bool
+CacheVC::stop_waiting_for_writer()
+{
+  ink_assert(vol->mutex->thread_holding == this_ethread());
+  bool timed_out = false;
+
+  switch (writer_wait) {
+  case WRITER_WAIT_PARKED: {
+    OpenDirEntry *cod = vol->open_read(&first_key);
+    ink_assert(cod);
+    cod->readers.remove(this);
+    timed_out = true;
+    break;
+  }
+  case WRITER_WAIT_WOKEN:
+  case WRITER_WAIT_ABORTED:
+    vol->open_dir.delayed_readers.remove(this);
+    f.writer_aborted = writer_wait == WRITER_WAIT_ABORTED;
+    break;
+  default:
+    break;
+  }
+  writer_wait = WRITER_WAIT_NONE;
+  return timed_out;
+}
+
+/*
+   Called from OpenDir::signal_readers(), with both the volume lock and the
+   lock of this reader held. Run the reader again on its own thread now
+   instead of when its wait times out.
+   */
+void
+CacheVC::wake_from_writer()
+{
+  // A reader that is not running always has its timeout or a lock retry scheduled.
+  ink_assert(trigger);
+  EThread *t = trigger->ethread;
+
+  f.writer_aborted = writer_wait == WRITER_WAIT_ABORTED;
+  writer_wait      = WRITER_WAIT_NONE;
+  cancel_trigger();
+  trigger = t->schedule_imm(this, EVENT_INTERVAL);
+}
+
 int
 CacheVC::openReadChooseWriter(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
 {
@@ -234,6 +295,11 @@ CacheVC::openReadChooseWriter(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSE
       }
 
       if (!w->closed && !w->alternate.valid()) {
+        // An update still waiting on the origin leaves the stored alternate in place; with
+        // stale-while-revalidate the reader serves that instead of waiting for the writer.
+        if (w->f.update && params && params->cache_stale_while_revalidate) {
+          continue;
+        }
         od = nullptr;
         ink_assert(!write_vc);
         vector.clear(false);
@@ -313,14 +379,31 @@ CacheVC::openReadFromWriter(int event, Event *e)
   cancel_trigger();
   intptr_t err = ECACHE_DOC_BUSY;
   DDebug("cache_read_agg", "%p: key: %X In openReadFromWriter", this, first_key.slice32(1));
+  CACHE_TRY_LOCK(lock, vol->mutex, mutex->thread_holding);
   if (_action.cancelled) {
+    if (writer_wait != WRITER_WAIT_NONE) {
+      if (!lock.is_locked()) {
+        VC_SCHED_LOCK_RETRY();
+      }
+      stop_waiting_for_writer();
+    }
     od = nullptr; // only open for read so no need to close
     return free_CacheVC(this);
   }
-  CACHE_TRY_LOCK(lock, vol->mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
     VC_SCHED_LOCK_RETRY();
   }
+  if (writer_wait != WRITER_WAIT_NONE && stop_waiting_for_writer()) {
+    DDebug("cache_read_agg", "%p: key: %X timed out waiting for the writer", this, first_key.slice32(1));
+    writer_lock_retry = cache_config_read_while_writer_max_retries;
+  }
+  if (f.writer_aborted) {
+    // The writer gave up on the document, so the readers coalesced on it go
+    // to the origin themselves rather than queueing up for the write lock.
+    MUTEX_RELEASE(lock);
+    DDebug("cache_read_agg", "%p: key: %X writer aborted", this, first_key.slice32(1));
+    return openReadFromWriterFailure(CACHE_EVENT_OPEN_READ_FAILED, (Event *)-err);
+  }
   od = vol->open_read(&first_key); // recheck in case the lock failed
   if (!od) {
     MUTEX_RELEASE(lock);
@@ -343,7 +426,7 @@ CacheVC::openReadFromWriter(int event, Event *e)
     } else if (ret == EVENT_CONT) {
       ink_assert(!write_vc);
       if (writer_lock_retry < cache_config_read_while_writer_max_retries) {
-        VC_SCHED_WRITER_RETRY();
+        VC_WAIT_FOR_WRITER(vol->open_read(&first_key));
       } else {
         return openReadFromWriterFailure(CACHE_EVENT_OPEN_READ_FAILED, (Event *)-err);
       }
@@ -380,7 +463,7 @@ CacheVC::openReadFromWriter(int event, Event *e)
     }
     DDebug("cache_read_agg", "%p: key: %X writer: closed:%d, fragment:%d, retry: %d", this, first_key.slice32(1), write_vc->closed,
            write_vc->fragment, writer_lock_retry);
-    VC_SCHED_WRITER_RETRY();
+    VC_WAIT_FOR_WRITER(cod);
   }
 
   CACHE_TRY_LOCK(writer_lock, write_vc->mutex, mutex->thread_holding);
@@ -535,6 +618,9 @@ CacheVC::openReadClose(int event, Event * /* e ATS_UNUSED */)
   if (!lock.is_locked()) {
     VC_SCHED_LOCK_RETRY();
   }
+  if (writer_wait != WRITER_WAIT_NONE) {
+    stop_waiting_for_writer();
+  }
   if (f.hit_evacuate && dir_valid(vol, &first_dir) && closed > 0) {
     if (f.single_fragment) {
       vol->force_evacuate_head(&first_dir, dir_pinned(&first_dir));
@@ -562,6 +648,9 @@ CacheVC::openReadReadDone(int event, Event *e)
     if (!lock.is_locked()) {
       VC_SCHED_LOCK_RETRY();
     }
+    if (writer_wait != WRITER_WAIT_NONE && stop_waiting_for_writer()) {
+      writer_lock_retry = cache_config_read_while_writer_max_retries;
+    }
     if (event == AIO_EVENT_DONE && !io.ok()) {
       goto Lerror;
     }
@@ -606,7 +695,7 @@ CacheVC::openReadReadDone(int event, Event *e)
       }
       if (writer_lock_retry < cache_config_read_while_writer_max_retries) {
         DDebug("cache_read_agg", "%p: key: %X ReadRead retrying: %d", this, first_key.slice32(1), (int)vio.ndone);
-        VC_SCHED_WRITER_RETRY(); // wait for writer
+        VC_WAIT_FOR_WRITER(vol->open_read(&first_key)); // wait for writer
       } else {
         DDebug("cache_read_agg", "%p: key: %X ReadRead retries exhausted, bailing..: %d", this, first_key.slice32(1),
                (int)vio.ndone);
@@ -643,6 +732,15 @@ int
 CacheVC::openReadMain(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
 {
   cancel_trigger();
+  // A reader that timed out here just waits again; a writer that stalls is
+  // timed out by its own origin connection and wakes us when it closes.
+  if (writer_wait != WRITER_WAIT_NONE) {
+    CACHE_TRY_LOCK(lock, vol->mutex, mutex->thread_holding);
+    if (!lock.is_locked()) {
+      VC_SCHED_LOCK_RETRY();
+    }
+    stop_waiting_for_writer();
+  }
   Doc *doc         = reinterpret_cast<Doc *>(buf->data());
   int64_t ntodo    = vio.ntodo();
   int64_t bytes    = doc->len - doc_pos;
@@ -830,7 +928,7 @@ Lread : {
     }
     DDebug("cache_read_agg", "%p: key: %X ReadMain retrying: %d", this, first_key.slice32(1), (int)vio.ndone);
     SET_HANDLER(&CacheVC::openReadMain);
-    VC_SCHED_WRITER_RETRY();
+    VC_WAIT_FOR_WRITER(vol->open_read(&first_key));
   }
   if (is_action_tag_set("cache")) {
     ink_release_assert(false);
@@ -627,8 +627,8 @@ evacuate_fragments(CacheKey *key, CacheKey *earliest_key, int force, Vol *vol)
   return i;
 }
 
-int
-Vol::evacuateWrite(CacheVC *evacuator, int event, Event *e)
+void
+Vol::queue_evacuator(CacheVC *evacuator)
 {
   // push to front of aggregation write list, so it is written first
 
@@ -642,6 +642,12 @@ Vol::evacuateWrite(CacheVC *evacuator, int event, Event *e)
   }
   ink_assert(evacuator->agg_len <= AGG_SIZE);
   agg.insert(evacuator, after);
+}
+
+int
+Vol::evacuateWrite(CacheVC *evacuator, int event, Event *e)
+{
+  queue_evacuator(evacuator);
   return aggWrite(event, e);
 }
 
@@ -655,33 +661,45 @@ Vol::evacuateDocReadDone(int event, Event *e)
   ink_assert(is_io_in_progress());
   set_io_not_in_progress();
   ink_assert(mutex->thread_holding == this_ethread());
-  Doc *doc = reinterpret_cast<Doc *>(doc_evacuator->buf->data());
+  CacheVC *evacuator = doc_evacuator;
+  doc_evacuator      = nullptr;
+  if (evacuate_doc(evacuator)) {
+    return evacuateWrite(evacuator, event, e);
+  }
+  free_CacheVC(evacuator);
+  return aggWrite(event, e);
+}
+
+// Set up @a evacuator, whose buffer holds the document read from its overwrite_dir, to write the
+// document again. @return @c false if the document no longer needs to be evacuated.
+bool
+Vol::evacuate_doc(CacheVC *evacuator)
+{
+  Doc *doc = reinterpret_cast<Doc *>(evacuator->buf->data());
   CacheKey next_key;
   EvacuationBlock *b = nullptr;
-  auto bucket        = dir_evac_bucket(&doc_evacuator->overwrite_dir);
+  auto bucket        = dir_evac_bucket(&evacuator->overwrite_dir);
   if (doc->magic != DOC_MAGIC) {
-    Debug("cache_evac", "DOC magic: %X %d", (int)dir_tag(&doc_evacuator->overwrite_dir),
-          (int)dir_offset(&doc_evacuator->overwrite_dir));
+    Debug("cache_evac", "DOC magic: %X %d", (int)dir_tag(&evacuator->overwrite_dir), (int)dir_offset(&evacuator->overwrite_dir));
     ink_assert(doc->magic == DOC_MAGIC);
-    goto Ldone;
+    return false;
   }
-  DDebug("cache_evac", "evacuateDocReadDone %X offset %d", (int)doc->key.slice32(0),
-         (int)dir_offset(&doc_evacuator->overwrite_dir));
+  DDebug("cache_evac", "evacuateDocReadDone %X offset %d", (int)doc->key.slice32(0), (int)dir_offset(&evacuator->overwrite_dir));
 
   if (evac_bucket_valid(bucket)) {
     b = evacuate[bucket].head;
   }
   while (b) {
-    if (dir_offset(&b->dir) == dir_offset(&doc_evacuator->overwrite_dir)) {
+    if (dir_offset(&b->dir) == dir_offset(&evacuator->overwrite_dir)) {
       break;
     }
     b = b->link.next;
   }
   if (!b) {
-    goto Ldone;
+    return false;
   }
   if ((b->f.pinned && !b->readers) && doc->pinned < static_cast<uint32_t>(Thread::get_hrtime() / HRTIME_SECOND)) {
-    goto Ldone;
+    return false;
   }
 
   if (dir_head(&b->dir) && b->f.evacuate_head) {
@@ -689,23 +707,23 @@ Vol::evacuateDocReadDone(int event, Event *e)
     // if its a head (vector), evacuation is real simple...we just
     // need to write this vector down and overwrite the directory entry.
     if (dir_compare_tag(&b->dir, &doc->first_key)) {
-      doc_evacuator->key = doc->first_key;
-      b->evac_frags.key  = doc->first_key;
+      evacuator->key    = doc->first_key;
+      b->evac_frags.key = doc->first_key;
       DDebug("cache_evac", "evacuating vector %X offset %d", (int)doc->first_key.slice32(0),
-             (int)dir_offset(&doc_evacuator->overwrite_dir));
+             (int)dir_offset(&evacuator->overwrite_dir));
       b->f.unused = 57;
     } else {
       // if its an earliest fragment (alternate) evacuation, things get
       // a little tricky. We have to propagate the earliest key to the next
       // fragments for this alternate. The last fragment to be evacuated
       // fixes up the lookaside buffer.
-      doc_evacuator->key          = doc->key;
-      doc_evacuator->earliest_key = doc->key;
-      b->evac_frags.key           = doc->key;
-      b->evac_frags.earliest_key  = doc->key;
-      b->earliest_evacuator       = doc_evacuator;
+      evacuator->key             = doc->key;
+      evacuator->earliest_key    = doc->key;
+      b->evac_frags.key          = doc->key;
+      b->evac_frags.earliest_key = doc->key;
+      b->earliest_evacuator      = evacuator;
       DDebug("cache_evac", "evacuating earliest %X %X evac: %p offset: %d", (int)b->evac_frags.key.slice32(0),
-             (int)doc->key.slice32(0), doc_evacuator, (int)dir_offset(&doc_evacuator->overwrite_dir));
+             (int)doc->key.slice32(0), evacuator, (int)dir_offset(&evacuator->overwrite_dir));
       b->f.unused = 67;
     }
   } else {
@@ -716,10 +734,10 @@ Vol::evacuateDocReadDone(int event, Event *e)
     }
     if (!ek) {
       b->f.unused = 77;
-      goto Ldone;
+      return false;
     }
-    doc_evacuator->key          = ek->key;
-    doc_evacuator->earliest_key = ek->earliest_key;
+    evacuator->key          = ek->key;
+    evacuator->earliest_key = ek->earliest_key;
     DDebug("cache_evac", "evacuateDocReadDone key: %X earliest: %X", (int)ek->key.slice32(0), (int)ek->earliest_key.slice32(0));
     b->f.unused = 87;
   }
@@ -729,22 +747,19 @@ Vol::evacuateDocReadDone(int event, Event *e)
   // Cache::open_write).
   if (!dir_head(&b->dir) || !dir_compare_tag(&b->dir, &doc->first_key)) {
     next_CacheKey(&next_key, &doc->key);
-    evacuate_fragments(&next_key, &doc_evacuator->earliest_key, !b->readers, this);
+    evacuate_fragments(&next_key, &evacuator->earliest_key, !b->readers, this);
   }
-  return evacuateWrite(doc_evacuator, event, e);
-Ldone:
-  free_CacheVC(doc_evacuator);
-  doc_evacuator = nullptr;
-  return aggWrite(event, e);
+  return true;
 }
 
 int
 Vol::evac_range(off_t low, off_t high, int evac_phase)
 {
-  off_t s = this->offset_to_vol_offset(low);
-  off_t e = this->offset_to_vol_offset(high);
-  int si  = dir_offset_evac_bucket(s);
-  int ei  = dir_offset_evac_bucket(e);
+  off_t s    = this->offset_to_vol_offset(low);
+  off_t e    = this->offset_to_vol_offset(high);
+  int si     = dir_offset_evac_bucket(s);
+  int ei     = dir_offset_evac_bucket(e);
+  int queued = 0;
 
   for (int i = si; i <= ei; i++) {
     EvacuationBlock *b     = evacuate[i].head;
@@ -761,7 +776,20 @@ Vol::evac_range(off_t low, off_t high, int evac_phase)
       }
     }
     if (first) {
-      first->f.done       = 1;
+      first->f.done = 1;
+      if (CacheVC *evacuator = evac_prefetcher ? evac_prefetcher->take(&first->dir) : nullptr) {
+        // Read ahead already, queue it without waiting for the disk and look for more in this bucket.
+        Vol *vol = this;
+        CACHE_INCREMENT_DYN_STAT(cache_evacuate_prefetch_hit_stat);
+        if (evacuate_doc(evacuator)) {
+          queue_evacuator(evacuator);
+          ++queued;
+        } else {
+          free_CacheVC(evacuator);
+        }
+        --i;
+        continue;
+      }
       io.aiocb.aio_fildes = fd;
       io.aiocb.aio_nbytes = dir_approx_size(&first->dir);
       io.aiocb.aio_offset = this->vol_offset(&first->dir);
@@ -780,7 +808,155 @@ Vol::evac_range(off_t low, off_t high, int evac_phase)
       return -1;
     }
   }
-  return 0;
+  return queued;
+}
+
+EvacuationPrefetcher::EvacuationPrefetcher(Vol *v) : Continuation(v->mutex), vol(v)
+{
+  SET_HANDLER(&EvacuationPrefetcher::mainEvent);
+  last_refill = Thread::get_hrtime();
+}
+
+CacheVC *
+EvacuationPrefetcher::take(Dir *dir)
+{
+  auto spot = docs.find(vol->vol_offset(dir));
+  if (spot == docs.end()) {
+    return nullptr;
+  }
+
+  Entry entry = spot->second;
+  docs.erase(spot);
+  buffered -= entry.len;
+
+  // The same document as when it was read, unless the directory changed under it since.
+  Doc *doc = reinterpret_cast<Doc *>(entry.evacuator->buf->data());
+  if (dir_phase(&entry.evacuator->overwrite_dir) != dir_phase(dir) || dir_approx_size(dir) > entry.len ||
+      !(dir_compare_tag(dir, &doc->first_key) || dir_compare_tag(dir, &doc->key))) {
+    free_CacheVC(entry.evacuator);
+    return nullptr;
+  }
+  entry.evacuator->overwrite_dir = *dir;
+  return entry.evacuator;
+}
+
+int
+EvacuationPrefetcher::mainEvent(int event, Event * /* e ATS_UNUSED */)
+{
+  if (event == AIO_EVENT_DONE) {
+    read_done();
+  }
+  return scan();
+}
+
+void
+EvacuationPrefetcher::read_done()
+{
+  CacheVC *evacuator = reading;
+  Doc *doc           = reinterpret_cast<Doc *>(evacuator->buf->data());
+  reading            = nullptr;
+
+  // Keep it only if it still has to be evacuated, and the write cursor did not get there first.
+  EvacuationBlock *b = evacuation_block_exists(&evacuator->overwrite_dir, vol);
+  if (!io.ok() || doc->magic != DOC_MAGIC || !b || b->f.done || dir_phase(&b->dir) != dir_phase(&evacuator->overwrite_dir)) {
+    free_CacheVC(evacuator);
+    return;
+  }
+  docs[vol->vol_offset(&evacuator->overwrite_dir)] = Entry{evacuator, static_cast<int64_t>(io.aiocb.aio_nbytes)};
+  buffered                                         += io.aiocb.aio_nbytes;
+}
+
+// Drop the documents the write cursor went past without needing them.
+void
+EvacuationPrefetcher::prune()
+{
+  for (auto spot = docs.begin(); spot != docs.end();) {
+    // Documents of the other phase are ahead of the cursor, those of this phase are ahead once it wraps.
+    bool ahead = dir_phase(&spot->second.evacuator->overwrite_dir) != vol->header->phase ? spot->first >= vol->header->write_pos :
+                                                                                           spot->first < vol->header->write_pos;
+    if (ahead) {
+      ++spot;
+      continue;
+    }
+    buffered -= spot->second.len;
+    free_CacheVC(spot->second.evacuator);
+    spot = docs.erase(spot);
+  }
+}
+
+int
+EvacuationPrefetcher::scan()
+{
+  if (reading || vol->header == nullptr) {
+    return EVENT_CONT;
+  }
+
+  prune();
+
+  ink_hrtime now = Thread::get_hrtime();
+  if (cache_config_evacuate_prefetch_rate > 0) {
+    budget = std::min<int64_t>(budget + cache_config_evacuate_prefetch_rate * (now - last_refill) / HRTIME_SECOND, AGG_SIZE);
+    if (budget <= 0) {
+      last_refill = now;
+      return EVENT_CONT;
+    }
+  }
+  last_refill = now;
+  if (buffered >= cache_config_evacuate_prefetch_size) {
+    return EVENT_CONT;
+  }
+
+  // The aggregation buffer being written can reach AGG_SIZE past the cursor, start beyond it.
+  off_t low     = vol->header->write_pos + AGG_SIZE;
+  off_t high    = low + cache_config_evacuate_prefetch_size;
+  off_t vol_end = vol->skip + vol->len;
+  if (low < vol_end && read_next(low, std::min(high, vol_end), !vol->header->phase)) {
+    return EVENT_CONT;
+  }
+  if (high > vol_end) {
+    read_next(vol->start + std::max<off_t>(low - vol_end, 0), vol->start + (high - vol_end), vol->header->phase);
+  }
+  return EVENT_CONT;
+}
+
+// Start reading the first document to evacuate in [@a low, @a high) not read yet.
+bool
+EvacuationPrefetcher::read_next(off_t low, off_t high, int phase)
+{
+  off_t s = vol->offset_to_vol_offset(low);
+  off_t e = vol->offset_to_vol_offset(high);
+
+  for (int i = dir_offset_evac_bucket(s), ei = dir_offset_evac_bucket(e); i <= ei && vol->evac_bucket_valid(i); i++) {
+    EvacuationBlock *first = nullptr;
+    for (EvacuationBlock *b = vol->evacuate[i].head; b; b = b->link.next) {
+      int64_t offset = dir_offset(&b->dir);
+      if (offset >= s && offset < e && !b->f.done && dir_phase(&b->dir) == phase &&
+          (!first || offset < static_cast<int64_t>(dir_offset(&first->dir))) && docs.count(vol->vol_offset(&b->dir)) == 0) {
+        first = b;
+      }
+    }
+    if (!first) {
+      continue;
+    }
+
+    io.aiocb.aio_fildes = vol->fd;
+    io.aiocb.aio_nbytes = dir_approx_size(&first->dir);
+    io.aiocb.aio_offset = vol->vol_offset(&first->dir);
+    if (static_cast<off_t>(io.aiocb.aio_offset + io.aiocb.aio_nbytes) > static_cast<off_t>(vol->skip + vol->len)) {
+      io.aiocb.aio_nbytes = vol->skip + vol->len - io.aiocb.aio_offset;
+    }
+    reading                = new_DocEvacuator(io.aiocb.aio_nbytes, vol);
+    reading->overwrite_dir = first->dir;
+    io.aiocb.aio_buf       = reading->buf->data();
+    io.action              = this;
+    io.thread              = AIO_CALLBACK_THREAD_ANY;
+    budget                 -= io.aiocb.aio_nbytes;
+    DDebug("cache_evac", "prefetch evacuating %X %d", (int)dir_tag(&first->dir), (int)dir_offset(&first->dir));
+    CACHE_INCREMENT_DYN_STAT(cache_evacuate_prefetch_stat);
+    ink_assert(ink_aio_read(&io) >= 0);
+    return true;
+  }
+  return false;
 }
 
 static int
@@ -1084,14 +1260,21 @@ Lagain:
   }
 
   // evacuate space
-  off_t end = header->write_pos + agg_buf_pos + EVACUATION_SIZE;
-  if (evac_range(header->write_pos, end, !header->phase) < 0) {
+  off_t end     = header->write_pos + agg_buf_pos + EVACUATION_SIZE;
+  int evacuated = evac_range(header->write_pos, end, !header->phase);
+  if (evacuated < 0) {
     goto Lwait;
   }
   if (end > skip + len) {
-    if (evac_range(start, start + (end - (skip + len)), header->phase) < 0) {
+    int wrapped = evac_range(start, start + (end - (skip + len)), header->phase);
+    if (wrapped < 0) {
       goto Lwait;
     }
+    evacuated += wrapped;
+  }
+  // documents read ahead were queued for writing first, aggregate them too
+  if (evacuated > 0) {
+    goto Lagain;
   }
 
   // if agg.head, then we are near the end of the disk, so
@@ -1403,6 +1586,9 @@ CacheVC::openWriteWriteDone(int event, Event *e)
     write_pos += write_len;
     dir_insert(&key, vol, &dir);
     DDebug("cache_insert", "WriteDone: %X, %X, %d", key.slice32(0), first_key.slice32(0), write_len);
+    if (od && od->readers.head) {
+      vol->open_dir.wake_readers(od, false);
+    }
     blocks = iobufferblock_skip(blocks.get(), &offset, &length, write_len);
     next_CacheKey(&key, &key);
   }
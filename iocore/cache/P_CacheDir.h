@@ -218,7 +218,7 @@ struct FreeDir {
 LINK_FORWARD_DECLARATION(CacheVC, opendir_link) // forward declaration
 struct OpenDirEntry {
   DLL<CacheVC, Link_CacheVC_opendir_link> writers; // list of all the current writers
-  DLL<CacheVC, Link_CacheVC_opendir_link> readers; // list of all the current readers - not used
+  DLL<CacheVC, Link_CacheVC_opendir_link> readers; // readers waiting for a writer to make progress
   CacheHTTPInfoVector vector;                      // Vector for the http document. Each writer
                                                    // maintains a pointer to this vector and
                                                    // writes it down to disk.
@@ -252,6 +252,7 @@ struct OpenDir : public Continuation {
   int close_write(CacheVC *c);
   OpenDirEntry *open_read(const CryptoHash *key) const;
   int signal_readers(int event, Event *e);
+  void wake_readers(OpenDirEntry *d, bool aborted);
 
   OpenDir();
 };
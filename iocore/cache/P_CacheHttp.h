@@ -38,8 +38,17 @@ enum {
   OWNER_HTTP  = 2,
 };
 
+/// Key of the request headers an alternate varies on, see HttpTransactCache::SelectFromAlternates().
+struct CacheVaryKey {
+  int config      = -1;    ///< Selection config the key was computed under, -1 if it has not been.
+  bool wildcard   = false; ///< The alternate has Vary: *, and never matches.
+  uint64_t names  = 0;     ///< Hash of the header names listed in Vary, 0 if the response has no Vary.
+  uint64_t values = 0;     ///< Hash of the values of those headers in the stored request.
+};
+
 struct vec_info {
   CacheHTTPInfo alternate;
+  CacheVaryKey vary_key;
 };
 
 struct CacheHTTPInfoVector {
@@ -55,6 +64,7 @@ struct CacheHTTPInfoVector {
   }
   int insert(CacheHTTPInfo *info, int id = -1);
   CacheHTTPInfo *get(int idx);
+  CacheVaryKey *vary_key_get(int idx);
   void detach(int idx, CacheHTTPInfo *r);
   void remove(int idx, bool destroy);
   void clear(bool destroy = true);
@@ -83,3 +93,11 @@ CacheHTTPInfoVector::get(int idx)
   ink_assert(idx < xcount);
   return &data[idx].alternate;
 }
+
+TS_INLINE CacheVaryKey *
+CacheHTTPInfoVector::vary_key_get(int idx)
+{
+  ink_assert(idx >= 0);
+  ink_assert(idx < xcount);
+  return &data[idx].vary_key;
+}
@@ -96,6 +96,15 @@ struct EvacuationBlock;
     return EVENT_CONT;                                                    \
   } while (0)
 
+// Coalescing readers wait on the OpenDirEntry until the writer signals, rather than polling it.
+#define VC_WAIT_FOR_WRITER(_od)                           \
+  do {                                                    \
+    if (coalesce_on_writer()) {                           \
+      return (_od)->wait(this, writer_wait_timeout_ms()); \
+    }                                                     \
+    VC_SCHED_WRITER_RETRY();                              \
+  } while (0)
+
 // cache stats definitions
 enum {
   cache_bytes_used_stat,
@@ -141,6 +150,8 @@ enum {
   cache_read_busy_failure_stat,
   cache_gc_bytes_evacuated_stat,
   cache_gc_frags_evacuated_stat,
+  cache_evacuate_prefetch_stat,
+  cache_evacuate_prefetch_hit_stat,
   cache_write_bytes_stat,
   cache_hdr_vector_marshal_stat,
   cache_hdr_marshal_stat,
@@ -226,6 +237,8 @@ extern int cache_config_ram_cache_compress_percent;
 extern int cache_config_ram_cache_use_seen_filter;
 extern int cache_config_hit_evacuate_percent;
 extern int cache_config_hit_evacuate_size_limit;
+extern int cache_config_evacuate_prefetch_size;
+extern int cache_config_evacuate_prefetch_rate;
 extern int cache_config_force_sector_size;
 extern int cache_config_target_fragment_size;
 extern int cache_config_mutex_retry_delay;
@@ -316,6 +329,10 @@ struct CacheVC : public CacheVConnection {
   }
 
   bool writer_done();
+  bool coalesce_on_writer() const;
+  int writer_wait_timeout_ms() const;
+  bool stop_waiting_for_writer();
+  void wake_from_writer();
   int calluser(int event);
   int callcont(int event);
   int die();
@@ -487,6 +504,9 @@ struct CacheVC : public CacheVConnection {
   int header_to_write_len;
   void *header_to_write;
   short writer_lock_retry;
+  // Where a reader waiting on a writer is queued, guarded by vol->mutex.
+  enum { WRITER_WAIT_NONE = 0, WRITER_WAIT_PARKED, WRITER_WAIT_WOKEN, WRITER_WAIT_ABORTED };
+  uint8_t writer_wait;
   union {
     uint32_t flags;
     struct {
@@ -501,7 +521,7 @@ struct CacheVC : public CacheVConnection {
       unsigned int update                  : 1;
       unsigned int remove                  : 1;
       unsigned int remove_aborted_writers  : 1;
-      unsigned int open_read_timeout       : 1; // UNUSED
+      unsigned int writer_aborted          : 1; // the writer this reader waited on gave up
       unsigned int data_done               : 1;
       unsigned int read_from_writer_called : 1;
       unsigned int not_from_ram_cache      : 1; // entire object was from ram cache
@@ -590,6 +610,7 @@ free_CacheVC(CacheVC *cont)
   }
   ink_assert(!cont->is_io_in_progress());
   ink_assert(!cont->od);
+  ink_assert(cont->writer_wait == CacheVC::WRITER_WAIT_NONE);
   cont->io.action = nullptr;
   cont->io.mutex.clear();
   cont->io.aio_result       = 0;
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 
 #define CACHE_BLOCK_SHIFT        9
 #define CACHE_BLOCK_SIZE         (1 << CACHE_BLOCK_SHIFT) // 512, smallest sector size
@@ -54,6 +55,7 @@
 #define AIO_AGG_WRITE_IN_PROGRESS    -2
 #define AUTO_SIZE_RAM_CACHE          -1                      // 1-1 with directory size
 #define DEFAULT_TARGET_FRAGMENT_SIZE (1048576 - sizeof(Doc)) // 1MB
+#define EVACUATION_PREFETCH_PERIOD   HRTIME_MSECONDS(10)
 
 #define dir_offset_evac_bucket(_o) (_o / (EVACUATION_BUCKET_SIZE / CACHE_BLOCK_SIZE))
 #define dir_evac_bucket(_e)        dir_offset_evac_bucket(dir_offset(_e))
@@ -68,6 +70,7 @@
 
 struct Cache;
 struct Vol;
+struct EvacuationPrefetcher;
 struct CacheDisk;
 struct VolInitInfo;
 struct DiskVol;
@@ -154,7 +157,8 @@ struct Vol : public Continuation {
   int evacuate_size              = 0;
   DLL<EvacuationBlock> *evacuate = nullptr;
   DLL<EvacuationBlock> lookaside[LOOKASIDE_SIZE];
-  CacheVC *doc_evacuator = nullptr;
+  CacheVC *doc_evacuator                = nullptr;
+  EvacuationPrefetcher *evac_prefetcher = nullptr;
 
   VolInitInfo *init_info = nullptr;
 
@@ -216,6 +220,8 @@ struct Vol : public Continuation {
   int evacuateWrite(CacheVC *evacuator, int event, Event *e);
   int evacuateDocReadDone(int event, Event *e);
   int evacuateDoc(int event, Event *e);
+  bool evacuate_doc(CacheVC *evacuator);
+  void queue_evacuator(CacheVC *evacuator);
 
   int evac_range(off_t start, off_t end, int evac_phase);
   void periodic_scan();
@@ -254,6 +260,36 @@ struct Vol : public Continuation {
   ~Vol() override { ats_free(agg_buffer); }
 };
 
+/// Reads the documents to evacuate ahead of the write cursor of a stripe in the background, so that
+/// the aggregation writes do not wait on those reads when the write cursor gets to them.
+struct EvacuationPrefetcher : public Continuation {
+  explicit EvacuationPrefetcher(Vol *v);
+
+  /// The document at @a dir, if it was read ahead. The caller owns the evacuator returned.
+  CacheVC *take(Dir *dir);
+
+  int mainEvent(int event, Event *e);
+
+private:
+  struct Entry {
+    CacheVC *evacuator;
+    int64_t len;
+  };
+
+  int scan();
+  bool read_next(off_t low, off_t high, int phase);
+  void read_done();
+  void prune();
+
+  Vol *vol;
+  AIOCallbackInternal io;
+  CacheVC *reading = nullptr;     ///< The evacuator being read into.
+  std::map<off_t, Entry> docs;    ///< Documents read, by their offset in the stripe.
+  int64_t buffered       = 0;     ///< Bytes in @a docs.
+  int64_t budget         = 0;     ///< Bytes that can be read before the rate limit applies.
+  ink_hrtime last_refill = 0;
+};
+
 struct AIO_Callback_handler : public Continuation {
   int handle_disk_failure(int event, void *data);
 
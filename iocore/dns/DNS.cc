@@ -56,6 +56,10 @@ char *dns_local_ipv4                 = nullptr;
 int dns_thread                       = 0;
 int dns_prefer_ipv6                  = 0;
 DNS_CONN_MODE dns_conn_mode          = DNS_CONN_MODE::UDP_ONLY;
+int dns_tls_verify_server            = 1;
+char *dns_tls_server_name            = nullptr;
+char *dns_tls_ca_file                = nullptr;
+SSL_CTX *dns_tls_ctx                 = nullptr;
 
 namespace
 {
@@ -72,6 +76,12 @@ is_addr_query(int qtype)
 {
   return qtype == T_A || qtype == T_AAAA;
 }
+// Queries only go over stream (TCP or TLS) connections, there are no UDP connections.
+inline bool
+stream_only()
+{
+  return dns_conn_mode == DNS_CONN_MODE::TCP_ONLY || dns_conn_mode == DNS_CONN_MODE::TLS_ONLY;
+}
 } // namespace
 
 DNSProcessor dnsProcessor;
@@ -200,6 +210,35 @@ make_ipv6_ptr(in6_addr const *addr, char *buffer)
   return ink_strlcpy(p, "ip6.arpa", MAXDNAME - (p - buffer + 1));
 }
 
+static SSL_CTX *
+dns_tls_ctx_create()
+{
+  SSL_CTX *ctx = SSL_CTX_new(TLS_client_method());
+  if (ctx == nullptr) {
+    Error("DNS over TLS: unable to create the TLS client context");
+    return nullptr;
+  }
+  SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+  SSL_CTX_set_mode(ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+#ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+  // Resolvers close idle connections without a close_notify, treat that as a normal close.
+  SSL_CTX_set_options(ctx, SSL_OP_IGNORE_UNEXPECTED_EOF);
+#endif
+  if (dns_tls_verify_server) {
+    int ok = (dns_tls_ca_file && *dns_tls_ca_file) ? SSL_CTX_load_verify_locations(ctx, dns_tls_ca_file, nullptr) :
+                                                     SSL_CTX_set_default_verify_paths(ctx);
+    if (!ok) {
+      Error("DNS over TLS: unable to load the CA certificates from '%s'", dns_tls_ca_file ? dns_tls_ca_file : "the default location");
+      SSL_CTX_free(ctx);
+      return nullptr;
+    }
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+  } else {
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+  }
+  return ctx;
+}
+
 //  Public functions
 //
 //  See documentation is header files and Memos
@@ -227,6 +266,12 @@ DNSProcessor::start(int, size_t stacksize)
   int dns_conn_mode_i = 0;
   REC_EstablishStaticConfigInt32(dns_conn_mode_i, "proxy.config.dns.connection_mode");
   dns_conn_mode = static_cast<DNS_CONN_MODE>(dns_conn_mode_i);
+  if (dns_conn_mode == DNS_CONN_MODE::TLS_ONLY) {
+    REC_ReadConfigInteger(dns_tls_verify_server, "proxy.config.dns.tls.verify_server");
+    REC_ReadConfigStringAlloc(dns_tls_server_name, "proxy.config.dns.tls.server_name");
+    REC_ReadConfigStringAlloc(dns_tls_ca_file, "proxy.config.dns.tls.ca_file");
+    dns_tls_ctx = dns_tls_ctx_create();
+  }
 
   if (dns_thread > 0) {
     // TODO: Hmmm, should we just get a single thread some other way?
@@ -452,7 +497,7 @@ DNSEntry::init(DNSQueryData target, int qtype_arg, Continuation *acont, DNSProce
 void
 DNSHandler::open_cons(sockaddr const *target, bool failed, int icon)
 {
-  if (dns_conn_mode != DNS_CONN_MODE::TCP_ONLY) {
+  if (!stream_only()) {
     open_con(target, failed, icon, false);
   }
   if (dns_conn_mode != DNS_CONN_MODE::UDP_ONLY) {
@@ -471,6 +516,23 @@ DNSHandler::reset_tcp_conn(int ndx)
   return open_con(&m_res->nsaddr_list[ndx].sa, true, ndx, true);
 }
 
+/**
+ Reopen a TLS connection the server closed, outstanding queries sent on it are
+ written again once the new connection is up.
+ */
+void
+DNSHandler::reopen_tls_con(int ndx)
+{
+  for (DNSEntry *e = entries.head; e; e = static_cast<DNSEntry *>(e->link.next)) {
+    if (e->written_flag && e->which_ns == ndx) {
+      e->written_flag = false;
+      --in_flight;
+      DNS_DECREMENT_DYN_STAT(dns_in_flight_stat);
+    }
+  }
+  reset_tcp_conn(ndx);
+}
+
 /**
   Open (and close) connections as necessary and also assures that the
   epoll fd struct is properly updated.
@@ -500,6 +562,15 @@ DNSHandler::open_con(sockaddr const *target, bool failed, int icon, bool over_tc
     target = &ip.sa;
   }
   DNSConnection &cur_con = over_tcp ? tcpcon[icon] : udpcon[icon];
+  bool over_tls          = over_tcp && dns_conn_mode == DNS_CONN_MODE::TLS_ONLY;
+  IpEndpoint tls_target;
+
+  if (over_tls && ats_ip_port_host_order(target) == NAMESERVER_PORT) {
+    // The nameserver was listed without a port, use the DNS over TLS port.
+    ats_ip_copy(&tls_target.sa, target);
+    tls_target.network_order_port() = htons(DNS_TLS_PORT);
+    target                          = &tls_target.sa;
+  }
 
   Debug("dns", "open_con: opening connection %s", ats_ip_nptop(target, ip_text, sizeof ip_text));
 
@@ -507,13 +578,16 @@ DNSHandler::open_con(sockaddr const *target, bool failed, int icon, bool over_tc
     cur_con.close();
   }
 
-  if (cur_con.connect(target, DNSConnection::Options()
+  // Without a TLS context the connection is not opened, there is no fall back to plain text.
+  if ((over_tls && !dns_tls_ctx) ||
+      cur_con.connect(target, DNSConnection::Options()
                                 .setNonBlockingConnect(true)
                                 .setNonBlockingIo(true)
                                 .setUseTcp(over_tcp)
                                 .setBindRandomPort(true)
                                 .setLocalIpv6(&local_ipv6.sa)
-                                .setLocalIpv4(&local_ipv4.sa)) < 0) {
+                                .setLocalIpv4(&local_ipv4.sa)
+                                .setTls(over_tls ? dns_tls_ctx : nullptr, dns_tls_server_name)) < 0) {
     Debug("dns", "opening connection %s FAILED for %d", ip_text, icon);
     if (!failed) {
       if (dns_ns_rr) {
@@ -524,7 +598,8 @@ DNSHandler::open_con(sockaddr const *target, bool failed, int icon, bool over_tc
     }
     return false;
   } else {
-    if (cur_con.eio.start(pd, &cur_con, EVENTIO_READ) < 0) {
+    // A TLS connection also waits for the connect to complete, that starts the handshake.
+    if (cur_con.eio.start(pd, &cur_con, over_tls ? EVENTIO_READ | EVENTIO_WRITE : EVENTIO_READ) < 0) {
       Error("[iocore_dns] open_con: Failed to add %d server to epoll list\n", icon);
     } else {
       cur_con.num   = icon;
@@ -664,7 +739,7 @@ DNSHandler::retry_named(int ndx, ink_hrtime t, bool reopen)
   if (reopen && ((t - last_primary_reopen) > DNS_PRIMARY_REOPEN_PERIOD)) {
     Debug("dns", "retry_named: reopening DNS connection for index %d", ndx);
     last_primary_reopen = t;
-    if (dns_conn_mode != DNS_CONN_MODE::TCP_ONLY) {
+    if (!stream_only()) {
       udpcon[ndx].close();
     }
     if (dns_conn_mode != DNS_CONN_MODE::UDP_ONLY) {
@@ -672,15 +747,15 @@ DNSHandler::retry_named(int ndx, ink_hrtime t, bool reopen)
     }
     open_cons(&m_res->nsaddr_list[ndx].sa, true, ndx);
   }
-  bool over_tcp = dns_conn_mode == DNS_CONN_MODE::TCP_ONLY;
-  int con_fd    = over_tcp ? tcpcon[ndx].fd : udpcon[ndx].fd;
+  bool over_tcp      = stream_only();
+  DNSConnection &con = over_tcp ? tcpcon[ndx] : udpcon[ndx];
   unsigned char buffer[MAX_DNS_REQUEST_LEN];
   Debug("dns", "trying to resolve '%s' from DNS connection, ndx %d", try_server_names[try_servers], ndx);
   int r       = _ink_res_mkquery(m_res, try_server_names[try_servers], T_A, buffer, over_tcp);
   try_servers = (try_servers + 1) % countof(try_server_names);
   ink_assert(r >= 0);
   if (r >= 0) { // looking for a bounce
-    int res = SocketManager::send(con_fd, buffer, r, 0);
+    int res = con.send(buffer, r);
     Debug("dns", "ping result = %d", res);
   }
 }
@@ -696,8 +771,8 @@ DNSHandler::try_primary_named(bool reopen)
   }
   if ((t - last_primary_retry) > DNS_PRIMARY_RETRY_PERIOD) {
     unsigned char buffer[MAX_DNS_REQUEST_LEN];
-    bool over_tcp      = dns_conn_mode == DNS_CONN_MODE::TCP_ONLY;
-    int con_fd         = over_tcp ? tcpcon[0].fd : udpcon[0].fd;
+    bool over_tcp      = stream_only();
+    DNSConnection &con = over_tcp ? tcpcon[0] : udpcon[0];
     last_primary_retry = t;
     Debug("dns", "trying to resolve '%s' from primary DNS connection", try_server_names[try_servers]);
     int r = _ink_res_mkquery(m_res, try_server_names[try_servers], T_A, buffer, over_tcp);
@@ -710,7 +785,7 @@ DNSHandler::try_primary_named(bool reopen)
     }
     ink_assert(r >= 0);
     if (r >= 0) { // looking for a bounce
-      int res = SocketManager::send(con_fd, buffer, r, 0);
+      int res = con.send(buffer, r);
       Debug("dns", "ping result = %d", res);
     }
   }
@@ -771,7 +846,7 @@ DNSHandler::failover()
     }
     switch_named(name_server);
   } else {
-    if (dns_conn_mode != DNS_CONN_MODE::TCP_ONLY) {
+    if (!stream_only()) {
       udpcon[0].close();
     }
     if (dns_conn_mode != DNS_CONN_MODE::UDP_ONLY) {
@@ -859,10 +934,16 @@ DNSHandler::recv_dns(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
         if (dnsc->tcp_data.buf_ptr == nullptr) {
           dnsc->tcp_data.buf_ptr = make_ptr(dnsBufAllocator.alloc());
         }
+        if (dnsc->ssl && (res = dnsc->tls_handshake()) <= 0) {
+          if (res == 0) {
+            break;
+          }
+          goto Lerror;
+        }
         if (dnsc->tcp_data.total_length == 0) {
           // see if TS gets a two-byte size
           uint16_t tmp = 0;
-          res          = SocketManager::recv(dnsc->fd, &tmp, sizeof(tmp), MSG_PEEK);
+          res          = dnsc->recv(&tmp, sizeof(tmp), MSG_PEEK);
           if (res == -EAGAIN || res == 1) {
             break;
           }
@@ -870,7 +951,7 @@ DNSHandler::recv_dns(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
             goto Lerror;
           }
           // reading total size
-          res = SocketManager::recv(dnsc->fd, &(dnsc->tcp_data.total_length), sizeof(dnsc->tcp_data.total_length), 0);
+          res = dnsc->recv(&(dnsc->tcp_data.total_length), sizeof(dnsc->tcp_data.total_length));
           if (res == -EAGAIN) {
             break;
           }
@@ -884,7 +965,7 @@ DNSHandler::recv_dns(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
         }
         // continue reading data
         void *buf_start = (char *)dnsc->tcp_data.buf_ptr->buf + dnsc->tcp_data.done_reading;
-        res             = SocketManager::recv(dnsc->fd, buf_start, dnsc->tcp_data.total_length - dnsc->tcp_data.done_reading, 0);
+        res             = dnsc->recv(buf_start, dnsc->tcp_data.total_length - dnsc->tcp_data.done_reading);
         if (res == -EAGAIN) {
           break;
         }
@@ -914,6 +995,11 @@ DNSHandler::recv_dns(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
       if (res <= 0) {
       Lerror:
         Debug("dns", "named error: %d", res);
+        if (res == 0 && dnsc->tls_established) {
+          // Resolvers close idle TLS connections, reconnect and resend the queries that were outstanding on it.
+          reopen_tls_con(dnsc->num);
+          break;
+        }
         if (dns_ns_rr) {
           rr_failure(dnsc->num);
         } else if (dnsc->num == name_server) {
@@ -1093,7 +1179,7 @@ write_dns(DNSHandler *h, bool tcp_retry)
     return;
   }
   h->in_write_dns = true;
-  bool over_tcp   = (dns_conn_mode == DNS_CONN_MODE::TCP_ONLY) || ((dns_conn_mode == DNS_CONN_MODE::TCP_RETRY) && tcp_retry);
+  bool over_tcp   = stream_only() || ((dns_conn_mode == DNS_CONN_MODE::TCP_RETRY) && tcp_retry);
   // Debug("dns", "in_flight: %d, dns_max_dns_in_flight: %d", h->in_flight, dns_max_dns_in_flight);
   if (h->in_flight < dns_max_dns_in_flight) {
     DNSEntry *e = h->entries.head;
@@ -1180,10 +1266,15 @@ write_dns_event(DNSHandler *h, DNSEntry *e, bool over_tcp)
     h->release_query_id(e->id[dns_retries - e->retries]);
   }
   e->id[dns_retries - e->retries] = i;
-  int con_fd                      = over_tcp ? h->tcpcon[h->name_server].fd : h->udpcon[h->name_server].fd;
-  Debug("dns", "send query (qtype=%d) for %s to fd %d", e->qtype, e->qname, con_fd);
+  DNSConnection &con              = over_tcp ? h->tcpcon[h->name_server] : h->udpcon[h->name_server];
+  Debug("dns", "send query (qtype=%d) for %s to fd %d", e->qtype, e->qname, con.fd);
 
-  int s = SocketManager::send(con_fd, buffer, r, 0);
+  int s = con.send(buffer, r);
+  if (s == -EAGAIN && con.ssl && !con.tls_established) {
+    // The query is written once the TLS handshake completes.
+    Debug("dns", "TLS handshake in progress: qname = %s, nameserver = %d", e->qname, h->name_server);
+    return false;
+  }
   if (s != r) {
     Debug("dns", "send() failed: qname = %s, %d != %d, nameserver= %d", e->qname, s, r, h->name_server);
 
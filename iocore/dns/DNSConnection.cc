@@ -32,6 +32,9 @@
 #include "P_DNSConnection.h"
 #include "P_DNSProcessor.h"
 
+#include <openssl/err.h>
+#include <openssl/x509v3.h>
+
 #define SET_TCP_NO_DELAY
 #define SET_NO_LINGER
 #define SET_SO_KEEPALIVE
@@ -62,6 +65,11 @@ int
 DNSConnection::close()
 {
   eio.stop();
+  if (ssl) {
+    SSL_free(ssl);
+    ssl = nullptr;
+  }
+  tls_established = false;
   // don't close any of the standards
   if (fd >= 2) {
     int fd_save = fd;
@@ -198,6 +206,21 @@ DNSConnection::connect(sockaddr const *addr, Options const &opt)
     goto Lerror;
   }
 
+  if (opt._tls_ctx) {
+    if ((ssl = SSL_new(opt._tls_ctx)) == nullptr || !SSL_set_fd(ssl, fd)) {
+      res = -EIO;
+      goto Lerror;
+    }
+    SSL_set_connect_state(ssl);
+    if (opt._tls_server_name) {
+      SSL_set_tlsext_host_name(ssl, opt._tls_server_name);
+      SSL_set1_host(ssl, opt._tls_server_name);
+    } else {
+      ip_text_buffer b;
+      X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(ssl), ats_ip_ntop(addr, b, sizeof b));
+    }
+  }
+
   return 0;
 
 Lerror:
@@ -206,3 +229,90 @@ Lerror:
   }
   return res;
 }
+
+// Map the result of a non-blocking TLS call to the socket call conventions.
+static int
+tls_result(SSL *ssl, int r)
+{
+  switch (SSL_get_error(ssl, r)) {
+  case SSL_ERROR_WANT_READ:
+  case SSL_ERROR_WANT_WRITE:
+    return -EAGAIN;
+  case SSL_ERROR_ZERO_RETURN:
+    return 0;
+  case SSL_ERROR_SYSCALL:
+    // An unexpected EOF from the peer is reported this way.
+    return errno ? -errno : 0;
+  default:
+    return -EIO;
+  }
+}
+
+int
+DNSConnection::tls_handshake()
+{
+  ink_assert(ssl);
+  if (tls_established) {
+    return 1;
+  }
+
+  ERR_clear_error();
+  errno = 0;
+  int r = SSL_do_handshake(ssl);
+  if (r == 1) {
+    ip_port_text_buffer b;
+    tls_established = true;
+    Debug("dns", "TLS connection to %s established with %s", ats_ip_nptop(&ip.sa, b, sizeof b), SSL_get_version(ssl));
+    return 1;
+  }
+
+  r = tls_result(ssl, r);
+  if (r == -EAGAIN) {
+    return 0;
+  }
+  if (is_debug_tag_set("dns")) {
+    ip_port_text_buffer b;
+    char err[256];
+    if (unsigned long e = ERR_peek_last_error(); e != 0) {
+      ERR_error_string_n(e, err, sizeof(err));
+    } else {
+      ink_strlcpy(err, r ? strerror(-r) : "connection closed", sizeof(err));
+    }
+    Debug("dns", "TLS handshake with %s failed: %s", ats_ip_nptop(&ip.sa, b, sizeof b), err);
+  }
+  return r ? r : -ECONNRESET;
+}
+
+int
+DNSConnection::send(void const *buf, int len)
+{
+  if (!ssl) {
+    return SocketManager::send(fd, const_cast<void *>(buf), len, 0);
+  }
+
+  int r = tls_handshake();
+  if (r <= 0) {
+    return r ? r : -EAGAIN;
+  }
+  ERR_clear_error();
+  errno = 0;
+  r = SSL_write(ssl, buf, len);
+  return r > 0 ? r : tls_result(ssl, r);
+}
+
+int
+DNSConnection::recv(void *buf, int len, int flags)
+{
+  if (!ssl) {
+    return SocketManager::recv(fd, buf, len, flags);
+  }
+
+  int r = tls_handshake();
+  if (r <= 0) {
+    return r ? r : -EAGAIN;
+  }
+  ERR_clear_error();
+  errno = 0;
+  r = (flags & MSG_PEEK) ? SSL_peek(ssl, buf, len) : SSL_read(ssl, buf, len);
+  return r > 0 ? r : tls_result(ssl, r);
+}
@@ -31,6 +31,7 @@
 #define DNS_EVENT_LOOKUP DNS_EVENT_EVENTS_START
 
 const int DOMAIN_SERVICE_PORT = NAMESERVER_PORT;
+const int DNS_TLS_PORT        = 853; ///< RFC 7858 DNS over TLS.
 
 const int MAX_DNS_REQUEST_LEN  = NS_PACKETSZ;
 const int MAX_DNS_RESPONSE_LEN = 65536;
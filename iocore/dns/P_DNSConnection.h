@@ -33,11 +33,13 @@
 #include "I_EventSystem.h"
 #include "I_DNSProcessor.h"
 
+#include <openssl/ssl.h>
+
 //
 // Connection
 //
 struct DNSHandler;
-enum class DNS_CONN_MODE { UDP_ONLY, TCP_RETRY, TCP_ONLY };
+enum class DNS_CONN_MODE { UDP_ONLY, TCP_RETRY, TCP_ONLY, TLS_ONLY };
 
 struct DNSConnection {
   /// Options for connecting.
@@ -62,6 +64,12 @@ struct DNSConnection {
     /// Bind to this local address when using IPv4.
     /// Default: unset, bind to INADDRY_ANY.
     sockaddr const *_local_ipv4 = nullptr;
+    /// Run TLS with this context over the TCP connection (DNS over TLS).
+    /// Default: @c nullptr, no TLS.
+    SSL_CTX *_tls_ctx = nullptr;
+    /// Name to send as SNI and to verify the server certificate against.
+    /// Default: unset, verify the certificate against the server address.
+    char const *_tls_server_name = nullptr;
 
     Options();
 
@@ -71,6 +79,7 @@ struct DNSConnection {
     self &setBindRandomPort(bool p);
     self &setLocalIpv6(sockaddr const *addr);
     self &setLocalIpv4(sockaddr const *addr);
+    self &setTls(SSL_CTX *ctx, char const *server_name);
   };
 
   int fd;
@@ -80,7 +89,9 @@ struct DNSConnection {
   LINK(DNSConnection, link);
   EventIO eio;
   InkRand generator;
-  DNSHandler *handler = nullptr;
+  DNSHandler *handler  = nullptr;
+  SSL *ssl             = nullptr; ///< TLS session, if the connection uses TLS.
+  bool tls_established = false;   ///< TLS handshake is complete.
 
   /// TCPData structure is to track the reading progress of a TCP connection
   struct TCPData {
@@ -104,6 +115,30 @@ struct DNSConnection {
   int close();
   void trigger();
 
+  /** Send @a len bytes from @a buf, through TLS if the connection uses it.
+
+      While a TLS handshake is in progress this advances the handshake and
+      returns @c -EAGAIN.
+
+      @return The number of bytes sent, or a negative errno value.
+  */
+  int send(void const *buf, int len);
+
+  /** Receive up to @a len bytes into @a buf, through TLS if the connection uses it.
+
+      @a flags may be @c MSG_PEEK.
+
+      @return The number of bytes received, 0 at end of stream, or a negative errno value.
+  */
+  int recv(void *buf, int len, int flags = 0);
+
+  /** Advance the TLS handshake.
+
+      @return 1 once the handshake is complete, 0 if it is waiting for the
+      server, or a negative errno value if it failed.
+  */
+  int tls_handshake();
+
   virtual ~DNSConnection();
   DNSConnection();
 
@@ -148,3 +183,10 @@ DNSConnection::Options::setLocalIpv6(sockaddr const *ip)
   _local_ipv6 = ip;
   return *this;
 }
+inline DNSConnection::Options &
+DNSConnection::Options::setTls(SSL_CTX *ctx, char const *server_name)
+{
+  _tls_ctx         = ctx;
+  _tls_server_name = server_name;
+  return *this;
+}
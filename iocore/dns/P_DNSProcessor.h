@@ -264,6 +264,8 @@ private:
   // Check tcp connection for TCP_RETRY mode
   void check_and_reset_tcp_conn();
   bool reset_tcp_conn(int ndx);
+  // Reconnect a TLS connection closed by the server.
+  void reopen_tls_con(int ndx);
 
   /** The event used for the periodic retry of connectivity to any down name
    * servers. */
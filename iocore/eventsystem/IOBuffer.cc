@@ -35,6 +35,8 @@
 // General Buffer Allocator
 //
 FreelistAllocator ioBufAllocator[DEFAULT_BUFFER_SIZES];
+int thread_iobuffer_cache_size = 0;
+int thread_iobuffer_cache_limit[DEFAULT_BUFFER_SIZES];
 ClassAllocator<MIOBuffer> ioAllocator("ioAllocator", DEFAULT_BUFFER_NUMBER);
 ClassAllocator<IOBufferData> ioDataAllocator("ioDataAllocator", DEFAULT_BUFFER_NUMBER);
 ClassAllocator<IOBufferBlock> ioBlockAllocator("ioBlockAllocator", DEFAULT_BUFFER_NUMBER);
@@ -66,6 +68,14 @@ init_buffer_allocators(int iobuffer_advice, int chunk_sizes[DEFAULT_BUFFER_SIZES
       snprintf(name, 64, "ioBufAllocator[%d]", i);
     }
     ioBufAllocator[i].re_init(name, s, n, a, use_hugepages, iobuffer_advice);
+
+    // Large buffers are not worth keeping around per thread, a class gets no cache at all once a
+    // single buffer is bigger than the per thread budget.
+    int64_t limit = thread_iobuffer_cache_size / s;
+    if (thread_freelist_high_watermark > 0 && limit > thread_freelist_high_watermark) {
+      limit = thread_freelist_high_watermark;
+    }
+    thread_iobuffer_cache_limit[i] = limit;
   }
 }
 
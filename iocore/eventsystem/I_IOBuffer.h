@@ -112,6 +112,11 @@ enum AllocType {
 
 extern FreelistAllocator ioBufAllocator[DEFAULT_BUFFER_SIZES];
 
+/// Bytes of free buffers of each size that a thread keeps before returning them to @c ioBufAllocator.
+extern int thread_iobuffer_cache_size;
+/// Number of free buffers of each size that a thread keeps, derived from @c thread_iobuffer_cache_size.
+extern int thread_iobuffer_cache_limit[DEFAULT_BUFFER_SIZES];
+
 void init_buffer_allocators(int iobuffer_advice, int chunk_sizes[DEFAULT_BUFFER_SIZES], bool use_hugepages);
 void init_buffer_allocators(int iobuffer_advice);
 
@@ -1172,6 +1177,17 @@ public:
   */
   bool is_max_read_avail_more_than(int64_t size);
 
+  /**
+    Release the blocks of an idle buffer while keeping its readers.
+
+    Nothing is released if any reader still has data available. The readers
+    are left empty and a new block is allocated the next time the buffer is
+    written, so an idle connection does not hold on to a full block.
+
+    @return @c true if the blocks were released.
+  */
+  bool release_blocks();
+
   int max_block_count();
   void check_add_block();
 
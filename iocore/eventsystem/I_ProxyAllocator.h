@@ -65,6 +65,7 @@ thread_alloc(CAlloc &a, ProxyAllocator &l, Args &&...args)
 void *thread_alloc(Allocator &a, ProxyAllocator &l);
 
 void thread_freeup(Allocator &a, ProxyAllocator &l);
+void thread_freeup(Allocator &a, ProxyAllocator &l, int low_watermark);
 
 #if 1
 
@@ -67,6 +67,7 @@
 #include "tscore/ink_platform.h"
 #include "tscore/ink_thread.h"
 #include "I_ProxyAllocator.h"
+#include "I_IOBuffer.h"
 
 class ProxyMutex;
 
@@ -135,6 +136,7 @@ public:
   ProxyAllocator ioDataAllocator;
   ProxyAllocator ioAllocator;
   ProxyAllocator ioBlockAllocator;
+  ProxyAllocator ioBufAllocator[DEFAULT_BUFFER_SIZES];
   ProxyAllocator preWarmSMAllocator;
   // From InkAPI (plugins wrappers)
   ProxyAllocator apiHookAllocator;
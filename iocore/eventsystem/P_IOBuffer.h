@@ -227,6 +227,42 @@ new_IOBufferData_internal(const char *loc, int64_t size_index, AllocType type)
 // from being compiled correctly at -O3
 // so it is DUPLICATED in IOBuffer.cc
 // ****** IF YOU CHANGE THIS FUNCTION change that one as well.
+/**
+   Allocate a buffer from the calling thread's cache of @a size_index buffers, falling back to the
+   global @c ioBufAllocator when the cache is empty.
+ */
+TS_INLINE void *
+thread_iobuffer_alloc(int64_t size_index)
+{
+  Thread *t = this_thread();
+  if (t == nullptr) {
+    return ioBufAllocator[size_index].alloc_void();
+  }
+  return thread_alloc(ioBufAllocator[size_index], t->ioBufAllocator[size_index]);
+}
+
+/**
+   Return a buffer to the calling thread's cache. Once the cache holds more than its limit, half of
+   it is handed back to the global @c ioBufAllocator in one bulk free.
+ */
+TS_INLINE void
+thread_iobuffer_free(int64_t size_index, void *p)
+{
+  Thread *t       = this_thread();
+  const int limit = thread_iobuffer_cache_limit[size_index];
+  if (t == nullptr || limit <= 0 || cmd_disable_pfreelist) {
+    ioBufAllocator[size_index].free_void(p);
+    return;
+  }
+
+  ProxyAllocator &l        = t->ioBufAllocator[size_index];
+  *static_cast<void **>(p) = l.freelist;
+  l.freelist               = p;
+  if (++l.allocated > limit) {
+    thread_freeup(ioBufAllocator[size_index], l, limit / 2);
+  }
+}
+
 TS_INLINE void
 IOBufferData::alloc(int64_t size_index, AllocType type)
 {
@@ -239,7 +275,7 @@ IOBufferData::alloc(int64_t size_index, AllocType type)
   switch (type) {
   case MEMALIGNED:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(size_index)) {
-      _data = (char *)ioBufAllocator[size_index].alloc_void();
+      _data = static_cast<char *>(thread_iobuffer_alloc(size_index));
       // coverity[dead_error_condition]
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(size_index)) {
       _data = (char *)ats_memalign(ats_pagesize(), index_to_buffer_size(size_index));
@@ -248,7 +284,7 @@ IOBufferData::alloc(int64_t size_index, AllocType type)
   default:
   case DEFAULT_ALLOC:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(size_index)) {
-      _data = (char *)ioBufAllocator[size_index].alloc_void();
+      _data = static_cast<char *>(thread_iobuffer_alloc(size_index));
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(size_index)) {
       _data = (char *)ats_malloc(BUFFER_SIZE_FOR_XMALLOC(size_index));
     }
@@ -265,7 +301,7 @@ IOBufferData::dealloc()
   switch (_mem_type) {
   case MEMALIGNED:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(_size_index)) {
-      ioBufAllocator[_size_index].free_void(_data);
+      thread_iobuffer_free(_size_index, _data);
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(_size_index)) {
       ::free((void *)_data);
     }
@@ -273,7 +309,7 @@ IOBufferData::dealloc()
   default:
   case DEFAULT_ALLOC:
     if (BUFFER_SIZE_INDEX_IS_FAST_ALLOCATED(_size_index)) {
-      ioBufAllocator[_size_index].free_void(_data);
+      thread_iobuffer_free(_size_index, _data);
     } else if (BUFFER_SIZE_INDEX_IS_XMALLOCED(_size_index)) {
       ats_free(_data);
     }
@@ -950,6 +986,22 @@ MIOBuffer::max_read_avail()
   return s;
 }
 
+TS_INLINE bool
+MIOBuffer::release_blocks()
+{
+  if (!_writer || is_max_read_avail_more_than(0)) {
+    return false;
+  }
+  _writer = nullptr;
+  for (auto &reader : readers) {
+    if (reader.allocated()) {
+      reader.block        = nullptr;
+      reader.start_offset = 0;
+    }
+  }
+  return true;
+}
+
 TS_INLINE void
 MIOBuffer::set(void *b, int64_t len)
 {
@@ -60,13 +60,23 @@ protected:
 
 #if TS_USE_HWLOC
 
+  /// The topology object the thread @a t is bound to.
+  hwloc_obj_t obj_for(EThread *t) const;
   /// Allocate a stack based on NUMA information, if possible.
   void *alloc_numa_stack(EThread *t, size_t stacksize);
+  /// Bind the memory allocated by the calling thread to the NUMA nodes of @a obj.
+  /// @return @c true if a binding was set.
+  bool bind_thread_memory(hwloc_obj_t obj);
+  /// Reset the memory binding of the calling thread to the default.
+  void unbind_thread_memory();
 
 private:
   hwloc_obj_type_t obj_type = HWLOC_OBJ_MACHINE;
   int obj_count             = 0;
   char const *obj_name      = nullptr;
+  /// ET_NET threads on cores, the others on NUMA nodes, and the memory of each bound to its node.
+  bool numa_local = false;
+  int node_count  = 0;
 #endif
 };
 
@@ -216,6 +226,13 @@ ThreadAffinityInitializer::init()
   REC_ReadConfigInteger(affinity, "proxy.config.exec_thread.affinity");
 
   switch (affinity) {
+  case 5: // assign ET_NET threads to cores and the other threads to NUMA nodes, allocating from the local node
+    numa_local = true;
+    node_count = hwloc_get_nbobjs_by_type(ink_get_topology(), HWLOC_OBJ_NODE);
+    obj_type   = HWLOC_OBJ_CORE;
+    obj_name   = "Core";
+    break;
+
   case 4: // assign threads to logical processing units
 // Older versions of libhwloc (eg. Ubuntu 10.04) don't have HWLOC_OBJ_PU.
 #if HAVE_HWLOC_OBJ_PU
@@ -250,6 +267,16 @@ ThreadAffinityInitializer::init()
   Debug("iocore_thread", "Affinity: %d %ss: %d PU: %d", affinity, obj_name, obj_count, ink_number_of_processors());
 }
 
+hwloc_obj_t
+ThreadAffinityInitializer::obj_for(EThread *t) const
+{
+  if (numa_local && node_count > 0 && !t->is_event_type(ET_CALL)) {
+    // Only ET_NET threads are pinned, spread the stacks of the others over the NUMA nodes.
+    return hwloc_get_obj_by_type(ink_get_topology(), HWLOC_OBJ_NODE, t->id % node_count);
+  }
+  return hwloc_get_obj_by_type(ink_get_topology(), obj_type, t->id % obj_count);
+}
+
 int
 ThreadAffinityInitializer::set_affinity(int, Event *)
 {
@@ -257,7 +284,7 @@ ThreadAffinityInitializer::set_affinity(int, Event *)
 
   if (obj_count > 0) {
     // Get our `obj` instance with index based on the thread number we are on.
-    hwloc_obj_t obj = hwloc_get_obj_by_type(ink_get_topology(), obj_type, t->id % obj_count);
+    hwloc_obj_t obj = obj_for(t);
 #if HWLOC_API_VERSION >= 0x00010100
     int cpu_mask_len = hwloc_bitmap_snprintf(nullptr, 0, obj->cpuset) + 1;
     char *cpu_mask   = static_cast<char *>(alloca(cpu_mask_len));
@@ -267,22 +294,25 @@ ThreadAffinityInitializer::set_affinity(int, Event *)
     Debug("iocore_thread", "EThread: %d %s: %d", _name, obj->logical_index);
 #endif // HWLOC_API_VERSION
     hwloc_set_thread_cpubind(ink_get_topology(), t->tid, obj->cpuset, HWLOC_CPUBIND_STRICT);
+    // Everything the thread allocates from here on, its ProxyAllocator freelists and IOBuffer
+    // blocks included, comes from its own node.
+    if (numa_local && bind_thread_memory(obj)) {
+      Debug("iocore_thread", "EThread: %p memory bound to the NUMA node of %s %d", t, obj_name, obj->logical_index);
+    }
   } else {
     Warning("hwloc returned an unexpected number of objects -- CPU affinity disabled");
   }
   return 0;
 }
 
-void *
-ThreadAffinityInitializer::alloc_numa_stack(EThread *t, size_t stacksize)
+bool
+ThreadAffinityInitializer::bind_thread_memory(hwloc_obj_t obj)
 {
   hwloc_membind_policy_t mem_policy = HWLOC_MEMBIND_DEFAULT;
   hwloc_nodeset_t nodeset           = hwloc_bitmap_alloc();
   int num_nodes                     = 0;
-  void *stack                       = nullptr;
-  hwloc_obj_t obj                   = hwloc_get_obj_by_type(ink_get_topology(), obj_type, t->id % obj_count);
 
-  // Find the NUMA node set that correlates to our next thread CPU set
+  // Find the NUMA node set that correlates to the CPU set
   hwloc_cpuset_to_nodeset(ink_get_topology(), obj->cpuset, nodeset);
   // How many NUMA nodes will we be needing to allocate across?
   num_nodes = hwloc_get_nbobjs_inside_cpuset_by_type(ink_get_topology(), obj->cpuset, HWLOC_OBJ_NODE);
@@ -296,7 +326,7 @@ ThreadAffinityInitializer::alloc_numa_stack(EThread *t, size_t stacksize)
   }
 
   if (mem_policy != HWLOC_MEMBIND_DEFAULT) {
-    // Let's temporarily set the memory binding to our destination NUMA node
+    // Without HWLOC_MEMBIND_STRICT, the binding is a preference: a full node does not fail allocations.
 #if HWLOC_API_VERSION >= 0x20000
     hwloc_set_membind(ink_get_topology(), nodeset, mem_policy, HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET);
 #else
@@ -304,21 +334,34 @@ ThreadAffinityInitializer::alloc_numa_stack(EThread *t, size_t stacksize)
 #endif
   }
 
-  // Alloc our stack
-  stack = this->do_alloc_stack(stacksize);
+  hwloc_bitmap_free(nodeset);
 
-  if (mem_policy != HWLOC_MEMBIND_DEFAULT) {
-    // Now let's set it back to default for this thread.
+  return mem_policy != HWLOC_MEMBIND_DEFAULT;
+}
+
+void
+ThreadAffinityInitializer::unbind_thread_memory()
+{
 #if HWLOC_API_VERSION >= 0x20000
-    hwloc_set_membind(ink_get_topology(), hwloc_topology_get_topology_nodeset(ink_get_topology()), HWLOC_MEMBIND_DEFAULT,
-                      HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET);
+  hwloc_set_membind(ink_get_topology(), hwloc_topology_get_topology_nodeset(ink_get_topology()), HWLOC_MEMBIND_DEFAULT,
+                    HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET);
 #else
-    hwloc_set_membind_nodeset(ink_get_topology(), hwloc_topology_get_topology_nodeset(ink_get_topology()), HWLOC_MEMBIND_DEFAULT,
-                              HWLOC_MEMBIND_THREAD);
+  hwloc_set_membind_nodeset(ink_get_topology(), hwloc_topology_get_topology_nodeset(ink_get_topology()), HWLOC_MEMBIND_DEFAULT,
+                            HWLOC_MEMBIND_THREAD);
 #endif
-  }
+}
 
-  hwloc_bitmap_free(nodeset);
+void *
+ThreadAffinityInitializer::alloc_numa_stack(EThread *t, size_t stacksize)
+{
+  // Let's temporarily set the memory binding to our destination NUMA node
+  bool bound  = this->bind_thread_memory(obj_for(t));
+  void *stack = this->do_alloc_stack(stacksize);
+
+  if (bound) {
+    // Now let's set it back to default for this thread.
+    this->unbind_thread_memory();
+  }
 
   return stack;
 }
@@ -0,0 +1,107 @@
+/** @file
+
+  Per-thread IO buffer caches versus the shared ioBufAllocator freelists
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "P_EventSystem.h"
+
+namespace
+{
+class BThread : public Thread
+{
+public:
+  void
+  set_specific() override
+  {
+    Thread::set_specific();
+  }
+
+  void
+  execute() override
+  {
+  }
+};
+
+// Allocate and free @a count buffers of @a size_index on each of @a threads threads at once.
+template <typename Alloc, typename Free>
+void
+churn_iobuffers(int threads, int count, int64_t size_index, Alloc alloc, Free free)
+{
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([=]() {
+      BThread t;
+      t.set_specific();
+      std::vector<void *> buffers(count);
+      for (int round = 0; round < 10; ++round) {
+        for (auto &b : buffers) {
+          b = alloc(size_index);
+        }
+        for (auto b : buffers) {
+          free(size_index, b);
+        }
+      }
+      // drain the thread cache so the next run starts cold
+      for (auto &b : buffers) {
+        b = alloc(size_index);
+      }
+      for (auto b : buffers) {
+        ioBufAllocator[size_index].free_void(b);
+      }
+    });
+  }
+  for (auto &w : workers) {
+    w.join();
+  }
+}
+
+} // namespace
+
+TEST_CASE("IOBuffer thread cache", "[iocore]")
+{
+  thread_iobuffer_cache_size     = 1 << 20;
+  thread_freelist_high_watermark = 512;
+  init_buffer_allocators(0);
+
+  int const threads = 4;
+  int const count   = 128;
+
+  BENCHMARK("shared freelist 4K")
+  {
+    churn_iobuffers(
+      threads, count, BUFFER_SIZE_INDEX_4K, [](int64_t i) { return ioBufAllocator[i].alloc_void(); },
+      [](int64_t i, void *p) { ioBufAllocator[i].free_void(p); });
+    return threads;
+  };
+
+  BENCHMARK("thread cache 4K")
+  {
+    churn_iobuffers(threads, count, BUFFER_SIZE_INDEX_4K, thread_iobuffer_alloc, thread_iobuffer_free);
+    return threads;
+  };
+}
@@ -0,0 +1,155 @@
+/** @file
+
+  Memory held by idle connection buffers, before and after their blocks are released
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <iostream>
+#include <vector>
+
+#include "tscore/I_Layout.h"
+
+#include "I_EventSystem.h"
+#include "records/I_RecordsConfig.h"
+
+#include "diags.i"
+
+namespace
+{
+constexpr int CONNECTIONS = 1000;
+
+// A keep-alive connection: a request header buffer that has been read and
+// consumed, and a response buffer that has been written out.
+struct IdleConnection {
+  MIOBuffer *read_buffer      = nullptr;
+  IOBufferReader *read_reader = nullptr;
+
+  MIOBuffer *write_buffer      = nullptr;
+  IOBufferReader *write_reader = nullptr;
+
+  IdleConnection()
+  {
+    char data[1024] = {};
+
+    read_buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+    read_reader = read_buffer->alloc_reader();
+    read_buffer->write(data, sizeof(data));
+    read_reader->consume(read_reader->read_avail());
+
+    write_buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+    write_reader = write_buffer->alloc_reader();
+    write_buffer->write(data, sizeof(data));
+    write_reader->consume(write_reader->read_avail());
+  }
+
+  IdleConnection(IdleConnection const &) = delete;
+
+  ~IdleConnection()
+  {
+    free_MIOBuffer(read_buffer);
+    free_MIOBuffer(write_buffer);
+  }
+
+  void
+  park()
+  {
+    read_buffer->release_blocks();
+    write_buffer->release_blocks();
+  }
+
+  void
+  unpark()
+  {
+    read_buffer->write_avail();
+    write_buffer->write_avail();
+  }
+};
+
+int64_t
+held_bytes(IOBufferReader *reader)
+{
+  int64_t n = 0;
+  for (IOBufferBlock *b = reader->get_current_block(); b != nullptr; b = b->next.get()) {
+    n += sizeof(IOBufferBlock) + sizeof(IOBufferData) + b->block_size();
+  }
+  return n;
+}
+
+int64_t
+held_bytes(std::vector<IdleConnection> const &connections)
+{
+  int64_t n = 0;
+  for (auto const &c : connections) {
+    n += 2 * sizeof(MIOBuffer) + held_bytes(c.read_reader) + held_bytes(c.write_reader);
+  }
+  return n;
+}
+
+} // namespace
+
+TEST_CASE("IdleBuffers", "[iocore]")
+{
+  std::vector<IdleConnection> connections(CONNECTIONS);
+
+  int64_t const before = held_bytes(connections);
+  for (auto &c : connections) {
+    c.park();
+  }
+  int64_t const after = held_bytes(connections);
+
+  std::cout << "bytes per idle connection: " << before / CONNECTIONS << " active, " << after / CONNECTIONS << " parked"
+            << std::endl;
+  REQUIRE(after < before);
+
+  BENCHMARK("park and unpark")
+  {
+    for (auto &c : connections) {
+      c.unpark();
+      c.park();
+    }
+    return connections.size();
+  };
+}
+
+struct EventProcessorListener : Catch::TestEventListenerBase {
+  using TestEventListenerBase::TestEventListenerBase;
+
+  void
+  testRunStarting(Catch::TestRunInfo const &testRunInfo) override
+  {
+    Layout::create();
+    init_diags("", nullptr);
+    RecProcessInit();
+
+    LibRecordsConfigInit();
+
+    ink_event_system_init(EVENT_SYSTEM_MODULE_PUBLIC_VERSION);
+    eventProcessor.start(1);
+
+    EThread *main_thread = new EThread;
+    main_thread->set_specific();
+  }
+};
+
+CATCH_REGISTER_LISTENER(EventProcessorListener);
@@ -328,6 +328,36 @@ TEST_CASE("MIOBuffer", "[iocore]")
 
     free_MIOBuffer(miob);
   }
+
+  SECTION("release_blocks")
+  {
+    MIOBuffer *miob        = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+    IOBufferReader *miob_r = miob->alloc_reader();
+    uint8_t buf[4096];
+    memset(buf, 0xAA, sizeof(buf));
+
+    // nothing is released while there is data to read
+    miob->write(buf, 1024);
+    CHECK(miob->release_blocks() == false);
+    CHECK(miob->first_write_block() != nullptr);
+    CHECK(miob_r->read_avail() == 1024);
+
+    miob_r->consume(1024);
+    CHECK(miob->release_blocks() == true);
+    CHECK(miob->first_write_block() == nullptr);
+    CHECK(miob_r->get_current_block() == nullptr);
+    CHECK(miob_r->read_avail() == 0);
+    CHECK(miob->release_blocks() == false);
+
+    // the next write brings a block back and the reader sees the data
+    CHECK(miob->write_avail() == 4096);
+    CHECK(miob->first_write_block() != nullptr);
+    miob->write(buf, 512);
+    CHECK(miob_r->read_avail() == 512);
+    CHECK(miob_r->start()[0] == static_cast<char>(0xAA));
+
+    free_MIOBuffer(miob);
+  }
 }
 
 TEST_CASE("block size parser", "[iocore]")
@@ -583,7 +583,7 @@ struct ResolveInfo {
   int attempts = 0; ///< Number of connection attempts.
 
   char const *lookup_name             = nullptr;
-  char srv_hostname[MAXDNAME]         = {0};
+  char const *srv_hostname            = nullptr; ///< Target of the selected SRV record, owned by the caller.
   const sockaddr *inbound_remote_addr = nullptr; ///< Remote address of inbound client - used for hashing.
   in_port_t srv_port                  = 0;       ///< Port from SRV lookup or API call.
 
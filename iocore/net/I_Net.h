@@ -77,6 +77,7 @@ extern std::string_view net_ccp_out;
 #define NET_EVENT_DATAGRAM_READ_READY     (NET_EVENT_EVENTS_START + 10)
 #define NET_EVENT_DATAGRAM_OPEN           (NET_EVENT_EVENTS_START + 11)
 #define NET_EVENT_DATAGRAM_ERROR          (NET_EVENT_EVENTS_START + 12)
+#define NET_EVENT_PARKED                  (NET_EVENT_EVENTS_START + 13)
 #define NET_EVENT_ACCEPT_INTERNAL         (NET_EVENT_EVENTS_START + 22)
 #define NET_EVENT_CONNECT_INTERNAL        (NET_EVENT_EVENTS_START + 23)
 
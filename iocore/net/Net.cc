@@ -104,6 +104,7 @@ register_net_stats()
     {"proxy.process.net.default_inactivity_timeout_count",    default_inactivity_timeout_count_stat  },
     {"proxy.process.net.dynamic_keep_alive_timeout_in_count", keep_alive_queue_timeout_count_stat    },
     {"proxy.process.net.dynamic_keep_alive_timeout_in_total", keep_alive_queue_timeout_total_stat    },
+    {"proxy.process.net.keep_alive_parked",                   keep_alive_queue_parked_stat           },
     {"proxy.process.socks.connections_currently_open",        socks_connections_currently_open_stat  },
   };
 
@@ -127,6 +128,7 @@ register_net_stats()
   NET_CLEAR_DYN_STAT(socks_connections_currently_open_stat);
   NET_CLEAR_DYN_STAT(keep_alive_queue_timeout_total_stat);
   NET_CLEAR_DYN_STAT(keep_alive_queue_timeout_count_stat);
+  NET_CLEAR_DYN_STAT(keep_alive_queue_parked_stat);
   NET_CLEAR_DYN_STAT(default_inactivity_timeout_count_stat);
   NET_CLEAR_DYN_STAT(default_inactivity_timeout_applied_stat);
 
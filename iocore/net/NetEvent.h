@@ -57,6 +57,12 @@ public:
   // Close when EventIO close;
   virtual int close() = 0;
 
+  // Release memory held while idle in the keep-alive queue.
+  virtual void
+  park()
+  {
+  }
+
   bool has_error() const;
   void set_error_from_socket();
 
@@ -102,6 +108,9 @@ public:
   /** Whether the current timeout is a default inactivity timeout. */
   bool use_default_inactivity_timeout = false;
 
+  /** The time this was last placed in the keep-alive queue. */
+  ink_hrtime keep_alive_at = 0;
+
   LINK(NetEvent, open_link);
   LINK(NetEvent, cop_link);
   LINKM(NetEvent, read, ready_link)
@@ -120,6 +129,7 @@ public:
     struct {
       unsigned int got_local_addr : 1;
       unsigned int shutdown       : 2;
+      unsigned int parked         : 1;
     } f;
   };
 };
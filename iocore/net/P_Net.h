@@ -49,6 +49,7 @@ enum Net_Stats {
   inactivity_cop_lock_acquire_failure_stat,
   keep_alive_queue_timeout_total_stat,
   keep_alive_queue_timeout_count_stat,
+  keep_alive_queue_parked_stat,
   default_inactivity_timeout_applied_stat,
   default_inactivity_timeout_count_stat,
   net_fastopen_attempts_stat,
@@ -89,6 +89,10 @@ struct NetAccept : public Continuation {
   Ptr<NetAcceptAction> action_;
   SSLNextProtocolAccept *snpa = nullptr;
   EventIO ep;
+  /// With proxy.config.exec_thread.listen, the index of the thread whose own listening socket this is.
+  int thread_index = -1;
+  /// Accept the connections already queued, then close the listening socket.
+  bool draining = false;
 
   HttpProxyPort *proxyPort = nullptr;
   NetProcessor::AcceptOptions opt;
@@ -112,7 +116,7 @@ struct NetAccept : public Continuation {
   void cancel();
 
   explicit NetAccept(const NetProcessor::AcceptOptions &);
-  ~NetAccept() override { action_ = nullptr; }
+  ~NetAccept() override;
 };
 
 extern Ptr<ProxyMutex> naVecMutex;
@@ -480,6 +480,8 @@ private:
   int _ssl_read_from_net(EThread *lthread, int64_t &ret);
   ssl_error_t _ssl_read_buffer(void *buf, int64_t nbytes, int64_t &nread);
   ssl_error_t _ssl_write_buffer(const void *buf, int64_t nbytes, int64_t &nwritten);
+  /// Whether the kernel holds the transmit key, so that plain writes to the socket go out encrypted.
+  bool _ktls_send_active() const;
   ssl_error_t _ssl_connect();
   ssl_error_t _ssl_accept();
 };
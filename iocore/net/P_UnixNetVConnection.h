@@ -142,6 +142,7 @@ public:
   virtual void net_read_io(NetHandler *nh, EThread *lthread) override;
   virtual void net_write_io(NetHandler *nh, EThread *lthread) override;
   virtual void free(EThread *t) override;
+  virtual void park() override;
   virtual int
   close() override
   {
@@ -783,6 +783,17 @@ SSLNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf
     return this->super::load_buffer_and_write(towrite, buf, total_written, needs);
   }
 
+  // With kTLS the kernel encrypts whatever is written to the socket and frames the records itself, so write the
+  // blocks out directly instead of copying them through SSL_write one record at a time.
+  if (redoWriteSize == 0 && this->_ktls_send_active()) {
+    int64_t before = total_written;
+    int64_t r      = this->super::load_buffer_and_write(towrite, buf, total_written, needs);
+    if (total_written > before) {
+      SSL_INCREMENT_DYN_STAT_EX(ssl_ktls_bytes_sent_stat, total_written - before);
+    }
+    return r;
+  }
+
   Debug("ssl", "towrite=%" PRId64, towrite);
 
   do {
@@ -2291,6 +2302,21 @@ SSLNetVConnection::_ssl_connect()
   return ssl_error;
 }
 
+bool
+SSLNetVConnection::_ktls_send_active() const
+{
+#ifdef SSL_OP_ENABLE_KTLS
+  // Anything OpenSSL still has to send itself, such as early data or a key update, must go through SSL_write.
+  if (ssl == nullptr || !SSL_is_init_finished(ssl) || SSL_get_key_update_type(ssl) != SSL_KEY_UPDATE_NONE) {
+    return false;
+  }
+  BIO *wbio = SSL_get_wbio(ssl);
+  return wbio != nullptr && BIO_get_ktls_send(wbio);
+#else
+  return false;
+#endif
+}
+
 ssl_error_t
 SSLNetVConnection::_ssl_write_buffer(const void *buf, int64_t nbytes, int64_t &nwritten)
 {
@@ -187,6 +187,10 @@ SSLInitializeStatistics()
   RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.redo_record_size_count", RECD_COUNTER, RECP_PERSISTENT,
                      (int)ssl_total_dyn_redo_tls_record_count, RecRawStatSyncCount);
 
+  // Bytes handed to the kernel for encryption
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ktls_bytes_sent", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_ktls_bytes_sent_stat, RecRawStatSyncSum);
+
   // error stats
   RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_error_syscall", RECD_COUNTER, RECP_PERSISTENT,
                      (int)ssl_error_syscall, RecRawStatSyncCount);
@@ -79,6 +79,7 @@ enum SSL_Stats {
   ssl_total_dyn_def_tls_record_count,
   ssl_total_dyn_max_tls_record_count,
   ssl_total_dyn_redo_tls_record_count,
+  ssl_ktls_bytes_sent_stat, // application data written to a kTLS socket without SSL_write
   ssl_session_cache_hit,
   ssl_origin_session_cache_hit,
   ssl_session_cache_miss,
@@ -132,6 +132,7 @@ public:
     // Cleanup the active and keep-alive queues periodically
     nh.manage_active_queue(nullptr, true); // close any connections over the active timeout
     nh.manage_keep_alive_queue();
+    nh.park_keep_alive_queue();
 
     return 0;
   }
@@ -284,6 +285,9 @@ NetHandler::update_nethandler_config(const char *str, RecDataT, RecData data, vo
   } else if (name == "proxy.config.net.default_inactivity_timeout"sv) {
     updated_member = &NetHandler::global_config.default_inactivity_timeout;
     Debug("net_queue", "proxy.config.net.default_inactivity_timeout updated to %" PRId64, data.rec_int);
+  } else if (name == "proxy.config.net.keep_alive_park_threshold_in"sv) {
+    updated_member = &NetHandler::global_config.keep_alive_park_threshold_in;
+    Debug("net_queue", "proxy.config.net.keep_alive_park_threshold_in updated to %" PRId64, data.rec_int);
   }
 
   if (updated_member) {
@@ -319,6 +323,7 @@ NetHandler::init_for_process()
   REC_ReadConfigInt32(global_config.transaction_no_activity_timeout_in, "proxy.config.net.transaction_no_activity_timeout_in");
   REC_ReadConfigInt32(global_config.keep_alive_no_activity_timeout_in, "proxy.config.net.keep_alive_no_activity_timeout_in");
   REC_ReadConfigInt32(global_config.default_inactivity_timeout, "proxy.config.net.default_inactivity_timeout");
+  REC_ReadConfigInt32(global_config.keep_alive_park_threshold_in, "proxy.config.net.keep_alive_park_threshold_in");
 
   RecRegisterConfigUpdateCb("proxy.config.net.max_connections_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.max_requests_in", update_nethandler_config, nullptr);
@@ -326,6 +331,7 @@ NetHandler::init_for_process()
   RecRegisterConfigUpdateCb("proxy.config.net.transaction_no_activity_timeout_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.keep_alive_no_activity_timeout_in", update_nethandler_config, nullptr);
   RecRegisterConfigUpdateCb("proxy.config.net.default_inactivity_timeout", update_nethandler_config, nullptr);
+  RecRegisterConfigUpdateCb("proxy.config.net.keep_alive_park_threshold_in", update_nethandler_config, nullptr);
 
   Debug("net_queue", "proxy.config.net.max_connections_in updated to %d", global_config.max_connections_in);
   Debug("net_queue", "proxy.config.net.max_requests_in updated to %d", global_config.max_requests_in);
@@ -335,6 +341,7 @@ NetHandler::init_for_process()
   Debug("net_queue", "proxy.config.net.keep_alive_no_activity_timeout_in updated to %d",
         global_config.keep_alive_no_activity_timeout_in);
   Debug("net_queue", "proxy.config.net.default_inactivity_timeout updated to %d", global_config.default_inactivity_timeout);
+  Debug("net_queue", "proxy.config.net.keep_alive_park_threshold_in updated to %d", global_config.keep_alive_park_threshold_in);
 }
 
 //
@@ -657,6 +664,42 @@ NetHandler::manage_keep_alive_queue()
   }
 }
 
+/**
+   Release the memory of connections that have been idle in the keep-alive queue for at least
+   proxy.config.net.keep_alive_park_threshold_in seconds. The queue is ordered by the time the
+   connections entered it, so the walk stops at the first one that has not been idle long enough.
+ */
+void
+NetHandler::park_keep_alive_queue()
+{
+  if (!config.keep_alive_park_threshold_in) {
+    return;
+  }
+
+  ink_hrtime const cutoff = Thread::get_hrtime() - HRTIME_SECONDS(config.keep_alive_park_threshold_in);
+  int parked              = 0;
+  NetEvent *ne_next       = nullptr;
+  for (NetEvent *ne = keep_alive_queue.head; ne != nullptr && ne->keep_alive_at <= cutoff; ne = ne_next) {
+    ne_next = ne->keep_alive_queue_link.next;
+    if (ne->f.parked || ne->closed || ne->get_thread() != this_ethread()) {
+      continue;
+    }
+    MUTEX_TRY_LOCK(lock, ne->get_mutex(), this_ethread());
+    if (!lock.is_locked()) {
+      continue;
+    }
+    ne->f.parked = 1;
+    ++parked;
+    // This may close the connection, do not touch it afterwards.
+    ne->park();
+  }
+
+  if (parked > 0) {
+    NET_SUM_DYN_STAT(keep_alive_queue_parked_stat, parked);
+    Debug("net_queue", "parked %d idle connections, idle: %u", parked, keep_alive_queue_size);
+  }
+}
+
 void
 NetHandler::_close_ne(NetEvent *ne, ink_hrtime now, int &handle_event, int &closed, int &total_idle_time, int &total_idle_count)
 {
@@ -712,6 +755,8 @@ NetHandler::add_to_keep_alive_queue(NetEvent *ne)
     ++keep_alive_queue_size;
   }
   keep_alive_queue.enqueue(ne);
+  ne->keep_alive_at = Thread::get_hrtime();
+  ne->f.parked      = 0;
 
   // if keep-alive queue is over size then close connections
   manage_keep_alive_queue();
@@ -24,6 +24,10 @@
 #include <tscore/TSSystemState.h>
 #include <tscore/ink_defs.h>
 
+#include <algorithm>
+#include <mutex>
+#include <sched.h>
+
 #include "P_Net.h"
 
 using NetAcceptHandler = int (NetAccept::*)(int, void *);
@@ -33,12 +37,116 @@ int accept_till_done   = 1;
 // in different threads at the same time
 Ptr<ProxyMutex> naVecMutex;
 std::vector<NetAccept *> naVec;
+
+namespace
+{
+// The NetAccepts of the listening sockets each thread has of its own (exec_thread.listen), to drain
+// them and for their statistics.
+std::mutex naPerThreadMutex;
+std::vector<NetAccept *> naPerThread;
+
+// Statistics of the threads listening on their own sockets, for each thread in turn.
+enum {
+  ACCEPT_THREAD_ACCEPTS_STAT,
+  ACCEPT_THREAD_QUEUE_DEPTH_STAT,
+  N_ACCEPT_THREAD_STATS,
+};
+
+RecRawStatBlock *accept_thread_rsb = nullptr;
+int accept_thread_count            = 0;
+std::once_flag accept_thread_stats_once;
+
+// The connections waiting in the accept queue of the listening socket @a fd.
+int64_t
+listen_queue_depth(int fd)
+{
+#if defined(__linux__) && defined(TCP_INFO) && defined(HAVE_STRUCT_TCP_INFO)
+  struct tcp_info info;
+  socklen_t info_len = sizeof(info);
+  // For a listening socket, Linux reports the accept queue length as tcpi_unacked.
+  if (fd != NO_FD && getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &info_len) == 0) {
+    return info.tcpi_unacked;
+  }
+#else
+  (void)fd;
+#endif
+  return 0;
+}
+
+int
+accept_queue_stat_sync(const char *, RecDataT, RecData *, RecRawStatBlock *rsb, int)
+{
+  std::vector<int64_t> depth(accept_thread_count, 0);
+
+  {
+    std::lock_guard<std::mutex> lock(naPerThreadMutex);
+    for (NetAccept *na : naPerThread) {
+      depth[na->thread_index] += listen_queue_depth(na->server.fd);
+    }
+  }
+
+  ink_mutex_acquire(&(rsb->mutex));
+  for (int i = 0; i < accept_thread_count; ++i) {
+    int id                 = i * N_ACCEPT_THREAD_STATS + ACCEPT_THREAD_QUEUE_DEPTH_STAT;
+    rsb->global[id]->sum   = depth[i];
+    rsb->global[id]->count = 1;
+    RecRawStatUpdateSum(rsb, id);
+  }
+  ink_mutex_release(&(rsb->mutex));
+  return REC_ERR_OKAY;
+}
+
+void
+register_accept_thread_stats(int n_threads)
+{
+  char name[256];
+
+  accept_thread_count = n_threads;
+  accept_thread_rsb   = RecAllocateRawStatBlock(n_threads * N_ACCEPT_THREAD_STATS);
+  for (int i = 0; i < n_threads; ++i) {
+    snprintf(name, sizeof(name), "proxy.process.net.accept.thread_%d.accepts", i);
+    RecRegisterRawStat(accept_thread_rsb, RECT_PROCESS, name, RECD_INT, RECP_NON_PERSISTENT,
+                       i * N_ACCEPT_THREAD_STATS + ACCEPT_THREAD_ACCEPTS_STAT, RecRawStatSyncSum);
+    snprintf(name, sizeof(name), "proxy.process.net.accept.thread_%d.queue_depth", i);
+    RecRegisterRawStat(accept_thread_rsb, RECT_PROCESS, name, RECD_INT, RECP_NON_PERSISTENT,
+                       i * N_ACCEPT_THREAD_STATS + ACCEPT_THREAD_QUEUE_DEPTH_STAT, nullptr);
+  }
+  // All the queue depths are sampled in one pass, from the callback of the last one.
+  RecRegisterRawStatSyncCb(name, accept_queue_stat_sync, accept_thread_rsb, 0);
+}
+} // namespace
 static void
 safe_delay(int msec)
 {
   SocketManager::poll(nullptr, 0, msec);
 }
 
+// Prefer the listening socket @a fd for connections whose packets arrive on the (first) CPU the
+// calling thread is bound to, so that a connection stays on the core its NIC queue interrupts.
+static void
+set_incoming_cpu(int fd)
+{
+#if defined(SO_INCOMING_CPU)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0) {
+    return;
+  }
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpus)) {
+      if (safe_setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, reinterpret_cast<char *>(&cpu), sizeof(cpu)) < 0) {
+        Warning("[NetAccept::accept_per_thread]: can not steer fd %d to CPU %d: %s", fd, cpu, strerror(errno));
+      } else {
+        Debug("iocore_net_accept", "fd %d prefers connections received on CPU %d", fd, cpu);
+      }
+      return;
+    }
+  }
+#else
+  (void)fd;
+#endif
+}
+
 //
 // General case network connection accept code
 //
@@ -202,13 +310,24 @@ int
 NetAccept::accept_per_thread(int event, void *ep)
 {
   int listen_per_thread = 0;
+  int affinity          = 0;
   REC_ReadConfigInteger(listen_per_thread, "proxy.config.exec_thread.listen");
+  REC_ReadConfigInteger(affinity, "proxy.config.exec_thread.affinity");
 
   if (listen_per_thread == 1) {
     if (do_listen(NON_BLOCKING)) {
       Fatal("[NetAccept::accept_per_thread]:error listenting on ports");
       return -1;
     }
+    // Each ET_NET thread is bound to its own core, let the kernel pick its socket of the
+    // SO_REUSEPORT group for the connections that core receives.
+    if (affinity == 5) {
+      set_incoming_cpu(server.fd);
+    }
+    if (thread_index >= 0) {
+      std::lock_guard<std::mutex> lock(naPerThreadMutex);
+      naPerThread.push_back(this);
+    }
   }
 
   if (accept_fn == net_accept) {
@@ -242,11 +361,17 @@ NetAccept::init_accept_per_thread()
 
   SET_HANDLER(&NetAccept::accept_per_thread);
   n = eventProcessor.thread_group[opt.etype]._count;
+  if (listen_per_thread == 1) {
+    std::call_once(accept_thread_stats_once, register_accept_thread_stats, n);
+  }
 
   for (i = 0; i < n; i++) {
     NetAccept *a = (i < n - 1) ? clone() : this;
     EThread *t   = eventProcessor.thread_group[opt.etype]._thread[i];
     a->mutex     = get_NetHandler(t)->mutex;
+    if (listen_per_thread == 1 && n <= accept_thread_count) {
+      a->thread_index = i;
+    }
     t->schedule_imm(a);
   }
 }
@@ -254,6 +379,21 @@ NetAccept::init_accept_per_thread()
 void
 NetAccept::stop_accept()
 {
+  if (thread_index >= 0) {
+    // Each thread accepts what is already queued on its own socket before closing it. Connections
+    // that arrive after that go to the other sockets of the SO_REUSEPORT group, those of a
+    // traffic_server started to take over for instance. The ones in flight as a socket closes are
+    // reset, unless net.ipv4.tcp_migrate_req moves them to another socket of the group.
+    std::lock_guard<std::mutex> lock(naPerThreadMutex);
+    for (NetAccept *na : naPerThread) {
+      if (na->action_ == action_ && !na->draining) {
+        na->draining = true;
+        eventProcessor.thread_group[opt.etype]._thread[na->thread_index]->schedule_imm(na);
+      }
+    }
+    return;
+  }
+
   if (!action_->cancelled) {
     action_->cancel();
   }
@@ -430,6 +570,11 @@ NetAccept::acceptFastEvent(int event, void *ep)
   UnixNetVConnection *vc = nullptr;
   int loop               = accept_till_done;
 
+  if (server.fd == NO_FD) {
+    // Drained, this was queued before the socket closed.
+    return EVENT_DONE;
+  }
+
   do {
     socklen_t sz = sizeof(con.addr);
     int fd       = SocketManager::accept4(server.fd, &con.addr.sa, &sz, SOCK_NONBLOCK | SOCK_CLOEXEC);
@@ -445,6 +590,9 @@ NetAccept::acceptFastEvent(int event, void *ep)
       }
       Debug("iocore_net", "accepted a new socket: %d", fd);
       NET_SUM_GLOBAL_DYN_STAT(net_tcp_accept_stat, 1);
+      if (thread_index >= 0) {
+        RecIncrRawStatSum(accept_thread_rsb, e->ethread, thread_index * N_ACCEPT_THREAD_STATS + ACCEPT_THREAD_ACCEPTS_STAT, 1);
+      }
       if (opt.send_bufsize > 0) {
         if (unlikely(SocketManager::set_sndbuf_size(fd, opt.send_bufsize))) {
           bufsz = ROUNDUP(opt.send_bufsize, 1024);
@@ -531,6 +679,12 @@ NetAccept::acceptFastEvent(int event, void *ep)
   } while (loop);
 
 Ldone:
+  if (draining) {
+    Debug("iocore_net_accept", "drained fd %d of thread %d", server.fd, thread_index);
+    this->ep.stop();
+    server.close();
+    return EVENT_DONE;
+  }
   return EVENT_CONT;
 
 Lerror:
@@ -565,6 +719,17 @@ NetAccept::acceptLoopEvent(int event, Event *e)
 
 NetAccept::NetAccept(const NetProcessor::AcceptOptions &_opt) : Continuation(nullptr), opt(_opt) {}
 
+NetAccept::~NetAccept()
+{
+  if (thread_index >= 0) {
+    std::lock_guard<std::mutex> lock(naPerThreadMutex);
+    if (auto spot = std::find(naPerThread.begin(), naPerThread.end(), this); spot != naPerThread.end()) {
+      naPerThread.erase(spot);
+    }
+  }
+  action_ = nullptr;
+}
+
 //
 // Stop listening.  When the next poll takes place, an error will result.
 // THIS ONLY WORKS WITH POLLING STYLE ACCEPTS!
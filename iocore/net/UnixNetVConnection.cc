@@ -1385,6 +1385,22 @@ UnixNetVConnection::_getNetProcessor()
   return &netProcessor;
 }
 
+// Drop the buffer blocks of an idle connection, they are allocated again
+// on the next read or write. The session is then told to shrink its own state.
+void
+UnixNetVConnection::park()
+{
+  if (read.vio.op == VIO::READ && read.vio.ntodo() > 0 && read.vio.buffer.writer()) {
+    read.vio.buffer.writer()->release_blocks();
+  }
+  if (write.vio.op == VIO::WRITE && write.vio.ntodo() > 0 && write.vio.buffer.writer()) {
+    write.vio.buffer.writer()->release_blocks();
+  }
+  if (read.vio.cont && read.vio.mutex == read.vio.cont->mutex) {
+    read_signal_and_update(NET_EVENT_PARKED, this);
+  }
+}
+
 void
 UnixNetVConnection::add_to_keep_alive_queue()
 {
@@ -44,9 +44,12 @@ struct RemapConfigs {
   RemapConfigs() { memset(_items, 0, sizeof(_items)); };
   bool parse_file(const char *filename);
   bool parse_inline(const char *arg);
+  bool build_overlay();
 
   Item _items[MAX_OVERRIDABLE_CONFIGS];
   int _current = 0;
+  // The items, applied to transactions as a whole so that they share one copy of the configuration.
+  TSHttpConfigOverlay _overlay = nullptr;
 };
 
 // Helper function for the parser
@@ -253,6 +256,41 @@ RemapConfigs::parse_file(const char *filename)
   return (_current > 0);
 }
 
+// Collect the parsed configurations into the overlay the transactions are pointed at.
+bool
+RemapConfigs::build_overlay()
+{
+  _overlay = TSHttpConfigOverlayCreate();
+
+  for (int ix = 0; ix < _current; ++ix) {
+    TSReturnCode ret = TS_ERROR;
+
+    switch (_items[ix]._type) {
+    case TS_RECORDDATATYPE_INT:
+      ret = TSHttpConfigOverlayIntSet(_overlay, _items[ix]._name, _items[ix]._data.rec_int);
+      TSDebug(PLUGIN_NAME, "Setting config id %d to %" PRId64 "", _items[ix]._name, _items[ix]._data.rec_int);
+      break;
+    case TS_RECORDDATATYPE_STRING:
+      ret = TSHttpConfigOverlayStringSet(_overlay, _items[ix]._name, _items[ix]._data.rec_string, _items[ix]._data_len);
+      TSDebug(PLUGIN_NAME, "Setting config id %d to %s", _items[ix]._name, _items[ix]._data.rec_string);
+      break;
+    case TS_RECORDDATATYPE_FLOAT:
+      ret = TSHttpConfigOverlayFloatSet(_overlay, _items[ix]._name, _items[ix]._data.rec_float);
+      TSDebug(PLUGIN_NAME, "Setting config id %d to %f", _items[ix]._name, _items[ix]._data.rec_float);
+      break;
+    default:
+      break;
+    }
+
+    if (ret != TS_SUCCESS) {
+      TSError("[%s] Unable to set config id %d", PLUGIN_NAME, _items[ix]._name);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Initialize the plugin as a remap plugin.
 //
@@ -296,11 +334,15 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char * /* errbuf ATS_UNUSE
     }
   }
 
+  if (!conf->build_overlay()) {
+    goto fail;
+  }
+
   *ih = static_cast<void *>(conf);
   return TS_SUCCESS;
 
 fail:
-  delete conf;
+  TSRemapDeleteInstance(conf);
   return TS_ERROR;
 }
 
@@ -315,6 +357,9 @@ TSRemapDeleteInstance(void *ih)
     }
   }
 
+  if (conf->_overlay) {
+    TSHttpConfigOverlayDestroy(conf->_overlay);
+  }
   delete conf;
 }
 
@@ -326,26 +371,9 @@ TSRemapDoRemap(void *ih, TSHttpTxn rh, TSRemapRequestInfo * /* rri ATS_UNUSED */
 {
   if (nullptr != ih) {
     RemapConfigs *conf = static_cast<RemapConfigs *>(ih);
-    TSHttpTxn txnp     = static_cast<TSHttpTxn>(rh);
-
-    for (int ix = 0; ix < conf->_current; ++ix) {
-      switch (conf->_items[ix]._type) {
-      case TS_RECORDDATATYPE_INT:
-        TSHttpTxnConfigIntSet(txnp, conf->_items[ix]._name, conf->_items[ix]._data.rec_int);
-        TSDebug(PLUGIN_NAME, "Setting config id %d to %" PRId64 "", conf->_items[ix]._name, conf->_items[ix]._data.rec_int);
-        break;
-      case TS_RECORDDATATYPE_STRING:
-        TSHttpTxnConfigStringSet(txnp, conf->_items[ix]._name, conf->_items[ix]._data.rec_string, conf->_items[ix]._data_len);
-        TSDebug(PLUGIN_NAME, "Setting config id %d to %s", conf->_items[ix]._name, conf->_items[ix]._data.rec_string);
-        break;
-      case TS_RECORDDATATYPE_FLOAT:
-        TSHttpTxnConfigFloatSet(txnp, conf->_items[ix]._name, conf->_items[ix]._data.rec_int);
-        TSDebug(PLUGIN_NAME, "Setting config id %d to %f", conf->_items[ix]._name, conf->_items[ix]._data.rec_float);
-        break;
-      default:
-        break; // Error ?
-      }
-    }
+
+    TSHttpTxnConfigOverlayApply(rh, conf->_overlay);
+    TSDebug(PLUGIN_NAME, "Applied %d configurations", conf->_current);
   }
 
   return TSREMAP_NO_REMAP; // This plugin never rewrites anything.
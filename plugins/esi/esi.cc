@@ -45,6 +45,7 @@
 #include "HandlerManager.h"
 #include "serverIntercept.h"
 #include "Stats.h"
+#include "TemplateCache.h"
 #include "HttpDataFetcherImpl.h"
 using std::string;
 using std::list;
@@ -56,6 +57,7 @@ struct OptionInfo {
   bool private_response;
   bool disable_gzip_output;
   bool first_byte_flush;
+  TemplateCache *template_cache;
 };
 
 static HandlerManager *gHandlerManager = nullptr;
@@ -112,6 +114,8 @@ struct ContData {
   DataType input_type;
   string packed_node_list;
   string gzipped_data;
+  string etag;
+  TemplateCache::Entry cached_node_list; // parsed document, if the template cache has it
   char debug_tag[32];
   bool gzip_output;
   bool initialized;
@@ -264,6 +268,19 @@ ContData::init()
     esi_gzip   = new EsiGzip(createDebugTag(GZIP_DEBUG_TAG, contp, gzip_tag), &TSDebug, &TSError);
     esi_gunzip = new EsiGunzip(createDebugTag(GUNZIP_DEBUG_TAG, contp, gunzip_tag), &TSDebug, &TSError);
 
+    // With the document already parsed, the includes can be fetched right away, and the
+    // document itself is only drained.
+    if (cached_node_list) {
+      if (esi_proc->usePackedNodeList(*cached_node_list) == EsiProcessor::PROCESS_SUCCESS) {
+        TSDebug(debug_tag, "[%s] Using parsed document from template cache", __FUNCTION__);
+        Stats::increment(Stats::N_TEMPLATE_CACHE_HITS);
+      } else {
+        TSError("[esi][%s] Could not use parsed document from template cache; parsing document", __FUNCTION__);
+        cached_node_list.reset();
+        esi_proc->start();
+      }
+    }
+
     TSDebug(debug_tag, "[%s] Set input data type to [%s]", __FUNCTION__, DATA_TYPE_NAMES_[input_type]);
 
     retval = true;
@@ -475,6 +492,20 @@ ContData::getServerState()
     fillPostHeader(bufp, hdr_loc);
   }
 
+  if (option_info->template_cache && request_url && !head_only) {
+    TSMLoc field_loc = TSMimeHdrFieldFind(bufp, hdr_loc, TS_MIME_FIELD_ETAG, TS_MIME_LEN_ETAG);
+    if (field_loc) {
+      int value_len;
+      const char *value = TSMimeHdrFieldValueStringGet(bufp, hdr_loc, field_loc, -1, &value_len);
+      if (value && value_len) {
+        etag.assign(value, value_len);
+        cached_node_list = option_info->template_cache->get(request_url, etag);
+        TSDebug(DEBUG_TAG, "[%s] Template cache %s for ETag %s", __FUNCTION__, cached_node_list ? "hit" : "miss", etag.c_str());
+      }
+      TSHandleMLocRelease(bufp, hdr_loc, field_loc);
+    }
+  }
+
   TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdr_loc);
 }
 
@@ -674,7 +705,9 @@ transformData(TSCont contp)
         // Now start extraction
         while (block != nullptr) {
           data = TSIOBufferBlockReadStart(block, cont_data->input_reader, &data_len);
-          if (cont_data->input_type == DATA_TYPE_RAW_ESI) {
+          if (cont_data->cached_node_list) {
+            // the document was parsed before, see init()
+          } else if (cont_data->input_type == DATA_TYPE_RAW_ESI) {
             cont_data->esi_proc->addParseData(data, data_len);
           } else if (cont_data->input_type == DATA_TYPE_GZIPPED_ESI) {
             string udata = "";
@@ -710,7 +743,9 @@ transformData(TSCont contp)
   }
   if (process_input_complete) {
     TSDebug(cont_data->debug_tag, "[%s] Completed reading input", __FUNCTION__);
-    if (cont_data->input_type == DATA_TYPE_PACKED_ESI) {
+    if (cont_data->cached_node_list) {
+      // nothing to parse
+    } else if (cont_data->input_type == DATA_TYPE_PACKED_ESI) {
       TSDebug(DEBUG_TAG, "[%s] Going to use packed node list of size %d", __FUNCTION__,
               static_cast<int>(cont_data->packed_node_list.size()));
       if (cont_data->esi_proc->usePackedNodeList(cont_data->packed_node_list) == EsiProcessor::UNPACK_FAILURE) {
@@ -722,7 +757,7 @@ transformData(TSCont contp)
       }
     }
 
-    if (cont_data->input_type != DATA_TYPE_PACKED_ESI) {
+    if (!cont_data->cached_node_list && cont_data->input_type != DATA_TYPE_PACKED_ESI) {
       bool gunzip_complete = true;
       if (cont_data->input_type == DATA_TYPE_GZIPPED_ESI) {
         gunzip_complete = cont_data->esi_gunzip->stream_finish();
@@ -732,6 +767,11 @@ transformData(TSCont contp)
             !cont_data->head_only) {
           cacheNodeList(cont_data);
         }
+        if (cont_data->option_info->template_cache && !cont_data->etag.empty()) {
+          string packed;
+          cont_data->esi_proc->packNodeList(packed, false);
+          cont_data->option_info->template_cache->put(cont_data->request_url, cont_data->etag, std::move(packed));
+        }
       }
     }
 
@@ -1600,11 +1640,12 @@ esiPluginInit(int argc, const char *argv[], struct OptionInfo *pOptionInfo)
       {const_cast<char *>("disable-gzip-output"), no_argument,       nullptr, 'z'},
       {const_cast<char *>("first-byte-flush"),    no_argument,       nullptr, 'b'},
       {const_cast<char *>("handler-filename"),    required_argument, nullptr, 'f'},
+      {const_cast<char *>("template-cache"),      required_argument, nullptr, 't'},
       {nullptr,                                   0,                 nullptr, 0  },
     };
 
     int longindex = 0;
-    while ((c = getopt_long(argc, const_cast<char *const *>(argv), "npzbf:", longopts, &longindex)) != -1) {
+    while ((c = getopt_long(argc, const_cast<char *const *>(argv), "npzbf:t:", longopts, &longindex)) != -1) {
       switch (c) {
       case 'n':
         pOptionInfo->packed_node_support = true;
@@ -1624,6 +1665,14 @@ esiPluginInit(int argc, const char *argv[], struct OptionInfo *pOptionInfo)
         gHandlerManager->loadObjects(handler_conf);
         break;
       }
+      case 't': {
+        int max_entries = atoi(optarg);
+        if (max_entries > 0) {
+          delete pOptionInfo->template_cache;
+          pOptionInfo->template_cache = new TemplateCache(max_entries);
+        }
+        break;
+      }
       default:
         break;
       }
@@ -1633,9 +1682,9 @@ esiPluginInit(int argc, const char *argv[], struct OptionInfo *pOptionInfo)
   TSDebug(DEBUG_TAG,
           "[%s] Plugin started, "
           "packed-node-support: %d, private-response: %d, "
-          "disable-gzip-output: %d, first-byte-flush: %d ",
+          "disable-gzip-output: %d, first-byte-flush: %d, template-cache: %d ",
           __FUNCTION__, pOptionInfo->packed_node_support, pOptionInfo->private_response, pOptionInfo->disable_gzip_output,
-          pOptionInfo->first_byte_flush);
+          pOptionInfo->first_byte_flush, pOptionInfo->template_cache != nullptr);
 
   return 0;
 }
@@ -1742,6 +1791,11 @@ TSRemapDeleteInstance(void *ih)
 {
   TSCont contp = static_cast<TSCont>(ih);
   if (contp != nullptr) {
+    struct OptionInfo *pOptionInfo = static_cast<struct OptionInfo *>(TSContDataGet(contp));
+    if (pOptionInfo != nullptr) {
+      delete pOptionInfo->template_cache;
+      pOptionInfo->template_cache = nullptr;
+    }
     TSContDestroy(contp);
   }
 }
@@ -40,14 +40,15 @@ public:
 namespace Stats
 {
   enum STAT {
-    N_OS_DOCS           = 0,
-    N_CACHE_DOCS        = 1,
-    N_PARSE_ERRS        = 2,
-    N_INCLUDES          = 3,
-    N_INCLUDE_ERRS      = 4,
-    N_SPCL_INCLUDES     = 5,
-    N_SPCL_INCLUDE_ERRS = 6,
-    MAX_STAT_ENUM       = 7
+    N_OS_DOCS             = 0,
+    N_CACHE_DOCS          = 1,
+    N_PARSE_ERRS          = 2,
+    N_INCLUDES            = 3,
+    N_INCLUDE_ERRS        = 4,
+    N_SPCL_INCLUDES       = 5,
+    N_SPCL_INCLUDE_ERRS   = 6,
+    N_TEMPLATE_CACHE_HITS = 7,
+    MAX_STAT_ENUM         = 8
   };
 
   extern const char *STAT_NAMES[MAX_STAT_ENUM];
@@ -0,0 +1,73 @@
+/** @file
+
+  Cache of parsed ESI documents, keyed by URL and validated by ETag.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "TemplateCache.h"
+
+using namespace EsiLib;
+
+TemplateCache::Entry
+TemplateCache::get(const std::string &url, std::string_view etag)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  auto it = _index.find(url);
+  if (it == _index.end() || it->second->etag != etag) {
+    return nullptr;
+  }
+  _lru.splice(_lru.begin(), _lru, it->second);
+  return it->second->node_list;
+}
+
+void
+TemplateCache::put(const std::string &url, std::string_view etag, std::string &&packed_node_list)
+{
+  if (_max_entries == 0) {
+    return;
+  }
+
+  Entry node_list = std::make_shared<const std::string>(std::move(packed_node_list));
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  auto it = _index.find(url);
+  if (it != _index.end()) {
+    it->second->etag.assign(etag.data(), etag.size());
+    it->second->node_list = std::move(node_list);
+    _lru.splice(_lru.begin(), _lru, it->second);
+    return;
+  }
+
+  if (_lru.size() >= _max_entries) {
+    _index.erase(_lru.back().url);
+    _lru.pop_back();
+  }
+  _lru.push_front(Template{url, std::string(etag), std::move(node_list)});
+  // The key views the URL held by the list node, which does not move.
+  _index.emplace(_lru.front().url, _lru.begin());
+}
+
+size_t
+TemplateCache::size() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _lru.size();
+}
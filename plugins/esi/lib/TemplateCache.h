@@ -0,0 +1,70 @@
+/** @file
+
+  Cache of parsed ESI documents, keyed by URL and validated by ETag.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace EsiLib
+{
+/** Keeps the node lists of parsed ESI documents in memory, packed as by DocNodeList::pack(), so
+ * that a document the origin serves again unchanged is not parsed again.
+ *
+ * There is one entry per URL, which is only returned for the ETag it was stored with. Entries are
+ * evicted least recently used first. All methods are thread safe, and an entry that was returned
+ * stays valid for as long as the caller holds on to it, even once it is evicted.
+ */
+class TemplateCache
+{
+public:
+  using Entry = std::shared_ptr<const std::string>;
+
+  explicit TemplateCache(size_t max_entries) : _max_entries(max_entries) {}
+
+  /** The packed node list of the document at @a url, if it was stored for @a etag. */
+  Entry get(const std::string &url, std::string_view etag);
+
+  /** Store the packed node list of the document at @a url, replacing any older version. */
+  void put(const std::string &url, std::string_view etag, std::string &&packed_node_list);
+
+  size_t size() const;
+
+private:
+  struct Template {
+    std::string url;
+    std::string etag;
+    Entry node_list;
+  };
+  using LruList = std::list<Template>;
+
+  mutable std::mutex _mutex;
+  size_t _max_entries;
+  LruList _lru; ///< Most recently used first.
+  std::unordered_map<std::string_view, LruList::iterator> _index;
+};
+}; // namespace EsiLib
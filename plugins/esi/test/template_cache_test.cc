@@ -0,0 +1,116 @@
+/** @file
+
+  A brief file description
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <iostream>
+#include <cassert>
+#include <string>
+
+#include "DocNode.h"
+#include "TemplateCache.h"
+
+using std::cout;
+using std::endl;
+using std::string;
+using namespace EsiLib;
+
+int
+main()
+{
+  {
+    cout << endl << "===================== Test 1" << endl;
+    // only the ETag the document was stored with matches
+    TemplateCache cache(4);
+    assert(cache.get("http://a/", "\"1\"") == nullptr);
+
+    cache.put("http://a/", "\"1\"", "packed-a1");
+    assert(cache.size() == 1);
+    TemplateCache::Entry entry = cache.get("http://a/", "\"1\"");
+    assert(entry && *entry == "packed-a1");
+    assert(cache.get("http://a/", "\"2\"") == nullptr);
+    assert(cache.get("http://b/", "\"1\"") == nullptr);
+  }
+
+  {
+    cout << endl << "===================== Test 2" << endl;
+    // a new version replaces the old one, which stays valid for its holders
+    TemplateCache cache(4);
+    cache.put("http://a/", "\"1\"", "packed-a1");
+    TemplateCache::Entry old_entry = cache.get("http://a/", "\"1\"");
+
+    cache.put("http://a/", "\"2\"", "packed-a2");
+    assert(cache.size() == 1);
+    assert(cache.get("http://a/", "\"1\"") == nullptr);
+    TemplateCache::Entry entry = cache.get("http://a/", "\"2\"");
+    assert(entry && *entry == "packed-a2");
+    assert(*old_entry == "packed-a1");
+  }
+
+  {
+    cout << endl << "===================== Test 3" << endl;
+    // the least recently used document is evicted first
+    TemplateCache cache(2);
+    cache.put("http://a/", "\"1\"", "packed-a");
+    cache.put("http://b/", "\"1\"", "packed-b");
+    assert(cache.get("http://a/", "\"1\"") != nullptr);
+
+    cache.put("http://c/", "\"1\"", "packed-c");
+    assert(cache.size() == 2);
+    assert(cache.get("http://a/", "\"1\"") != nullptr);
+    assert(cache.get("http://b/", "\"1\"") == nullptr);
+    assert(cache.get("http://c/", "\"1\"") != nullptr);
+  }
+
+  {
+    cout << endl << "===================== Test 4" << endl;
+    // a cache without room stores nothing
+    TemplateCache cache(0);
+    cache.put("http://a/", "\"1\"", "packed-a");
+    assert(cache.size() == 0);
+    assert(cache.get("http://a/", "\"1\"") == nullptr);
+  }
+
+  {
+    cout << endl << "===================== Test 5" << endl;
+    // a packed node list comes back unchanged
+    DocNodeList node_list;
+    node_list.push_back(DocNode(DocNode::TYPE_PRE));
+    node_list.back().data     = "<html>";
+    node_list.back().data_len = 6;
+    string packed;
+    node_list.pack(packed);
+
+    TemplateCache cache(1);
+    cache.put("http://a/", "\"1\"", string(packed));
+    TemplateCache::Entry entry = cache.get("http://a/", "\"1\"");
+    assert(entry && *entry == packed);
+
+    DocNodeList unpacked;
+    assert(unpacked.unpack(*entry));
+    assert(unpacked.size() == 1);
+    assert(unpacked.front().type == DocNode::TYPE_PRE);
+    assert(string(unpacked.front().data, unpacked.front().data_len) == "<html>");
+  }
+
+  cout << endl << "All tests passed!" << endl;
+  return 0;
+}
@@ -125,13 +125,14 @@ Config::fromArgs(int const argc, char const *const argv[])
     {const_cast<char *>("blockbytes-test"),      required_argument, nullptr, 't'},
     {const_cast<char *>("prefetch-count"),       required_argument, nullptr, 'f'},
     {const_cast<char *>("strip-range-for-head"), no_argument,       nullptr, 'h'},
+    {const_cast<char *>("window-count"),         required_argument, nullptr, 'w'},
     {nullptr,                                    0,                 nullptr, 0  },
   };
 
   // getopt assumes args start at '1' so this hack is needed
   char *const *argvp = (const_cast<char *const *>(argv) - 1);
   for (;;) {
-    int const opt = getopt_long(argc + 1, argvp, "b:dc:e:i:lp:r:s:t:", longopts, nullptr);
+    int const opt = getopt_long(argc + 1, argvp, "b:dc:e:i:lp:r:s:t:w:", longopts, nullptr);
     if (-1 == opt) {
       break;
     }
@@ -230,6 +231,15 @@ Config::fromArgs(int const argc, char const *const argv[])
     case 'h': {
       m_head_strip_range = true;
     } break;
+    case 'w': {
+      int const countread = atoi(optarg);
+      if (0 <= countread && countread <= windowcountmax) {
+        DEBUG_LOG("Using window count %d", countread);
+        m_windowcount = countread;
+      } else {
+        ERROR_LOG("Invalid window-count: %s", optarg);
+      }
+    } break;
     default:
       break;
     }
@@ -249,6 +259,10 @@ Config::fromArgs(int const argc, char const *const argv[])
   } else {
     DEBUG_LOG("Block stitching error logs at most every %d sec(s)", m_paceerrsecs);
   }
+  if (0 < m_windowcount && 0 < m_prefetchcount) {
+    DEBUG_LOG("Window count supersedes prefetch count");
+    m_prefetchcount = 0;
+  }
   if (m_crr_ims_header.empty()) {
     m_crr_ims_header = DefaultCrrImsHeader;
     DEBUG_LOG("Using default crr ims header %s", m_crr_ims_header.c_str());
@@ -34,6 +34,7 @@ struct Config {
   static constexpr int64_t const blockbytesmin     = 1024 * 256;        // 256KB
   static constexpr int64_t const blockbytesmax     = 1024 * 1024 * 128; // 128MB
   static constexpr int64_t const blockbytesdefault = 1024 * 1024;       // 1MB
+  static constexpr int const windowcountmax         = 32;                // blocks in flight ahead of the client
 
   int64_t m_blockbytes{blockbytesdefault};
   std::string m_remaphost; // remap host to use for loopback slice GET
@@ -44,6 +45,7 @@ struct Config {
   pcre_extra *m_regex_extra{nullptr};
   int m_paceerrsecs{0};   // -1 disable logging, 0 no pacing, max 60s
   int m_prefetchcount{0}; // 0 disables prefetching
+  int m_windowcount{0};   // 0 disables the read ahead window
   enum RefType { First, Relative };
   RefType m_reftype{First};       // reference slice is relative to request
   bool m_head_req{false};         // HEAD request
@@ -23,6 +23,7 @@
 #include "HttpHeader.h"
 #include "Range.h"
 #include "Stage.h"
+#include "window.h"
 
 #include <netinet/in.h>
 #include <unordered_map>
@@ -95,6 +96,8 @@ struct Data {
 
   bool m_prefetchable{false};
 
+  BlockWindow m_window; // blocks requested ahead of the client stream
+
   HdrMgr m_req_hdrmgr;  // manager for server request
   HdrMgr m_resp_hdrmgr; // manager for client response
 
@@ -496,122 +496,137 @@ handleNextServerHeader(Data *const data, TSCont const contp)
   return true;
 }
 
-} // namespace
-
-// this is called every time the server has data for us
-void
-handle_server_resp(TSCont contp, TSEvent event, Data *const data)
+// parse the block header if needed and pass on the content,
+// false if the block ended here and data may be gone
+bool
+handle_server_bytes(TSCont const contp, Data *const data)
 {
-  switch (event) {
-  case TS_EVENT_VCONN_READ_READY: {
-    if (data->m_blockstate == BlockState::Passthru) {
-      transfer_all_bytes(data);
-      return;
+  // has block response header been parsed??
+  if (!data->m_server_block_header_parsed) {
+    int64_t consumed              = 0;
+    TSIOBufferReader const reader = data->m_upstream.m_read.m_reader;
+    TSVIO const input_vio         = data->m_upstream.m_read.m_vio;
+    TSParseResult const res       = data->m_resp_hdrmgr.populateFrom(data->m_http_parser, reader, TSHttpHdrParseResp, &consumed);
+
+    TSVIONDoneSet(input_vio, TSVIONDoneGet(input_vio) + consumed);
+
+    // the server response header didn't fit into the input buffer.
+    // wait for more data from upstream
+    if (TS_PARSE_CONT == res) {
+      return true;
     }
 
-    // has block response header been parsed??
-    if (!data->m_server_block_header_parsed) {
-      int64_t consumed              = 0;
-      TSIOBufferReader const reader = data->m_upstream.m_read.m_reader;
-      TSVIO const input_vio         = data->m_upstream.m_read.m_vio;
-      TSParseResult const res       = data->m_resp_hdrmgr.populateFrom(data->m_http_parser, reader, TSHttpHdrParseResp, &consumed);
+    bool headerStat = false;
 
-      TSVIONDoneSet(input_vio, TSVIONDoneGet(input_vio) + consumed);
+    if (TS_PARSE_DONE == res) {
+      if (!data->m_server_first_header_parsed) {
+        HeaderState const state = handleFirstServerHeader(data, contp);
 
-      // the server response header didn't fit into the input buffer.
-      // wait for more data from upstream
-      if (TS_PARSE_CONT == res) {
-        return;
+        data->m_server_first_header_parsed = true;
+        switch (state) {
+        case HeaderState::Fail:
+          data->m_blockstate = BlockState::Fail;
+          headerStat         = false;
+          break;
+        case HeaderState::Passthru: {
+          data->m_blockstate = BlockState::Passthru;
+          transfer_all_bytes(data);
+          DEBUG_LOG("Going into a passthru state");
+          return true;
+        } break;
+        case HeaderState::Good:
+        default:
+          headerStat = true;
+          break;
+        }
+      } else {
+        headerStat = handleNextServerHeader(data, contp);
       }
 
-      bool headerStat = false;
-
-      if (TS_PARSE_DONE == res) {
-        if (!data->m_server_first_header_parsed) {
-          HeaderState const state = handleFirstServerHeader(data, contp);
-
-          data->m_server_first_header_parsed = true;
-          switch (state) {
-          case HeaderState::Fail:
-            data->m_blockstate = BlockState::Fail;
-            headerStat         = false;
-            break;
-          case HeaderState::Passthru: {
-            data->m_blockstate = BlockState::Passthru;
-            transfer_all_bytes(data);
-            DEBUG_LOG("Going into a passthru state");
-            return;
-          } break;
-          case HeaderState::Good:
-          default:
-            headerStat = true;
-            break;
-          }
-        } else {
-          headerStat = handleNextServerHeader(data, contp);
-        }
+      data->m_server_block_header_parsed = true;
+    }
 
-        data->m_server_block_header_parsed = true;
+    // kill the upstream and allow dnstream to clean up
+    if (!headerStat) {
+      data->m_upstream.abort();
+      data->m_blockstate = BlockState::Fail;
+      if (data->m_dnstream.m_write.isOpen()) {
+        TSVIOReenable(data->m_dnstream.m_write.m_vio);
+      } else {
+        shutdown(contp, data);
       }
+      return false;
+    }
 
-      // kill the upstream and allow dnstream to clean up
-      if (!headerStat) {
-        data->m_upstream.abort();
+    // header may have been successfully parsed but with caveats
+    switch (data->m_blockstate) {
+      // request new version of current internal slice
+    case BlockState::PendingInt:
+    case BlockState::PendingRef: {
+      if (!request_block(contp, data)) {
         data->m_blockstate = BlockState::Fail;
         if (data->m_dnstream.m_write.isOpen()) {
           TSVIOReenable(data->m_dnstream.m_write.m_vio);
         } else {
           shutdown(contp, data);
         }
-        return;
       }
-
-      // header may have been successfully parsed but with caveats
-      switch (data->m_blockstate) {
-        // request new version of current internal slice
-      case BlockState::PendingInt:
-      case BlockState::PendingRef: {
-        if (!request_block(contp, data)) {
-          data->m_blockstate = BlockState::Fail;
-          if (data->m_dnstream.m_write.isOpen()) {
-            TSVIOReenable(data->m_dnstream.m_write.m_vio);
-          } else {
-            shutdown(contp, data);
-          }
-        }
-        return;
-      } break;
-      case BlockState::ActiveRef: {
-        // Mark the reference block for "skip".
-        int64_t const blockbytes      = data->m_config->m_blockbytes;
-        int64_t const firstblock      = data->m_req_range.firstBlockFor(blockbytes);
-        int64_t const blockpos        = firstblock * blockbytes;
-        int64_t const firstblockbytes = std::min(blockbytes, data->m_contentlen - blockpos);
-        data->m_blockskip             = firstblockbytes;
-
-        // Check if we should abort the client
-        if (data->m_dnstream.isOpen()) {
-          TSVIO const output_vio    = data->m_dnstream.m_write.m_vio;
-          int64_t const output_done = TSVIONDoneGet(output_vio);
-          int64_t const output_sent = data->m_bytessent;
-          if (output_done == output_sent) {
-            data->m_dnstream.abort();
-          }
+      return false;
+    } break;
+    case BlockState::ActiveRef: {
+      // Mark the reference block for "skip".
+      int64_t const blockbytes      = data->m_config->m_blockbytes;
+      int64_t const firstblock      = data->m_req_range.firstBlockFor(blockbytes);
+      int64_t const blockpos        = firstblock * blockbytes;
+      int64_t const firstblockbytes = std::min(blockbytes, data->m_contentlen - blockpos);
+      data->m_blockskip             = firstblockbytes;
+
+      // Check if we should abort the client
+      if (data->m_dnstream.isOpen()) {
+        TSVIO const output_vio    = data->m_dnstream.m_write.m_vio;
+        int64_t const output_done = TSVIONDoneGet(output_vio);
+        int64_t const output_sent = data->m_bytessent;
+        if (output_done == output_sent) {
+          data->m_dnstream.abort();
         }
-      } break;
-      default: {
-        // how much to normally fast forward into this data block
-        data->m_blockskip = data->m_req_range.skipBytesForBlock(data->m_config->m_blockbytes, data->m_blocknum);
-      } break;
       }
+    } break;
+    default: {
+      // how much to normally fast forward into this data block
+      data->m_blockskip = data->m_req_range.skipBytesForBlock(data->m_config->m_blockbytes, data->m_blocknum);
+    } break;
     }
+  }
 
-    transfer_content_bytes(data);
+  transfer_content_bytes(data);
+  return true;
+}
+
+} // namespace
+
+// this is called every time the server has data for us
+void
+handle_server_resp(TSCont contp, TSEvent event, Data *const data)
+{
+  switch (event) {
+  case TS_EVENT_VCONN_READ_READY: {
+    if (data->m_blockstate == BlockState::Passthru) {
+      transfer_all_bytes(data);
+      return;
+    }
+
+    handle_server_bytes(contp, data);
   } break;
   case TS_EVENT_VCONN_READ_COMPLETE: {
     // fprintf(stderr, "%p: TS_EVENT_VCONN_READ_COMPLETE\n", data);
   } break;
   case TS_EVENT_VCONN_EOS: {
+    // a block requested ahead may have arrived whole before this read
+    if (!data->m_server_block_header_parsed && reader_avail_more_than(data->m_upstream.m_read.m_reader, 0) &&
+        !handle_server_bytes(contp, data)) {
+      return;
+    }
+
     switch (data->m_blockstate) {
     case BlockState::ActiveRef:
     case BlockState::Passthru: {
@@ -144,3 +144,43 @@ TEST_CASE("config fromargs validate sizes", "[AWS][slice][utility]")
     }
   }
 }
+
+TEST_CASE("config fromargs window count", "[AWS][slice][utility]")
+{
+  char const *const appname = "slice.so";
+
+  std::vector<std::pair<std::string, int>> const tests = {
+    {"--window-count=4",                                             4                     },
+    {"-w8",                                                          8                     },
+    {"--window-count=0",                                             0                     },
+    {"--window-count=-1",                                            0                     },
+    {"--window-count=" + std::to_string(Config::windowcountmax),     Config::windowcountmax},
+    {"--window-count=" + std::to_string(Config::windowcountmax + 1), 0                     },
+  };
+
+  for (std::pair<std::string, int> const &test : tests) {
+    optind = 0;
+
+    std::vector<char *> argv;
+    argv.push_back((char *)appname);
+    argv.push_back((char *)test.first.c_str());
+
+    Config config;
+    config.fromArgs(argv.size(), argv.data());
+
+    INFO(test.first.c_str());
+    CHECK(test.second == config.m_windowcount);
+  }
+
+  // the window supersedes background prefetching
+  optind = 0;
+
+  std::string const window   = "--window-count=4";
+  std::string const prefetch = "--prefetch-count=2";
+  std::vector<char *> argv   = {(char *)appname, (char *)window.c_str(), (char *)prefetch.c_str()};
+
+  Config config;
+  config.fromArgs(argv.size(), argv.data());
+  CHECK(4 == config.m_windowcount);
+  CHECK(0 == config.m_prefetchcount);
+}
@@ -66,6 +66,25 @@ request_block(TSCont contp, Data *const data)
     break;
   }
 
+  // the block may already be on its way
+  if (BlockState::Pending == data->m_blockstate && data->m_window.adopt(contp, data)) {
+    TSHttpParserClear(data->m_http_parser);
+    data->m_resp_hdrmgr.resetHeader();
+
+    data->m_blockexpected              = 0;
+    data->m_blockconsumed              = 0;
+    data->m_server_block_header_parsed = false;
+    data->m_blockstate                 = BlockState::Active;
+
+    data->m_window.fill(contp, data);
+    return true;
+  }
+
+  // blocks requested ahead may be from an older version of the asset
+  if (BlockState::Pending != data->m_blockstate) {
+    data->m_window.clear();
+  }
+
   int64_t const blockbeg = (data->m_config->m_blockbytes * data->m_blocknum);
   Range blockbe(blockbeg, blockbeg + data->m_config->m_blockbytes);
 
@@ -170,6 +189,10 @@ request_block(TSCont contp, Data *const data)
     break;
   }
 
+  if (BlockState::Active == data->m_blockstate) {
+    data->m_window.fill(contp, data);
+  }
+
   return true;
 }
 
@@ -0,0 +1,241 @@
+/** @file
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "window.h"
+
+#include "Config.h"
+#include "Data.h"
+#include "HttpHeader.h"
+
+#include <cinttypes>
+
+namespace
+{
+// room for the block response header on top of the block
+constexpr int64_t const headerbytes = 32 * 1024;
+} // namespace
+
+BlockWindow::~BlockWindow()
+{
+  clear();
+}
+
+void
+BlockWindow::release(WindowFetch *const fetch)
+{
+  fetch->m_stream.abort();
+  if (nullptr != fetch->m_cont) {
+    TSContDataSet(fetch->m_cont, nullptr);
+    TSContDestroy(fetch->m_cont);
+  }
+  delete fetch;
+}
+
+void
+BlockWindow::clear()
+{
+  for (WindowFetch *const fetch : m_fetches) {
+    release(fetch);
+  }
+  m_fetches.clear();
+}
+
+bool
+BlockWindow::adopt(TSCont contp, Data *const data)
+{
+  // anything behind the client stream is of no use anymore
+  while (!m_fetches.empty() && m_fetches.front()->m_blocknum < data->m_blocknum) {
+    release(m_fetches.front());
+    m_fetches.pop_front();
+  }
+
+  if (m_fetches.empty() || m_fetches.front()->m_blocknum != data->m_blocknum) {
+    return false;
+  }
+
+  WindowFetch *const fetch = m_fetches.front();
+  m_fetches.pop_front();
+
+  // the request must be out, nothing may be left for the fetch continuation
+  Channel &request = fetch->m_stream.m_write;
+  if (request.isOpen()) {
+    if (TSVIONDoneGet(request.m_vio) < TSVIONBytesGet(request.m_vio)) {
+      fetch->m_failed = true;
+    } else {
+      TSVConnShutdown(fetch->m_stream.m_vc, 0, 1);
+      request.close();
+    }
+  }
+
+  if (fetch->m_failed) {
+    DEBUG_LOG("Window block %" PRId64 " unusable, requesting it again", fetch->m_blocknum);
+    release(fetch);
+    return false;
+  }
+
+  Config const *const conf = data->m_config;
+  if (!fetch->m_complete) {
+    // the client stream caught up with the origin
+    if (m_size < conf->m_windowcount) {
+      ++m_size;
+      DEBUG_LOG("Window grown to %d blocks", m_size);
+    }
+  } else if (1 < m_size && !m_fetches.empty() && m_fetches.front()->m_complete) {
+    // the origin runs more than a block ahead of the client stream
+    --m_size;
+    DEBUG_LOG("Window shrunk to %d blocks", m_size);
+  }
+
+  DEBUG_LOG("Using window block %" PRId64 ", %s", fetch->m_blocknum, fetch->m_complete ? "complete" : "in flight");
+
+  // take over the connection along with what was read so far
+  Stage &upstream = data->m_upstream;
+  upstream.setupConnection(fetch->m_stream.m_vc);
+  fetch->m_stream.m_vc = nullptr;
+  std::swap(upstream.m_read.m_iobuf, fetch->m_stream.m_read.m_iobuf);
+  std::swap(upstream.m_read.m_reader, fetch->m_stream.m_read.m_reader);
+  upstream.m_read.m_vio = TSVConnRead(upstream.m_vc, contp, upstream.m_read.m_iobuf, INT64_MAX);
+
+  release(fetch);
+
+  return true;
+}
+
+void
+BlockWindow::fill(TSCont contp, Data *const data)
+{
+  Config const *const conf = data->m_config;
+
+  // the extent of the object is known once the first block arrived
+  if (0 == conf->m_windowcount || conf->m_head_req || data->m_contentlen < 0) {
+    return;
+  }
+
+  // the current block is being requested directly
+  while (!m_fetches.empty() && m_fetches.front()->m_blocknum <= data->m_blocknum) {
+    release(m_fetches.front());
+    m_fetches.pop_front();
+  }
+
+  int64_t blocknum = data->m_blocknum + 1;
+  if (!m_fetches.empty()) {
+    blocknum = m_fetches.back()->m_blocknum + 1;
+  }
+
+  for (; blocknum <= data->m_blocknum + m_size; ++blocknum) {
+    if (!data->m_req_range.blockIsInside(conf->m_blockbytes, blocknum)) {
+      break;
+    }
+
+    WindowFetch *const fetch = new WindowFetch(blocknum);
+    if (!issue(contp, data, fetch)) {
+      release(fetch);
+      break;
+    }
+    m_fetches.push_back(fetch);
+  }
+}
+
+bool
+BlockWindow::issue(TSCont contp, Data *const data, WindowFetch *const fetch)
+{
+  Config const *const conf = data->m_config;
+
+  int64_t const blockbeg = (conf->m_blockbytes * fetch->m_blocknum);
+  Range blockbe(blockbeg, blockbeg + conf->m_blockbytes);
+
+  char rangestr[1024];
+  int rangelen      = sizeof(rangestr);
+  bool const rpstat = blockbe.toStringClosed(rangestr, &rangelen);
+  TSAssert(rpstat);
+
+  DEBUG_LOG("Request window block: %s", rangestr);
+
+  // reuse the incoming client header, just change the range
+  HttpHeader header(data->m_req_hdrmgr.m_buffer, data->m_req_hdrmgr.m_lochdr);
+
+  bool const rangestat = header.setKeyVal(TS_MIME_FIELD_RANGE, TS_MIME_LEN_RANGE, rangestr, rangelen);
+  if (!rangestat) {
+    ERROR_LOG("Error trying to set range request header %s", rangestr);
+    return false;
+  }
+  header.removeKey(SLICE_CRR_HEADER.data(), SLICE_CRR_HEADER.size());
+
+  // shares the transaction mutex, events never race the client stream
+  fetch->m_cont = TSContCreate(handler, TSContMutexGet(contp));
+  TSContDataSet(fetch->m_cont, static_cast<void *>(fetch));
+
+  // create virtual connection back into ATS
+  TSHttpConnectOptions options = TSHttpConnectOptionsGet(TS_CONNECT_PLUGIN);
+  options.addr                 = reinterpret_cast<sockaddr *>(&data->m_client_ip);
+  options.tag                  = PLUGIN_NAME;
+  options.id                   = 0;
+  options.buffer_index         = data->m_buffer_index;
+  options.buffer_water_mark    = data->m_buffer_water_mark;
+
+  TSVConn const upvc = TSHttpConnectPlugin(&options);
+
+  int const hlen = TSHttpHdrLengthGet(header.m_buffer, header.m_lochdr);
+
+  fetch->m_stream.setupConnection(upvc);
+  fetch->m_stream.setupVioWrite(fetch->m_cont, hlen);
+  TSHttpHdrPrint(header.m_buffer, header.m_lochdr, fetch->m_stream.m_write.m_iobuf);
+  TSVIOReenable(fetch->m_stream.m_write.m_vio);
+
+  // buffer the whole block until the client stream gets to it
+  fetch->m_stream.setupVioRead(fetch->m_cont, INT64_MAX);
+  TSIOBufferWaterMarkSet(fetch->m_stream.m_read.m_iobuf, conf->m_blockbytes + headerbytes);
+
+  return true;
+}
+
+int
+BlockWindow::handler(TSCont contp, TSEvent event, void * /* edata ATS_UNUSED */)
+{
+  WindowFetch *const fetch = static_cast<WindowFetch *>(TSContDataGet(contp));
+
+  if (nullptr == fetch) {
+    return 0;
+  }
+
+  switch (event) {
+  case TS_EVENT_VCONN_WRITE_COMPLETE:
+    TSVConnShutdown(fetch->m_stream.m_vc, 0, 1);
+    fetch->m_stream.m_write.close();
+    break;
+  case TS_EVENT_VCONN_READ_READY:
+    // left in the buffer for the client stream
+    break;
+  case TS_EVENT_VCONN_READ_COMPLETE:
+  case TS_EVENT_VCONN_EOS:
+    fetch->m_complete = true;
+    break;
+  case TS_EVENT_NET_ACCEPT_FAILED:
+  case TS_EVENT_VCONN_INACTIVITY_TIMEOUT:
+  case TS_EVENT_VCONN_ACTIVE_TIMEOUT:
+  case TS_EVENT_ERROR:
+    fetch->m_failed = true;
+    fetch->m_stream.abort();
+    break;
+  default:
+    DEBUG_LOG("Unhandled window fetch event:%s (%d)", TSHttpEventNameLookup(event), event);
+    break;
+  }
+
+  return 0;
+}
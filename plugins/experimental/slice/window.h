@@ -0,0 +1,81 @@
+/** @file
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "ts/ts.h"
+
+#include "Stage.h"
+
+#include <deque>
+
+struct Data;
+
+/**
+ * @brief A block request issued ahead of the client stream.
+ *
+ * The response is left in the read channel, whose water mark is raised
+ * to hold a whole block, until the client stream reaches the block and
+ * takes over the connection.
+ */
+struct WindowFetch {
+  WindowFetch(WindowFetch const &)            = delete;
+  WindowFetch &operator=(WindowFetch const &) = delete;
+
+  explicit WindowFetch(int64_t blocknum) : m_blocknum(blocknum) {}
+
+  Stage m_stream;
+  int64_t m_blocknum;
+  TSCont m_cont{nullptr};
+  bool m_complete{false}; // whole response read
+  bool m_failed{false};
+};
+
+/**
+ * @brief Block requests kept in flight ahead of the client stream.
+ *
+ * The window grows by a block whenever the client stream reaches a block
+ * that is still arriving, and shrinks by a block when the next two are
+ * already complete, so that it follows the origin fill rate against the
+ * client drain rate.  At most Config::m_windowcount blocks are buffered.
+ */
+struct BlockWindow {
+  BlockWindow(BlockWindow const &)            = delete;
+  BlockWindow &operator=(BlockWindow const &) = delete;
+
+  BlockWindow() {}
+  ~BlockWindow();
+
+  // Hand the response for the current block over to the upstream stage
+  bool adopt(TSCont contp, Data *const data);
+
+  // Issue requests for the blocks following the current one
+  void fill(TSCont contp, Data *const data);
+
+  // Abort all requests in flight
+  void clear();
+
+  static int handler(TSCont contp, TSEvent event, void *edata);
+
+  int m_size{1};
+  std::deque<WindowFetch *> m_fetches; // ordered by block number
+
+private:
+  bool issue(TSCont contp, Data *const data, WindowFetch *const fetch);
+  static void release(WindowFetch *const fetch);
+};
@@ -80,4 +80,30 @@ Condition::initialize(Parser &p)
   }
 
   _cond_op = parse_matcher_op(p.get_arg());
+  _source  = value_source();
+}
+
+const std::string *
+Condition::equal_to() const
+{
+  if (_source.empty() || _cond_op != MATCH_EQUAL || (_mods & COND_NOT)) {
+    return nullptr;
+  }
+
+  return &static_cast<const Matchers<std::string> *>(_matcher)->get();
+}
+
+const std::string &
+Condition::source_value(const Resources &res)
+{
+  for (auto const &[source, value] : res.values) {
+    if (source == _source) {
+      return value;
+    }
+  }
+
+  std::string value;
+
+  append_value(value, res);
+  return res.values.emplace_back(_source, std::move(value)).second;
 }
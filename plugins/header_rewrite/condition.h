@@ -59,32 +59,13 @@ public:
   Condition(const Condition &)      = delete;
   void operator=(const Condition &) = delete;
 
-  // Inline this, it's critical for speed (and only used twice)
+  // Evaluate this condition alone, with its NOT modifier applied. Inline this, it's critical for speed.
   bool
-  do_eval(const Resources &res)
+  test(const Resources &res)
   {
     bool rt = eval(res);
 
-    if (_mods & COND_NOT) {
-      rt = !rt;
-    }
-
-    if (_next) {
-      if (_mods & COND_OR) {
-        return rt || (static_cast<Condition *>(_next)->do_eval(res));
-      } else { // AND is the default
-        // Short circuit if we're an AND and the first condition is FALSE.
-        if (rt) {
-          return static_cast<Condition *>(_next)->do_eval(res);
-        } else {
-          return false;
-        }
-      }
-    } else {
-      return rt;
-    }
-
-    return false; // Shouldn't happen.
+    return (_mods & COND_NOT) ? !rt : rt;
   }
 
   bool
@@ -93,6 +74,18 @@ public:
     return _mods & COND_LAST;
   }
 
+  CondModifiers
+  mods() const
+  {
+    return _mods;
+  }
+
+  Condition *
+  next() const
+  {
+    return static_cast<Condition *>(_next);
+  }
+
   // Setters
   virtual void
   set_qualifier(const std::string &q)
@@ -119,10 +112,27 @@ public:
     return _qualifier;
   }
 
+  // The string this condition requires its value to be equal to, or nullptr if it's not a plain
+  // equality test on a value_source().
+  const std::string *equal_to() const;
+
+  // This condition's value for the transaction. The value is read once per hook, and shared by
+  // all conditions with the same value_source(), until operators run.
+  const std::string &source_value(const Resources &res);
+
   // Virtual methods, has to be implemented by each conditional;
   void initialize(Parser &p) override;
   virtual void append_value(std::string &s, const Resources &res) = 0;
 
+  // Identifies the value this condition tests, when that value is read from the transaction's
+  // headers or URL for the current hook. A condition returning a source must use a
+  // Matchers<std::string>. Empty if the value can't be shared with other conditions.
+  virtual std::string
+  value_source() const
+  {
+    return "";
+  }
+
 protected:
   // Evaluate the condition
   virtual bool eval(const Resources &res) = 0;
@@ -133,4 +143,5 @@ protected:
 
 private:
   CondModifiers _mods = COND_NONE;
+  std::string _source;
 };
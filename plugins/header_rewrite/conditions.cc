@@ -250,15 +250,24 @@ ConditionHeader::append_value(std::string &s, const Resources &res)
   }
 }
 
+std::string
+ConditionHeader::value_source() const
+{
+  std::string source = _client ? "CLIENT-HEADER:" : "HEADER:";
+
+  // Header names are case insensitive.
+  for (char c : _qualifier) {
+    source += std::tolower(static_cast<unsigned char>(c));
+  }
+  return source;
+}
+
 bool
 ConditionHeader::eval(const Resources &res)
 {
-  std::string s;
-
-  append_value(s, res);
   TSDebug(PLUGIN_NAME, "Evaluating HEADER()");
 
-  return static_cast<const MatcherType *>(_matcher)->test(s);
+  return static_cast<const MatcherType *>(_matcher)->test(source_value(res));
 }
 
 // ConditionUrl: request or response header. TODO: This is not finished, at all!!!
@@ -370,13 +379,16 @@ ConditionUrl::append_value(std::string &s, const Resources &res)
   }
 }
 
+std::string
+ConditionUrl::value_source() const
+{
+  return "URL:" + std::to_string(_type) + ":" + std::to_string(_url_qual);
+}
+
 bool
 ConditionUrl::eval(const Resources &res)
 {
-  std::string s;
-
-  append_value(s, res);
-  return static_cast<const Matchers<std::string> *>(_matcher)->test(s);
+  return static_cast<const Matchers<std::string> *>(_matcher)->test(source_value(res));
 }
 
 // ConditionDBM: do a lookup against a DBM
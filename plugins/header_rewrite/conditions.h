@@ -258,6 +258,7 @@ public:
 
   void initialize(Parser &p) override;
   void append_value(std::string &s, const Resources &res) override;
+  std::string value_source() const override;
 
 protected:
   bool eval(const Resources &res) override;
@@ -283,6 +284,7 @@ public:
   void initialize(Parser &p) override;
   void set_qualifier(const std::string &q) override;
   void append_value(std::string &s, const Resources &res) override;
+  std::string value_source() const override;
 
 protected:
   bool eval(const Resources &res) override;
@@ -27,6 +27,7 @@
 
 #include "parser.h"
 #include "ruleset.h"
+#include "ruleindex.h"
 #include "resources.h"
 #include "conditions.h"
 #include "conditions_geo.h"
@@ -91,6 +92,11 @@ public:
   {
     return _rules[hook];
   }
+  const RuleIndex &
+  index(int hook) const
+  {
+    return _index[hook];
+  }
 
   bool parse_config(const std::string &fname, TSHttpHookID default_hook);
 
@@ -100,6 +106,7 @@ private:
   TSCont _cont;
   RuleSet *_rules[TS_HTTP_LAST_HOOK + 1];
   ResourceIDs _resids[TS_HTTP_LAST_HOOK + 1];
+  RuleIndex _index[TS_HTTP_LAST_HOOK + 1];
 };
 
 // Helper function to add a rule to the rulesets
@@ -237,6 +244,11 @@ RulesConfig::parse_config(const std::string &fname, TSHttpHookID default_hook)
     }
   }
 
+  // Index the rules of each hook, including the remap pseudo hook
+  for (int i = TS_HTTP_READ_REQUEST_HDR_HOOK; i <= TS_HTTP_LAST_HOOK; ++i) { // lgtm[cpp/constant-comparison]
+    _index[i].build(_rules[i]);
+  }
+
   return true;
 }
 
@@ -279,23 +291,13 @@ cont_rewrite_headers(TSCont contp, TSEvent event, void *edata)
   }
 
   if (hook != TS_HTTP_LAST_HOOK) {
-    const RuleSet *rule = conf->rule(hook);
     Resources res(txnp, contp);
 
     // Get the resources necessary to process this event
     res.gather(conf->resid(hook), hook);
 
-    // Evaluation of all rules. This code is sort of duplicate in DoRemap as well.
-    while (rule) {
-      if (rule->eval(res)) {
-        OperModifiers rt = rule->exec(res);
-
-        if (rule->last() || (rt & OPER_LAST)) {
-          break; // Conditional break, force a break with [L]
-        }
-      }
-      rule = rule->next;
-    }
+    // Evaluation of the rules that can apply to this transaction.
+    conf->index(hook).run(res);
   }
 
   TSHttpTxnReenable(txnp, TS_EVENT_HTTP_CONTINUE);
@@ -505,23 +507,12 @@ TSRemapDoRemap(void *ih, TSHttpTxn rh, TSRemapRequestInfo *rri)
   // Now handle the remap specific rules for the "remap hook" (which is not a real hook).
   // This is sufficiently different than the normal cont_rewrite_headers() callback, and
   // we can't (shouldn't) schedule this as a TXN hook.
-  RuleSet *rule = conf->rule(TS_REMAP_PSEUDO_HOOK);
   Resources res(rh, rri);
 
   res.gather(RSRC_CLIENT_REQUEST_HEADERS, TS_REMAP_PSEUDO_HOOK);
-  while (rule) {
-    if (rule->eval(res)) {
-      OperModifiers rt = rule->exec(res);
-
-      if (res.changed_url == true) {
-        rval = TSREMAP_DID_REMAP;
-      }
-
-      if (rule->last() || (rt & OPER_LAST)) {
-        break; // Conditional break, force a break with [L]
-      }
-    }
-    rule = rule->next;
+  conf->index(TS_REMAP_PSEUDO_HOOK).run(res);
+  if (res.changed_url == true) {
+    rval = TSREMAP_DID_REMAP;
   }
 
   TSDebug(PLUGIN_NAME_DBG, "Returning from TSRemapDoRemap with status: %d", rval);
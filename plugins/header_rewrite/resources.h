@@ -22,6 +22,8 @@
 #pragma once
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "ts/ts.h"
 #include "ts/remap.h"
@@ -76,6 +78,10 @@ public:
   TSHttpStatus resp_status = TS_HTTP_STATUS_NONE;
   bool changed_url         = false;
 
+  // Condition values already read, by Condition::value_source(). Operators can change any of
+  // them, so this is cleared after a rule's operators run.
+  mutable std::vector<std::pair<std::string, std::string>> values;
+
 private:
   void destroy();
 
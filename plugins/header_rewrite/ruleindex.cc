@@ -0,0 +1,127 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+//////////////////////////////////////////////////////////////////////////////////////////////
+// ruleindex.cc: implementation of the rule index.
+//
+//
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+#include "ruleindex.h"
+
+void
+RuleIndex::build(const RuleSet *rules)
+{
+  std::map<std::string, size_t> counts;
+
+  _rules.clear();
+  _unkeyed.clear();
+  _keyed.clear();
+  _source.clear();
+  _key_cond = nullptr;
+
+  for (const RuleSet *rule = rules; rule; rule = rule->next) {
+    std::vector<std::string> sources;
+
+    for (auto c : rule->equality_conditions()) {
+      if (std::find(sources.begin(), sources.end(), c->value_source()) == sources.end()) {
+        sources.push_back(c->value_source());
+        ++counts[sources.back()];
+      }
+    }
+    _rules.push_back(rule);
+  }
+
+  for (auto const &[source, count] : counts) {
+    if (count >= MIN_INDEXED_RULES && (_source.empty() || count > counts[_source])) {
+      _source = source;
+    }
+  }
+
+  for (size_t i = 0; i < _rules.size(); ++i) {
+    const std::string *key = nullptr;
+
+    if (!_source.empty()) {
+      for (auto c : _rules[i]->equality_conditions()) {
+        if (c->value_source() == _source) {
+          key       = c->equal_to();
+          _key_cond = c;
+          break;
+        }
+      }
+    }
+    if (key) {
+      _keyed[*key].push_back(i);
+    } else {
+      _unkeyed.push_back(i);
+    }
+  }
+
+  // Each key also gets the rules that apply whatever the value is, in order.
+  for (auto &[key, positions] : _keyed) {
+    std::vector<int> merged;
+
+    std::merge(positions.begin(), positions.end(), _unkeyed.begin(), _unkeyed.end(), std::back_inserter(merged));
+    positions.swap(merged);
+  }
+
+  if (!_source.empty()) {
+    TSDebug(PLUGIN_NAME, "Indexed %zu of %zu rules on %s", _rules.size() - _unkeyed.size(), _rules.size(), _source.c_str());
+  }
+}
+
+const std::vector<int> &
+RuleIndex::select(const Resources &res) const
+{
+  if (_key_cond) {
+    if (auto spot = _keyed.find(_key_cond->source_value(res)); spot != _keyed.end()) {
+      return spot->second;
+    }
+  }
+
+  return _unkeyed;
+}
+
+void
+RuleIndex::run(const Resources &res) const
+{
+  const std::vector<int> *positions = &select(res);
+  size_t i                          = 0;
+
+  while (i < positions->size()) {
+    int at              = (*positions)[i];
+    const RuleSet *rule = _rules[at];
+
+    if (rule->eval(res)) {
+      OperModifiers rt = rule->exec(res);
+
+      // The operators may have changed what the conditions read, including the index key.
+      res.values.clear();
+      if (rule->last() || (rt & OPER_LAST)) {
+        break; // Conditional break, force a break with [L]
+      }
+      if (_key_cond) {
+        positions = &select(res);
+        i         = std::upper_bound(positions->begin(), positions->end(), at) - positions->begin();
+        continue;
+      }
+    }
+    ++i;
+  }
+}
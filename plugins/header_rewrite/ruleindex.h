@@ -0,0 +1,81 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+//////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Index over the rule sets of one hook, so a transaction only evaluates the rules that can apply.
+//
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ruleset.h"
+#include "resources.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// Most large configurations are a list of rules that each start with a test
+// like %{CLIENT-HEADER:Host} =www.example.com. The index picks the value that
+// most rules of the hook test for equality, and keeps, for each string they
+// compare it to, the rules that can apply when the value is that string. Rules
+// are always run in configuration order.
+//
+class RuleIndex
+{
+public:
+  // Fewer rules than this testing the same value are not worth indexing.
+  static const size_t MIN_INDEXED_RULES = 4;
+
+  RuleIndex() = default;
+
+  // noncopyable
+  RuleIndex(const RuleIndex &)      = delete;
+  void operator=(const RuleIndex &) = delete;
+
+  // (Re-)build the index for the linked list of rules.
+  void build(const RuleSet *rules);
+
+  // Evaluate the rules, and run the operators of those that match, until one is the last.
+  void run(const Resources &res) const;
+
+  bool
+  empty() const
+  {
+    return _rules.empty();
+  }
+
+  // The value source that this index is keyed on, empty if the rules are not indexed.
+  const std::string &
+  source() const
+  {
+    return _source;
+  }
+
+private:
+  // The positions of the rules that can apply for the current key value.
+  const std::vector<int> &select(const Resources &res) const;
+
+  // All the rules, in order. The lists below are positions in this.
+  std::vector<const RuleSet *> _rules;
+  // Rules that can apply whatever the value is, and for each value the rules that can apply.
+  std::vector<int> _unkeyed;
+  std::unordered_map<std::string, std::vector<int>> _keyed;
+
+  std::string _source;
+  Condition *_key_cond = nullptr; // Any condition reading _source
+};
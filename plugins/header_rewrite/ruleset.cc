@@ -59,6 +59,7 @@ RuleSet::add_condition(Parser &p, const char *filename, int lineno)
     } else {
       _cond->append(c);
     }
+    _conds.push_back(c);
 
     // Update some ruleset state based on this new condition
     _last |= c->last();
@@ -115,3 +116,20 @@ RuleSet::get_all_resource_ids() const
 
   return ids;
 }
+
+std::vector<Condition *>
+RuleSet::equality_conditions() const
+{
+  std::vector<Condition *> conds;
+
+  for (auto c : _conds) {
+    if (c->mods() & COND_OR) {
+      return {};
+    }
+    if (c->equal_to()) {
+      conds.push_back(c);
+    }
+  }
+
+  return conds;
+}
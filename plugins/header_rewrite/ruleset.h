@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "matcher.h"
 #include "factory.h"
@@ -85,14 +86,31 @@ public:
     return _ids;
   }
 
+  // The conditions, in order, that the rule requires to be equal to a fixed string. Empty unless
+  // the conditions are all AND'ed together.
+  std::vector<Condition *> equality_conditions() const;
+
+  // Walks the conditions in order: an AND stops at the first false condition, an OR at the
+  // first true one, and otherwise the last condition decides.
   bool
   eval(const Resources &res) const
   {
-    if (nullptr == _cond) {
-      return true;
-    } else {
-      return _cond->do_eval(res);
+    for (size_t i = 0, n = _conds.size(); i < n; ++i) {
+      bool rt = _conds[i]->test(res);
+
+      if (i + 1 == n) {
+        return rt;
+      }
+      if (_conds[i]->mods() & COND_OR) {
+        if (rt) {
+          return true;
+        }
+      } else if (!rt) {
+        return false;
+      }
     }
+
+    return true;
   }
 
   bool
@@ -114,6 +132,7 @@ private:
   Condition *_cond   = nullptr;                        // First pre-condition (linked list)
   Operator *_oper    = nullptr;                        // First operator (linked list)
   TSHttpHookID _hook = TS_HTTP_READ_RESPONSE_HDR_HOOK; // Which hook is this rule for
+  std::vector<Condition *> _conds;                     // The same pre-conditions, in an array for eval()
 
   // State values (updated when conds / operators are added)
   ResourceIDs _ids        = RSRC_NONE;
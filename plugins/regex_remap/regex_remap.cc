@@ -37,12 +37,14 @@
 #include <cctype>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 // Get some specific stuff from libts, yes, we can do that now that we build inside the core.
 #include "tscore/ink_platform.h"
 #include "tscore/ink_atomic.h"
 #include "tscore/ink_time.h"
 #include "tscore/ink_inet.h"
+#include "tscore/Regex.h"
 
 #ifdef HAVE_PCRE_PCRE_H
 #include <pcre/pcre.h>
@@ -636,6 +638,8 @@ struct RemapInstance {
   int misses         = 0;
   int failures       = 0;
   std::string filename;
+  std::vector<RemapRegex *> rules; // The same rules as the list, for indexing by the prefilter.
+  RegexPrefilter prefilter;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -817,6 +821,8 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char * /* errbuf ATS_UNUSE
         ri->last->set_next(cur.release());
       }
       ri->last = tmp;
+      ri->rules.push_back(tmp);
+      ri->prefilter.add(tmp->regex());
     }
   }
 
@@ -825,6 +831,7 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char * /* errbuf ATS_UNUSE
     TSError("[%s] no regular expressions from the maps", PLUGIN_NAME);
     return TS_ERROR;
   }
+  ri->prefilter.build();
 
   return TS_SUCCESS;
 }
@@ -928,8 +935,7 @@ TSRemapDoRemap(void *ih, TSHttpTxn txnp, TSRemapRequestInfo *rri)
   int ovector[OVECCOUNT];
   int lengths[OVECCOUNT / 2 + 1];
   int dest_len;
-  TSRemapStatus retval = TSREMAP_DID_REMAP;
-  RemapRegex *re       = ri->first;
+  TSRemapStatus retval = TSREMAP_NO_REMAP;
   int match_len        = 0;
   char *match_buf;
 
@@ -979,8 +985,14 @@ TSRemapDoRemap(void *ih, TSHttpTxn txnp, TSRemapRequestInfo *rri)
   match_buf[match_len] = '\0'; // NULL terminate the match string
   TSDebug(PLUGIN_NAME, "Target match string is `%s'", match_buf);
 
+  // Only the rules whose required literal appears in the match string can match it.
+  thread_local std::vector<int> candidates;
+  ri->prefilter.candidates(std::string_view(match_buf, match_len), candidates);
+
   // Apply the regular expressions, in order. First one wins.
-  while (re) {
+  for (int ix : candidates) {
+    RemapRegex *re = ri->rules[ix];
+
     // Since we check substitutions on parse time, we don't need to reset ovector
     auto match_result = re->match(match_buf, match_len, ovector);
     if (match_result >= 0) {
@@ -1040,6 +1052,8 @@ TSRemapDoRemap(void *ih, TSHttpTxn txnp, TSRemapRequestInfo *rri)
       if (new_len > 0) {
         char *dest;
 
+        retval = TSREMAP_DID_REMAP;
+
         dest     = static_cast<char *>(alloca(new_len + 8));
         dest_len = re->substitute(dest, match_buf, ovector, lengths, txnp, rri, &req_url, lowercase_substitutions);
 
@@ -1079,15 +1093,10 @@ TSRemapDoRemap(void *ih, TSHttpTxn txnp, TSRemapRequestInfo *rri)
       TSError(R"([%s] Bad regular expression result %d from "%s" in file "%s".)", PLUGIN_NAME, match_result, re->regex(),
               ri->filename.c_str());
     }
+  }
 
-    // Try the next regex
-    re = re->next();
-    if (re == nullptr) {
-      retval = TSREMAP_NO_REMAP; // No match
-      if (ri->profile) {
-        ink_atomic_increment(&(ri->misses), 1);
-      }
-    }
+  if (retval == TSREMAP_NO_REMAP && ri->profile) {
+    ink_atomic_increment(&(ri->misses), 1);
   }
 
   return retval;
@@ -29,6 +29,9 @@
  ****************************************************************************/
 
 #include <sys/types.h>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "tscore/ink_config.h"
 #include "tscore/Filenames.h"
@@ -41,6 +44,7 @@
 #include "HttpConfig.h"
 #include "P_Cache.h"
 #include "tscore/Regex.h"
+#include "tscore/Regression.h"
 
 static const char modulePrefix[] = "[CacheControl]";
 
@@ -441,3 +445,138 @@ CacheControlRecord::UpdateMatch(CacheControlResult *result, RequestData *rdata)
     Debug("cache_control", "Matched with for %s at line %d%s", CC_directive_str[this->directive], this->line_num, crtc_debug);
   }
 }
+
+/*-------------------------------------------------------------------------
+  Regression test: lookups in a large, generated cache.config
+  -------------------------------------------------------------------------*/
+
+namespace
+{
+// Rule i matches the request for target i, and only that one. Each rule sets a
+// different ttl, so the result tells which rule matched.
+void
+cc_test_rule(std::string &tbl, int i)
+{
+  std::string n = std::to_string(i);
+
+  switch (i % 3) {
+  case 0:
+    tbl += "dest_domain=d" + n + ".example.com";
+    break;
+  case 1:
+    tbl += "url_regex=^http://r" + n + "\\.example\\.com/img/";
+    break;
+  default:
+    tbl += "host_regex=^h" + n + "\\.example\\.(com|net)$";
+    break;
+  }
+  tbl += " ttl-in-cache=" + std::to_string(i + 1) + "s\n";
+}
+
+struct CCTestRequest {
+  explicit CCTestRequest(int target)
+  {
+    static const char *const prefix[] = {"d", "r", "h"};
+
+    host = std::string(prefix[target % 3]) + std::to_string(target) + (target % 3 == 2 ? ".example.net" : ".example.com");
+    std::string req = "GET http://" + host + "/img/logo.png HTTP/1.1\r\nHost: " + host + "\r\n\r\n";
+
+    HTTPParser parser;
+    const char *start = req.data();
+    http_parser_init(&parser);
+    hdr.create(HTTP_TYPE_REQUEST);
+    hdr.parse_req(&parser, &start, start + req.size(), true);
+    http_parser_clear(&parser);
+
+    data.hdr          = &hdr;
+    data.hostname_str = host.c_str();
+  }
+
+  ~CCTestRequest() { hdr.destroy(); }
+
+  std::string host;
+  HTTPHdr hdr;
+  HttpRequestData data;
+};
+} // namespace
+
+REGRESSION_TEST(CacheControl_large_table)(RegressionTest *t, int level, int *pstatus)
+{
+  std::vector<int> sizes{100, 1000};
+  int const lookups = 2000;
+  *pstatus          = REGRESSION_TEST_PASSED;
+
+  if (level >= REGRESSION_TEST_NIGHTLY) {
+    sizes.push_back(10000);
+  }
+
+  for (int size : sizes) {
+    std::string tbl;
+    for (int i = 0; i < size; ++i) {
+      cc_test_rule(tbl, i);
+    }
+    // Matches every request, but only applies to POST.
+    tbl += "dest_domain=example.com method=POST action=never-cache\n";
+
+    CC_table table("", "CacheControl large table test", &http_dest_tags,
+                   ALLOW_HOST_TABLE | ALLOW_REGEX_TABLE | ALLOW_HOST_REGEX_TABLE | ALLOW_IP_TABLE | DONT_BUILD_TABLE);
+    table.BuildTableFromString(tbl.data());
+
+    // Every third target has no rule, since the table only has targets below size.
+    std::vector<std::unique_ptr<CCTestRequest>> requests;
+    for (int i = 0; i < 64; ++i) {
+      requests.emplace_back(new CCTestRequest((i * 7919) % (size + size / 2)));
+    }
+
+    for (auto &req : requests) {
+      int target = std::stoi(req->host.substr(1));
+      int ttl    = target < size ? target + 1 : CC_UNSET_TIME;
+
+      for (int pass = 0; pass < 2; ++pass) {
+        CacheControlResult result;
+        table.Match(&req->data, &result);
+        if (result.ttl_in_cache != ttl || result.never_cache) {
+          rprintf(t, "%d rules, %s pass %d: ttl %d never-cache %d, expected ttl %d\n", size, req->host.c_str(), pass,
+                  result.ttl_in_cache, result.never_cache, ttl);
+          *pstatus = REGRESSION_TEST_FAILED;
+        }
+      }
+    }
+
+    // A request only the method=POST rule matches, looked up again after its method changes.
+    CCTestRequest post(3 * size);
+    for (int pass = 0; pass < 2; ++pass) {
+      CacheControlResult result;
+      table.Match(&post.data, &result);
+      if (result.never_cache != (pass == 1)) {
+        rprintf(t, "%d rules, %s pass %d: never-cache %d, modifier not evaluated again\n", size, post.host.c_str(), pass,
+                result.never_cache);
+        *pstatus = REGRESSION_TEST_FAILED;
+      }
+      post.hdr.method_set(HTTP_METHOD_POST, HTTP_LEN_POST);
+    }
+
+    // Lookups of requests not seen before search the table.
+    ink_hrtime start = Thread::get_hrtime_updated();
+    for (int i = 0; i < lookups; ++i) {
+      CCTestRequest &req = *requests[i % requests.size()];
+      HttpRequestData data;
+      data.hdr          = req.data.hdr;
+      data.hostname_str = req.data.hostname_str;
+      CacheControlResult result;
+      table.Match(&data, &result);
+    }
+    ink_hrtime first = Thread::get_hrtime_updated() - start;
+
+    // Lookups repeated within a transaction are answered from the memo.
+    start = Thread::get_hrtime_updated();
+    for (int i = 0; i < lookups; ++i) {
+      CacheControlResult result;
+      table.Match(&requests[i % requests.size()]->data, &result);
+    }
+    ink_hrtime repeated = Thread::get_hrtime_updated() - start;
+
+    rprintf(t, "%d rules: %" PRId64 " ns per lookup, %" PRId64 " ns per repeated lookup\n", size, first / lookups,
+            repeated / lookups);
+  }
+}
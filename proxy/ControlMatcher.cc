@@ -37,6 +37,10 @@
 #include "tscore/Tokenizer.h"
 #include "tscore/ts_file.h"
 #include "ConfigProcessor.h"
+#include <atomic>
+#include <functional>
+#include <string_view>
+
 #include "ControlMatcher.h"
 #include "CacheControl.h"
 #include "ParentSelection.h"
@@ -84,6 +88,66 @@ HttpRequestData::get_client_ip()
   return &src_ip.sa;
 }
 
+/*************************************************************
+ *   Begin class ControlMatcherMemo
+ *************************************************************/
+
+bool
+ControlMatcherMemo::Key::operator==(Key const &that) const
+{
+  return table_id == that.table_id && url_hash == that.url_hash && url_len == that.url_len && host_hash == that.host_hash &&
+         ip == that.ip;
+}
+
+const ControlMatcherMemo::Lookup *
+ControlMatcherMemo::find(Key const &key) const
+{
+  for (auto const &lookup : _lookups) {
+    if (lookup.key.table_id != 0 && lookup.key == key) {
+      return &lookup;
+    }
+  }
+  return nullptr;
+}
+
+void
+ControlMatcherMemo::record_start(Key const &key)
+{
+  ink_assert(_recording < 0);
+
+  // The slot does not hold a lookup until it is complete
+  _recording                     = _next;
+  _next                          = (_next + 1) % MAX_LOOKUPS;
+  _recording_key                 = key;
+  _overflow                      = false;
+  _lookups[_recording].key       = Key();
+  _lookups[_recording].n_matches = 0;
+}
+
+void
+ControlMatcherMemo::record(void *data)
+{
+  if (_recording < 0) {
+    return;
+  }
+
+  Lookup &lookup = _lookups[_recording];
+  if (lookup.n_matches < MAX_MATCHES) {
+    lookup.matches[lookup.n_matches++] = data;
+  } else {
+    _overflow = true;
+  }
+}
+
+void
+ControlMatcherMemo::record_end()
+{
+  if (_recording >= 0 && !_overflow) {
+    _lookups[_recording].key = _recording_key;
+  }
+  _recording = -1;
+}
+
 /*************************************************************
  *   Begin class HostMatcher
  *************************************************************/
@@ -171,7 +235,7 @@ HostMatcher<Data, MatchResult>::Match(RequestData *rdata, MatchResult *result) c
   while (r == true) {
     ink_assert(opaque_ptr != nullptr);
     data_ptr = (Data *)opaque_ptr;
-    data_ptr->UpdateMatch(result, rdata);
+    this->update_match(data_ptr, result, rdata);
 
     r = host_lookup->MatchNext(&s, &opaque_ptr);
   }
@@ -339,28 +403,33 @@ template <class Data, class MatchResult>
 void
 UrlMatcher<Data, MatchResult>::Match(RequestData *rdata, MatchResult *result) const
 {
-  char *url_str;
-
   // Check to see there is any work to before we copy the
   //   URL
   if (num_el <= 0) {
     return;
   }
 
-  url_str = rdata->get_string();
+  ats_scoped_str url_str(rdata->get_string());
+  this->Match(url_str ? url_str.get() : "", rdata, result);
+}
 
-  // Can't do a regex match with a NULL string so
-  //  use an empty one instead
-  if (url_str == nullptr) {
-    url_str = ats_strdup("");
+//
+// void UrlMatcher<Data,MatchResult>::Match(const char* url_str, RD* rdata, MatchResult* result)
+//
+//   As above, for a URL string already taken from arg rdata
+//
+template <class Data, class MatchResult>
+void
+UrlMatcher<Data, MatchResult>::Match(const char *url_str, RequestData *rdata, MatchResult *result) const
+{
+  if (num_el <= 0) {
+    return;
   }
 
   if (auto it = url_ht.find(url_str); it != url_ht.end()) {
     Debug("matcher", "%s Matched %s with url at line %d", matcher_name, url_str, data_array[it->second].line_num);
-    data_array[it->second].UpdateMatch(result, rdata);
+    this->update_match(data_array + it->second, result, rdata);
   }
-
-  ats_free(url_str);
 }
 
 //
@@ -470,12 +539,30 @@ RegexMatcher<Data, MatchResult>::NewEntry(matcher_line *line_info)
     pcre_free(re_array[num_el]);
     re_array[num_el] = nullptr;
   } else {
+    prefilter.add(pattern);
     num_el++;
   }
 
   return error;
 }
 
+//
+// void RegexMatcher<Data,MatchResult>::Compile()
+//
+//   Builds the prefilter over the regexs added, if there are enough of
+//     them that executing each one for every request is costly
+//
+template <class Data, class MatchResult>
+void
+RegexMatcher<Data, MatchResult>::Compile()
+{
+  if (num_el >= PREFILTER_MIN_ENTRIES) {
+    prefilter.build();
+  } else {
+    prefilter = RegexPrefilter();
+  }
+}
+
 //
 // void RegexMatcher<Data,MatchResult>::Match(RequestData* rdata, MatchResult* result)
 //
@@ -486,38 +573,70 @@ template <class Data, class MatchResult>
 void
 RegexMatcher<Data, MatchResult>::Match(RequestData *rdata, MatchResult *result) const
 {
-  char *url_str;
-  int r;
-
   // Check to see there is any work to before we copy the
   //   URL
   if (num_el <= 0) {
     return;
   }
 
-  url_str = rdata->get_string();
-
-  // Can't do a regex match with a NULL string so
-  //  use an empty one instead
-  if (url_str == nullptr) {
-    url_str = ats_strdup("");
-  }
+  ats_scoped_str url_str(rdata->get_string());
+  this->Match(url_str ? url_str.get() : "", rdata, result);
+}
 
+//
+// void RegexMatcher<Data,MatchResult>::Match(const char* url_str, RequestData* rdata, MatchResult* result)
+//
+//   As above, for a URL string already taken from arg rdata
+//
+template <class Data, class MatchResult>
+void
+RegexMatcher<Data, MatchResult>::Match(const char *url_str, RequestData *rdata, MatchResult *result) const
+{
   // INKqa12980
   // The function unescapifyStr() is already called in
   // HttpRequestData::get_string(); therefore, no need to call again here.
+  this->MatchString(url_str, rdata, result);
+}
 
-  for (int i = 0; i < num_el; i++) {
-    r = pcre_exec(re_array[i], nullptr, url_str, strlen(url_str), 0, 0, nullptr, 0);
+//
+// void RegexMatcher<Data,MatchResult>::MatchString(const char* str, RequestData* rdata, MatchResult* result)
+//
+//   Executes the regexs that could match arg str, which is all of
+//     them unless the table has a prefilter, and updates arg result
+//     for each regex that matches
+//
+template <class Data, class MatchResult>
+void
+RegexMatcher<Data, MatchResult>::MatchString(const char *str, RequestData *rdata, MatchResult *result) const
+{
+  if (num_el <= 0) {
+    return;
+  }
+
+  int len    = strlen(str);
+  auto match = [&](int i) -> void {
+    int r = pcre_exec(re_array[i], nullptr, str, len, 0, 0, nullptr, 0);
     if (r > -1) {
-      Debug("matcher", "%s Matched %s with regex at line %d", matcher_name, url_str, data_array[i].line_num);
-      data_array[i].UpdateMatch(result, rdata);
+      Debug("matcher", "%s Matched %s with regex at line %d", matcher_name, str, data_array[i].line_num);
+      this->update_match(data_array + i, result, rdata);
     } else if (r < -1) {
       // An error has occurred
       Warning("Error [%d] matching regex at line %d.", r, data_array[i].line_num);
     } // else it's -1 which means no match was found.
+  };
+
+  if (prefilter.size() > 0) {
+    thread_local std::vector<int> candidates;
+
+    prefilter.candidates(std::string_view(str, len), candidates);
+    for (int i : candidates) {
+      match(i);
+    }
+  } else {
+    for (int i = 0; i < num_el; i++) {
+      match(i);
+    }
   }
-  ats_free(url_str);
 }
 
 //
@@ -539,33 +658,11 @@ template <class Data, class MatchResult>
 void
 HostRegexMatcher<Data, MatchResult>::Match(RequestData *rdata, MatchResult *result) const
 {
-  const char *url_str;
-  int r;
-
-  // Check to see there is any work to before we copy the
-  //   URL
-  if (this->num_el <= 0) {
-    return;
-  }
-
-  url_str = rdata->get_host();
+  const char *host_str = rdata->get_host();
 
   // Can't do a regex match with a NULL string so
   //  use an empty one instead
-  if (url_str == nullptr) {
-    url_str = "";
-  }
-  for (int i = 0; i < this->num_el; i++) {
-    r = pcre_exec(this->re_array[i], nullptr, url_str, strlen(url_str), 0, 0, nullptr, 0);
-    if (r != -1) {
-      Debug("matcher", "%s Matched %s with regex at line %d", const_cast<char *>(this->matcher_name), url_str,
-            this->data_array[i].line_num);
-      this->data_array[i].UpdateMatch(result, rdata);
-    } else {
-      // An error has occurred
-      Warning("error matching regex at line %d", this->data_array[i].line_num);
-    }
-  }
+  this->MatchString(host_str ? host_str : "", rdata, result);
 }
 
 //
@@ -653,7 +750,7 @@ IpMatcher<Data, MatchResult>::Match(sockaddr const *addr, RequestData *rdata, Ma
 {
   if (auto &&[range, data]{*ip_addrs.find(swoc::IPAddr(addr))}; !range.empty()) {
     ink_assert(data != nullptr);
-    data->UpdateMatch(result, rdata);
+    this->update_match(data, result, rdata);
   }
 }
 
@@ -672,7 +769,10 @@ IpMatcher<Data, MatchResult>::Print() const
 template <class Data, class MatchResult>
 ControlMatcher<Data, MatchResult>::ControlMatcher(const char *file_var, const char *name, const matcher_tags *tags, int flags_in)
 {
-  flags = flags_in;
+  static std::atomic<uint64_t> next_table_id{1};
+
+  flags    = flags_in;
+  table_id = next_table_id++;
   ink_assert(flags & (ALLOW_HOST_TABLE | ALLOW_REGEX_TABLE | ALLOW_URL_TABLE | ALLOW_IP_TABLE));
 
   config_tags = tags;
@@ -739,20 +839,59 @@ ControlMatcher<Data, MatchResult>::Print() const
 // void ControlMatcher<Data, MatchResult>::Match(RequestData* rdata
 //                                          MatchResult* result) const
 //
-//   Queries each table for the MatchResult*
+//   Queries each table for the MatchResult*.  If arg rdata has a
+//     ControlMatcherMemo, the entries that matched are remembered there
+//     and a later lookup with the same keys only applies them again
 //
 template <class Data, class MatchResult>
 void
 ControlMatcher<Data, MatchResult>::Match(RequestData *rdata, MatchResult *result) const
 {
+  ControlMatcherMemo *memo = rdata->get_match_memo();
+  ats_scoped_str url_str;
+
+  // The regex and URL tables share one copy of the URL
+  if (reMatch != nullptr || urlMatch != nullptr) {
+    url_str = rdata->get_string();
+    if (!url_str) {
+      url_str = ats_strdup("");
+    }
+  }
+
+  if (memo != nullptr) {
+    ControlMatcherMemo::Key key;
+
+    key.table_id = table_id;
+    if (url_str) {
+      std::string_view url{url_str.get()};
+      key.url_hash = std::hash<std::string_view>{}(url);
+      key.url_len  = url.size();
+    }
+    if (hostMatch != nullptr || hrMatch != nullptr) {
+      const char *host = rdata->get_host();
+      key.host_hash    = std::hash<std::string_view>{}(host ? host : "");
+    }
+    if (ipMatch != nullptr) {
+      key.ip = swoc::IPAddr(rdata->get_ip());
+    }
+
+    if (const ControlMatcherMemo::Lookup *lookup = memo->find(key); lookup != nullptr) {
+      for (int i = 0; i < lookup->n_matches; ++i) {
+        static_cast<Data *>(lookup->matches[i])->UpdateMatch(result, rdata);
+      }
+      return;
+    }
+    memo->record_start(key);
+  }
+
   if (hostMatch != nullptr) {
     hostMatch->Match(rdata, result);
   }
   if (reMatch != nullptr) {
-    reMatch->Match(rdata, result);
+    reMatch->Match(url_str, rdata, result);
   }
   if (urlMatch != nullptr) {
-    urlMatch->Match(rdata, result);
+    urlMatch->Match(url_str, rdata, result);
   }
   if (ipMatch != nullptr) {
     ipMatch->Match(rdata->get_ip(), rdata, result);
@@ -760,6 +899,10 @@ ControlMatcher<Data, MatchResult>::Match(RequestData *rdata, MatchResult *result
   if (hrMatch != nullptr) {
     hrMatch->Match(rdata, result);
   }
+
+  if (memo != nullptr) {
+    memo->record_end();
+  }
 }
 
 // int ControlMatcher::BuildTable()
@@ -923,6 +1066,13 @@ ControlMatcher<Data, MatchResult>::BuildTableFromString(char *file_buf)
 
   ink_assert(second_pass == numEntries);
 
+  if (reMatch != nullptr) {
+    reMatch->Compile();
+  }
+  if (hrMatch != nullptr) {
+    hrMatch->Compile();
+  }
+
   if (is_debug_tag_set("matcher")) {
     Print();
   }
@@ -54,8 +54,10 @@
  *  Lookup Table Descriptions
  *  -------------------------
  *
- *   regex table - implemented as a linear list of regular expressions to
- *       match against
+ *   regex table - implemented as a list of regular expressions to match
+ *       against.  Large tables are searched once for the literals the
+ *       expressions require (RegexPrefilter) and only the expressions
+ *       whose literal was found are executed
  *
  *   host/domain table - The host domain table is logically implemented as
  *       tree, broken up at each partition in a hostname.  Three mechanism
@@ -86,6 +88,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 
 #include "tscore/Result.h"
@@ -108,6 +111,53 @@ struct HttpApiInfo;
 struct matcher_line;
 struct matcher_tags;
 
+/** Remembers which entries of a ControlMatcher table matched a request, so that looking the same
+ * request up in the same table again does not search the table again.
+ *
+ * Only the entries are remembered. Their UpdateMatch() is still called on every lookup, so anything
+ * they check besides the lookup keys, such as modifiers, is evaluated again.
+ */
+class ControlMatcherMemo
+{
+public:
+  static constexpr int MAX_LOOKUPS = 4; ///< Lookups remembered, the oldest is replaced first.
+  static constexpr int MAX_MATCHES = 8; ///< Lookups matching more entries are not remembered.
+
+  /// The lookup keys, limited to the ones the table uses.
+  struct Key {
+    uint64_t table_id  = 0; ///< ControlMatcher::table_id, 0 for none.
+    uint64_t url_hash  = 0;
+    size_t url_len     = 0;
+    uint64_t host_hash = 0;
+    swoc::IPAddr ip;
+
+    bool operator==(Key const &that) const;
+  };
+
+  struct Lookup {
+    Key key;
+    int n_matches = 0;
+    void *matches[MAX_MATCHES];
+  };
+
+  /// @return The entries that matched @a key, in the order they matched, or @c nullptr.
+  const Lookup *find(Key const &key) const;
+
+  /// Start remembering the entries that match @a key.
+  void record_start(Key const &key);
+  /// Remember that @a data matched, if a lookup is being recorded.
+  void record(void *data);
+  /// Finish the lookup started by record_start().
+  void record_end();
+
+private:
+  Lookup _lookups[MAX_LOOKUPS];
+  Key _recording_key;
+  int _next      = 0;  ///< Slot the next lookup goes in.
+  int _recording = -1; ///< Slot being recorded, -1 if none.
+  bool _overflow = false;
+};
+
 struct RequestData {
 public:
   // First three are the lookup keys to the tables
@@ -120,6 +170,13 @@ public:
   virtual sockaddr const *get_ip() = 0;
 
   virtual sockaddr const *get_client_ip() = 0;
+
+  /// @return Where lookups for this request are remembered, or @c nullptr to not remember them.
+  virtual ControlMatcherMemo *
+  get_match_memo()
+  {
+    return nullptr;
+  }
 };
 
 class HttpRequestData : public RequestData
@@ -130,6 +187,12 @@ public:
   sockaddr const *get_ip() override;
   sockaddr const *get_client_ip() override;
 
+  ControlMatcherMemo *
+  get_match_memo() override
+  {
+    return &match_memo;
+  }
+
   HttpRequestData()
 
   {
@@ -148,6 +211,7 @@ public:
   bool internal_txn                     = false;
   URL **cache_info_lookup_url           = nullptr;
   URL **cache_info_parent_selection_url = nullptr;
+  ControlMatcherMemo match_memo;
 };
 
 // Mixin class for shared info across all templates. This just wraps the
@@ -162,6 +226,17 @@ public:
   ~BaseMatcher() { delete[] data_array; }
 
 protected:
+  // Apply a matching entry, remembering it if the lookup is being memoized
+  template <class MatchResult>
+  static void
+  update_match(Data *data, MatchResult *result, RequestData *rdata)
+  {
+    if (ControlMatcherMemo *memo = rdata->get_match_memo(); memo != nullptr) {
+      memo->record(data);
+    }
+    data->UpdateMatch(result, rdata);
+  }
+
   int num_el               = -1;        // number of elements in the table
   const char *matcher_name = "unknown"; // Used for Debug/Warning/Error messages
   const char *file_name    = nullptr;   // Used for Debug/Warning/Error messages
@@ -181,6 +256,7 @@ public:
   Result NewEntry(matcher_line *line_info);
 
   void Match(RequestData *rdata, MatchResult *result) const;
+  void Match(const char *url_str, RequestData *rdata, MatchResult *result) const;
   void Print() const;
 
   using super::num_el;
@@ -205,8 +281,11 @@ public:
 
   void AllocateSpace(int num_entries);
   Result NewEntry(matcher_line *line_info);
+  // Called once all the entries have been added
+  void Compile();
 
   void Match(RequestData *rdata, MatchResult *result) const;
+  void Match(const char *url_str, RequestData *rdata, MatchResult *result) const;
   void Print() const;
 
   using super::num_el;
@@ -216,8 +295,15 @@ public:
   using super::array_len;
 
 protected:
+  // Apply the entries whose regex matches str
+  void MatchString(const char *str, RequestData *rdata, MatchResult *result) const;
+
+  // Tables smaller than this are searched without the prefilter
+  static constexpr int PREFILTER_MIN_ENTRIES = 16;
+
   pcre **re_array = nullptr; // array of compiled regexs
   char **re_str   = nullptr; // array of uncompiled regex strings
+  RegexPrefilter prefilter;  // literals required by the regexs, if the table is large
 };
 
 template <class Data, class MatchResult> class HostRegexMatcher : public RegexMatcher<Data, MatchResult>
@@ -348,4 +434,5 @@ public:
   int flags                = 0;
   int m_numEntries         = 0;
   const char *matcher_name = "unknown"; // Used for Debug/Warning/Error messages
+  uint64_t table_id        = 0;         // Unique to this table, keys its lookups in ControlMatcherMemo
 };
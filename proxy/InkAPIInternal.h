@@ -155,6 +155,8 @@ APIHooks::is_empty() const
 
     @note The minimum value for a hook ID is zero. Therefore the template parameter @a N_ID should be one more than the
     maximum hook ID so the valid ids are 0..(N-1) in the standard C array style.
+
+    Which ids have hooks is also kept as a bit mask, so checking for hooks at an id is one load and test.
  */
 template <typename ID, ///< Type of hook ID
           int N        ///< Number of hooks
@@ -191,7 +193,9 @@ public:
   APIHooks const *operator[](ID id) const;
 
 private:
-  bool m_hooks_p = false; ///< Flag for (not) empty container.
+  static_assert(N <= 64, "hook ids must fit in the mask");
+
+  uint64_t m_hooks_mask = 0; ///< Bit @c id is set if the list for @c id is not empty.
   /// The array of hooks lists.
   APIHooks m_hooks[N];
 };
@@ -213,14 +217,10 @@ template <typename ID, int N>
 void
 FeatureAPIHooks<ID, N>::clear()
 {
-  if (m_hooks_p) {
-    for (auto &h : m_hooks) {
-      if (!h.is_empty()) {
-        h.clear();
-      }
-    }
-    m_hooks_p = false;
+  for (uint64_t mask = m_hooks_mask; mask; mask &= mask - 1) {
+    m_hooks[__builtin_ctzll(mask)].clear();
   }
+  m_hooks_mask = 0;
 }
 
 template <typename ID, int N>
@@ -228,7 +228,7 @@ void
 FeatureAPIHooks<ID, N>::append(ID id, INKContInternal *cont)
 {
   if (is_valid(id)) {
-    m_hooks_p = true;
+    m_hooks_mask |= uint64_t(1) << id;
     m_hooks[id].append(cont);
   }
 }
@@ -260,7 +260,14 @@ template <typename ID, int N>
 bool
 FeatureAPIHooks<ID, N>::has_hooks() const
 {
-  return m_hooks_p;
+  return m_hooks_mask != 0;
+}
+
+template <typename ID, int N>
+bool
+FeatureAPIHooks<ID, N>::has_hooks_for(ID id) const
+{
+  return likely(is_valid(id)) && (m_hooks_mask & (uint64_t(1) << id)) != 0;
 }
 
 template <typename ID, int N>
@@ -370,6 +377,9 @@ public:
   /// Temporary function to return true. Later will be used to decide if a plugin is enabled for the hooks
   bool is_enabled();
 
+  /// @return @c true if there are no hooks for the id in any of the scopes.
+  bool is_empty() const;
+
 protected:
   /// Track the state of one scope of hooks.
   struct Scope {
@@ -389,9 +399,10 @@ protected:
 
 private:
   TSHttpHookID _id;
-  Scope _global; ///< Chain from global hooks.
-  Scope _ssn;    ///< Chain from session hooks.
-  Scope _txn;    ///< Chain from transaction hooks.
+  bool _empty = true; ///< No scope has hooks for @a _id, so the scopes are not walked.
+  Scope _global;      ///< Chain from global hooks.
+  Scope _ssn;         ///< Chain from session hooks.
+  Scope _txn;         ///< Chain from transaction hooks.
 };
 
 inline TSHttpHookID
@@ -400,6 +411,12 @@ HttpHookState::id() const
   return _id;
 }
 
+inline bool
+HttpHookState::is_empty() const
+{
+  return _empty;
+}
+
 void api_init();
 
 extern HttpAPIHooks *http_global_hooks;
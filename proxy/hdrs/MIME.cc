@@ -30,6 +30,9 @@
 #include <cstring>
 #include <cctype>
 #include <algorithm>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 #include "MIME.h"
 #include "HdrHeap.h"
 #include "HdrToken.h"
@@ -2521,6 +2524,84 @@ mime_parser_clear(MIMEParser *parser)
   _mime_parser_init(parser);
 }
 
+namespace
+{
+using FindControlFunc = const char *(*)(const char *, const char *);
+
+const char *
+find_control_scalar(const char *s, const char *e)
+{
+  while (s < e && !ParseRules::is_control(*s)) {
+    ++s;
+  }
+  return s;
+}
+
+#if defined(__SSE2__)
+// ParseRules::is_control is every byte up to 0x1f except tab, plus DEL. Bytes are compared
+// unsigned, so min(v, 0x1f) == v holds exactly for v <= 0x1f.
+const char *
+find_control_sse2(const char *s, const char *e)
+{
+  const __m128i c_us  = _mm_set1_epi8(0x1f);
+  const __m128i c_tab = _mm_set1_epi8('\t');
+  const __m128i c_del = _mm_set1_epi8(0x7f);
+
+  for (; e - s >= 16; s += 16) {
+    __m128i v   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+    __m128i ctl = _mm_cmpeq_epi8(_mm_min_epu8(v, c_us), v);
+    ctl         = _mm_andnot_si128(_mm_cmpeq_epi8(v, c_tab), ctl);
+    ctl         = _mm_or_si128(ctl, _mm_cmpeq_epi8(v, c_del));
+    if (int mask = _mm_movemask_epi8(ctl); mask != 0) {
+      return s + __builtin_ctz(mask);
+    }
+  }
+  return find_control_scalar(s, e);
+}
+
+__attribute__((target("avx2"))) const char *
+find_control_avx2(const char *s, const char *e)
+{
+  const __m256i c_us  = _mm256_set1_epi8(0x1f);
+  const __m256i c_tab = _mm256_set1_epi8('\t');
+  const __m256i c_del = _mm256_set1_epi8(0x7f);
+
+  for (; e - s >= 32; s += 32) {
+    __m256i v   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+    __m256i ctl = _mm256_cmpeq_epi8(_mm256_min_epu8(v, c_us), v);
+    ctl         = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, c_tab), ctl);
+    ctl         = _mm256_or_si256(ctl, _mm256_cmpeq_epi8(v, c_del));
+    if (unsigned mask = _mm256_movemask_epi8(ctl); mask != 0) {
+      return s + __builtin_ctz(mask);
+    }
+  }
+  return find_control_sse2(s, e);
+}
+#endif
+
+FindControlFunc
+select_find_control()
+{
+#if defined(__SSE2__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return find_control_avx2;
+  }
+  return find_control_sse2;
+#else
+  return find_control_scalar;
+#endif
+}
+
+const FindControlFunc find_control = select_find_control();
+} // namespace
+
+const char *
+mime_find_control(const char *s, const char *e)
+{
+  return find_control(s, e);
+}
+
 ParseResult
 mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char **real_s, const char *real_e,
                   bool must_copy_strings, bool eof, bool remove_ws_from_field_name, size_t max_hdr_field_size)
@@ -2623,19 +2704,13 @@ mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char
 
     int field_name_wks_idx = hdrtoken_tokenize(field_name.data(), field_name.size());
 
-    if (field_name_wks_idx < 0) {
-      for (auto i : field_name) {
-        if (ParseRules::is_control(i)) {
-          return PARSE_RESULT_ERROR;
-        }
-      }
+    if (field_name_wks_idx < 0 && mime_find_control(field_name.data(), field_name.data_end()) != field_name.data_end()) {
+      return PARSE_RESULT_ERROR;
     }
 
     // RFC 9110 Section 5.5. Field Values
-    for (char i : field_value) {
-      if (ParseRules::is_control(i)) {
-        return PARSE_RESULT_ERROR;
-      }
+    if (mime_find_control(field_value.data(), field_value.data_end()) != field_value.data_end()) {
+      return PARSE_RESULT_ERROR;
     }
 
     ///////////////////////////////////////////
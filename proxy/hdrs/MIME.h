@@ -895,6 +895,12 @@ void mime_field_name_value_set(HdrHeap *heap, MIMEHdrImpl *mh, MIMEField *field,
 void mime_field_value_append(HdrHeap *heap, MIMEHdrImpl *mh, MIMEField *field, const char *value, int length, bool prepend_comma,
                              const char separator);
 
+/** Find the first control character, as defined by @c ParseRules::is_control, in [@a s, @a e).
+    The input is checked 16 or 32 bytes at a time where the CPU supports it.
+    @return The control character, or @a e if there is none.
+ */
+const char *mime_find_control(const char *s, const char *e);
+
 void mime_parser_init(MIMEParser *parser);
 void mime_parser_clear(MIMEParser *parser);
 ParseResult mime_parser_parse(MIMEParser *parser, HdrHeap *heap, MIMEHdrImpl *mh, const char **real_s, const char *real_e,
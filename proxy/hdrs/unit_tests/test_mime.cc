@@ -249,3 +249,34 @@ TEST_CASE("MimeParsers", "[proxy][mimeparsers]")
   std::printf("Date1: %d\n", d1);
   std::printf("Date2: %d\n", d2);
 }
+
+TEST_CASE("MimeFindControl", "[proxy][mimecontrol]")
+{
+  // Every byte value at every offset of buffers long enough to cover the vector strides and the
+  // scalar tail after them.
+  for (int len : {0, 1, 15, 16, 17, 31, 32, 33, 64, 100}) {
+    std::string text(len, 'a');
+    const char *s = text.data();
+    const char *e = s + text.size();
+    REQUIRE(mime_find_control(s, e) == e);
+
+    for (int pos = 0; pos < len; ++pos) {
+      for (int c = 0; c < 256; ++c) {
+        text[pos]      = static_cast<char>(c);
+        const char *at = mime_find_control(s, e);
+        if (ParseRules::is_control(static_cast<char>(c))) {
+          REQUIRE(at == s + pos);
+        } else {
+          REQUIRE(at == e);
+        }
+      }
+      text[pos] = 'a';
+    }
+  }
+
+  // The first of several control characters is the one found.
+  std::string text(80, '\t');
+  text[70] = '\x7f';
+  text[40] = '\r';
+  CHECK(mime_find_control(text.data(), text.data() + text.size()) == text.data() + 40);
+}
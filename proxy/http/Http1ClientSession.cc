@@ -303,6 +303,9 @@ Http1ClientSession::state_wait_for_close(int event, void *data)
     _reader->consume(_reader->read_avail());
     break;
 
+  case NET_EVENT_PARKED:
+    break;
+
   default:
     ink_release_assert(0);
     break;
@@ -366,6 +369,11 @@ Http1ClientSession::state_keep_alive(int event, void *data)
     }
   }
 
+  // The connection released its buffers while idle, there is nothing else to shrink.
+  if (event == NET_EVENT_PARKED) {
+    return 0;
+  }
+
   // If we got here due to a network I/O event directly, go ahead and cancel any remaining schedule events
   if (schedule_event) {
     schedule_event->cancel();
@@ -122,7 +122,12 @@ HttpCacheSM::state_cache_open_read(int event, void *data)
     err_code = reinterpret_cast<intptr_t>(data);
     if ((intptr_t)data == -ECACHE_DOC_BUSY) {
       // Somebody else is writing the object
-      if (open_read_tries <= master_sm->t_state.txn_conf->max_cache_open_read_retries) {
+      if (coalesce_on_writer()) {
+        // The cache already waited on the writer, which either gave up on the object or took
+        // too long; don't wait again.
+        open_read_cb = true;
+        master_sm->handleEvent(event, &captive_action);
+      } else if (open_read_tries <= master_sm->t_state.txn_conf->max_cache_open_read_retries) {
         // Retry to read; maybe the update finishes in time
         open_read_cb = false;
         do_schedule_in();
@@ -159,6 +164,12 @@ HttpCacheSM::state_cache_open_read(int event, void *data)
   return VC_EVENT_CONT;
 }
 
+bool
+HttpCacheSM::coalesce_on_writer() const
+{
+  return master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_COALESCE;
+}
+
 bool
 HttpCacheSM::write_retry_done() const
 {
@@ -194,7 +205,19 @@ HttpCacheSM::state_cache_open_write(int event, void *data)
     break;
 
   case CACHE_EVENT_OPEN_WRITE_FAILED: {
-    if (master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY) {
+    if (coalesce_on_writer()) {
+      // Read the object again, this time waiting on the writer that beat us to it. If that
+      // read still misses, or this is a revalidation, there is no point retrying the write.
+      if (!master_sm->t_state.cache_info.object_read && !coalesced) {
+        Debug("http_cache", "[%" PRId64 "] [state_cache_open_write] cache open write failure %d. coalescing on the writer",
+              master_sm->sm_id, open_write_tries);
+        coalesced                = true;
+        open_read_tries          = 0;
+        read_retry_on_write_fail = true;
+      }
+      open_write_tries = master_sm->t_state.txn_conf->max_cache_open_write_retries + 1;
+      open_write_start = 0;
+    } else if (master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY) {
       // fall back to open_read_tries
       // Note that when CACHE_WL_FAIL_ACTION_READ_RETRY is configured, max_cache_open_write_retries
       // is automatically ignored. Make sure to not disable max_cache_open_read_retries
@@ -240,7 +263,7 @@ HttpCacheSM::state_cache_open_write(int event, void *data)
   } break;
 
   case EVENT_INTERVAL:
-    if (master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY) {
+    if (master_sm->t_state.txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY || coalesce_on_writer()) {
       Debug("http_cache",
             "[%" PRId64 "] [state_cache_open_write] cache open write failure %d. "
             "falling back to read retry...",
@@ -275,8 +298,9 @@ void
 HttpCacheSM::do_schedule_in()
 {
   ink_assert(pending_action == nullptr);
-  Action *action_handle =
-    mutex->thread_holding->schedule_in(this, HRTIME_MSECONDS(master_sm->t_state.txn_conf->cache_open_read_retry_time));
+  // A coalescing reader waits inside the cache, so there is nothing to gain by delaying it here.
+  ink_hrtime const delay = coalesce_on_writer() ? 0 : HRTIME_MSECONDS(master_sm->t_state.txn_conf->cache_open_read_retry_time);
+  Action *action_handle  = mutex->thread_holding->schedule_in(this, delay);
 
   if (action_handle != ACTION_RESULT_DONE) {
     pending_action = action_handle;
@@ -212,6 +212,7 @@ private:
   Action *do_cache_open_read(const HttpCacheKey &);
 
   bool write_retry_done() const;
+  bool coalesce_on_writer() const;
 
   int state_cache_open_read(int event, void *data);
   int state_cache_open_write(int event, void *data);
@@ -229,7 +230,8 @@ private:
   // Open write parameters
   bool retry_write            = true;
   int open_write_tries        = 0;
-  ink_hrtime open_write_start = 0; // overrides open_write_tries
+  ink_hrtime open_write_start = 0;     // overrides open_write_tries
+  bool coalesced              = false; // re-read once to wait on the writer that beat us
 
   // Common parameters
   URL *lookup_url = nullptr;
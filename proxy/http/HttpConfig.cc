@@ -669,6 +669,18 @@ register_stat_callbacks()
   RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.cache_hit_stale_served", RECD_COUNTER, RECP_PERSISTENT,
                      (int)http_cache_hit_stale_served_stat, RecRawStatSyncCount);
 
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.cache_hit_stale_while_revalidate", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_cache_hit_stale_while_revalidate_stat, RecRawStatSyncCount);
+
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.cache_hit_stale_if_error", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_cache_hit_stale_if_error_stat, RecRawStatSyncCount);
+
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.stale_refresh_count", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_stale_refresh_count_stat, RecRawStatSyncCount);
+
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.stale_refresh_collapsed", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_stale_refresh_collapsed_stat, RecRawStatSyncCount);
+
   RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.cache_miss_cold", RECD_COUNTER, RECP_PERSISTENT,
                      (int)http_cache_miss_cold_stat, RecRawStatSyncCount);
 
@@ -1312,6 +1324,8 @@ HttpConfig::startup()
   HttpEstablishStaticConfigLongLong(c.oride.cache_guaranteed_max_lifetime, "proxy.config.http.cache.guaranteed_max_lifetime");
 
   HttpEstablishStaticConfigLongLong(c.oride.cache_max_stale_age, "proxy.config.http.cache.max_stale_age");
+  HttpEstablishStaticConfigByte(c.oride.cache_stale_while_revalidate, "proxy.config.http.cache.stale_while_revalidate");
+  HttpEstablishStaticConfigByte(c.oride.cache_stale_if_error, "proxy.config.http.cache.stale_if_error");
   HttpEstablishStaticConfigByte(c.oride.srv_enabled, "proxy.config.srv_enabled");
 
   HttpEstablishStaticConfigByte(c.oride.allow_half_open, "proxy.config.http.allow_half_open");
@@ -1607,7 +1621,9 @@ HttpConfig::reconfigure()
   params->oride.cache_guaranteed_min_lifetime = m_master.oride.cache_guaranteed_min_lifetime;
   params->oride.cache_guaranteed_max_lifetime = m_master.oride.cache_guaranteed_max_lifetime;
 
-  params->oride.cache_max_stale_age = m_master.oride.cache_max_stale_age;
+  params->oride.cache_max_stale_age          = m_master.oride.cache_max_stale_age;
+  params->oride.cache_stale_while_revalidate = INT_TO_BOOL(m_master.oride.cache_stale_while_revalidate);
+  params->oride.cache_stale_if_error         = INT_TO_BOOL(m_master.oride.cache_stale_if_error);
 
   params->oride.srv_enabled = m_master.oride.srv_enabled;
 
@@ -1747,6 +1763,21 @@ HttpConfig::release(HttpConfigParams *params)
   configProcessor.release(m_id, params);
 }
 
+////////////////////////////////////////////////////////////////
+//
+//  OverridableHttpConfigSnapshot
+//
+////////////////////////////////////////////////////////////////
+OverridableHttpConfigSnapshot::OverridableHttpConfigSnapshot(HttpConfigParams *params) : base(params), oride(params->oride)
+{
+  base->refcount_inc();
+}
+
+OverridableHttpConfigSnapshot::~OverridableHttpConfigSnapshot()
+{
+  HttpConfig::release(base);
+}
+
 ////////////////////////////////////////////////////////////////
 //
 //  HttpConfig::parse_ports_list()
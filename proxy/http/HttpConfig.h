@@ -186,6 +186,10 @@ enum {
   http_cache_hit_reval_stat,
   http_cache_hit_ims_stat,
   http_cache_hit_stale_served_stat,
+  http_cache_hit_stale_while_revalidate_stat,
+  http_cache_hit_stale_if_error_stat,
+  http_stale_refresh_count_stat,
+  http_stale_refresh_collapsed_stat,
   http_cache_miss_cold_stat,
   http_cache_miss_changed_stat,
   http_cache_miss_client_no_cache_stat,
@@ -377,6 +381,7 @@ enum CacheOpenWriteFailAction_t {
   CACHE_WL_FAIL_ACTION_ERROR_ON_MISS_STALE_ON_REVALIDATE = 0x03,
   CACHE_WL_FAIL_ACTION_ERROR_ON_MISS_OR_REVALIDATE       = 0x04,
   CACHE_WL_FAIL_ACTION_READ_RETRY                        = 0x05,
+  CACHE_WL_FAIL_ACTION_READ_COALESCE                     = 0x06,
   TOTAL_CACHE_WL_FAIL_ACTION_TYPES
 };
 
@@ -504,6 +509,12 @@ struct OverridableHttpConfigParams {
 
   MgmtByte cache_when_to_revalidate = 0;
 
+  ////////////////////////////////////////////
+  //  RFC 5861 Cache-Control extensions     //
+  ////////////////////////////////////////////
+  MgmtByte cache_stale_while_revalidate = 0;
+  MgmtByte cache_stale_if_error         = 0;
+
   MgmtByte keep_alive_enabled_in  = 1;
   MgmtByte keep_alive_enabled_out = 1;
   MgmtByte keep_alive_post_out    = 1; // share server sessions for post
@@ -902,6 +913,28 @@ public:
   static HttpConfigParams m_master;
 };
 
+/////////////////////////////////////////////////////////////
+//
+// struct OverridableHttpConfigSnapshot
+//
+// A copy of the overridable configuration with a fixed set
+// of overrides applied, such as those of a conf_remap rule.
+// It is built once per configuration generation and shared
+// by the transactions it applies to, which point txn_conf at
+// it instead of copying the configuration themselves.
+/////////////////////////////////////////////////////////////
+struct OverridableHttpConfigSnapshot : public RefCountObj {
+  explicit OverridableHttpConfigSnapshot(HttpConfigParams *params);
+  ~OverridableHttpConfigSnapshot() override;
+
+  OverridableHttpConfigSnapshot(const OverridableHttpConfigSnapshot &)            = delete;
+  OverridableHttpConfigSnapshot &operator=(const OverridableHttpConfigSnapshot &) = delete;
+
+  /// The configuration the overrides were applied to, held so that the strings it owns stay valid.
+  HttpConfigParams *base;
+  OverridableHttpConfigParams oride;
+};
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 //
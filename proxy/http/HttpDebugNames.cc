@@ -246,6 +246,8 @@ HttpDebugNames::get_event_name(int event)
     return "TS_EVENT_INTERNAL_211";
   case TS_EVENT_INTERNAL_212:
     return "TS_EVENT_INTERNAL_212";
+  case TS_EVENT_INTERNAL_213:
+    return "TS_EVENT_INTERNAL_213";
   case TS_EVENT_CACHE_SCAN:
     return "TS_EVENT_CACHE_SCAN";
   case TS_EVENT_CACHE_SCAN_FAILED:
@@ -2262,21 +2262,24 @@ HttpSM::process_srv_info(HostDBRecord *record)
 
   /* we didn't get any SRV records, continue w normal lookup */
   if (!record || !record->is_srv()) {
-    t_state.dns_info.srv_hostname[0]  = '\0';
+    t_state.dns_info.srv_hostname     = nullptr;
     t_state.dns_info.resolved_p       = false;
     t_state.my_txn_conf().srv_enabled = false;
     SMDebug("dns_srv", "No SRV records were available, continuing to lookup %s", t_state.dns_info.lookup_name);
   } else {
-    HostDBInfo *srv = record->select_best_srv(t_state.dns_info.srv_hostname, &mutex->thread_holding->generator, ts_clock::now(),
-                                              t_state.txn_conf->down_server_timeout);
+    char srv_hostname[MAXDNAME] = {0};
+    HostDBInfo *srv             = record->select_best_srv(srv_hostname, &mutex->thread_holding->generator, ts_clock::now(),
+                                                          t_state.txn_conf->down_server_timeout);
     if (!srv) {
       //      t_state.dns_info.srv_lookup_success = false;
-      t_state.dns_info.srv_hostname[0]  = '\0';
+      t_state.dns_info.srv_hostname     = nullptr;
       t_state.my_txn_conf().srv_enabled = false;
       SMDebug("dns_srv", "SRV records empty for %s", t_state.dns_info.lookup_name);
     } else {
-      t_state.dns_info.resolved_p = false;
-      t_state.dns_info.srv_port   = srv->data.srv.srv_port;
+      // Only the few transactions that use SRV need the name, so it is kept in the arena.
+      t_state.dns_info.resolved_p   = false;
+      t_state.dns_info.srv_port     = srv->data.srv.srv_port;
+      t_state.dns_info.srv_hostname = t_state.arena.str_store(srv_hostname, strlen(srv_hostname));
       ink_assert(srv->data.srv.key == makeHostHash(t_state.dns_info.srv_hostname));
       SMDebug("dns_srv", "select SRV records %s", t_state.dns_info.srv_hostname);
     }
@@ -2549,7 +2552,8 @@ HttpSM::state_cache_open_write(int event, void *data)
       t_state.cache_open_write_fail_action = t_state.txn_conf->cache_open_write_fail_action;
       // Note that CACHE_LOOKUP_COMPLETE may be invoked more than once
       // if CACHE_WL_FAIL_ACTION_READ_RETRY is configured
-      ink_assert(t_state.cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY);
+      ink_assert(t_state.cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY ||
+                 t_state.cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_COALESCE);
       t_state.cache_lookup_result         = HttpTransact::CACHE_LOOKUP_NONE;
       t_state.cache_info.write_lock_state = HttpTransact::CACHE_WL_READ_RETRY;
       break;
@@ -4237,7 +4241,8 @@ HttpSM::do_hostdb_lookup()
     }
     pending_action = hostDBProcessor.getSRVbyname_imm(this, (cb_process_result_pfn)&HttpSM::process_srv_info, d, 0, opt);
     if (pending_action.empty()) {
-      char const *host_name = t_state.dns_info.resolved_p ? t_state.dns_info.srv_hostname : t_state.dns_info.lookup_name;
+      char const *host_name =
+        t_state.dns_info.resolved_p && t_state.dns_info.srv_hostname ? t_state.dns_info.srv_hostname : t_state.dns_info.lookup_name;
       opt.port              = t_state.dns_info.resolved_p            ? t_state.dns_info.srv_port :
                               t_state.server_info.dst_addr.isValid() ? t_state.server_info.dst_addr.host_order_port() :
                                                                        t_state.hdr_info.client_request.port_get();
@@ -4415,7 +4420,12 @@ HttpSM::parse_range_and_compare(MIMEField *field, int64_t content_length)
     return;
   }
 
-  ranges    = new RangeRecord[n_values];
+  // The ranges live as long as the transaction, and a transform may hold on to them, so they come
+  // from the transaction arena and are never freed on their own.
+  ranges = static_cast<RangeRecord *>(t_state.arena.alloc(sizeof(RangeRecord) * n_values, alignof(RangeRecord)));
+  for (int i = 0; i < n_values; ++i) {
+    new (&ranges[i]) RangeRecord;
+  }
   value     += 6; // skip leading 'bytes='
   value_len -= 6;
 
@@ -4563,7 +4573,9 @@ HttpSM::parse_range_and_compare(MIMEField *field, int64_t content_length)
 Lfaild:
   t_state.range_in_cache   = false;
   t_state.num_range_fields = -1;
-  delete[] ranges;
+  if (ranges) {
+    t_state.arena.free(ranges, sizeof(RangeRecord) * n_values);
+  }
   return;
 }
 
@@ -8469,7 +8481,8 @@ PostDataBuffers::~PostDataBuffers()
 HTTPVersion
 HttpSM::get_server_version(HTTPHdr &hdr) const
 {
-  return this->server_txn->get_proxy_ssn()->get_version(hdr);
+  // Without a server transaction, as when HttpTransact is replayed, take the version the response claims.
+  return this->server_txn ? this->server_txn->get_proxy_ssn()->get_version(hdr) : hdr.version_get();
 }
 
 /// Update the milestone state given the milestones and timer.
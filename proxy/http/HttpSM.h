@@ -290,6 +290,7 @@ public:
 
   bool is_private();
   bool is_redirect_required();
+  void redirect_request(const char *redirect_url, const int redirect_len);
 
   /// Get the protocol stack for the inbound (client, user agent) connection.
   /// @arg result [out] Array to store the results
@@ -428,7 +429,6 @@ private:
   int do_api_callout();
   int do_api_callout_internal();
   void do_redirect();
-  void redirect_request(const char *redirect_url, const int redirect_len);
   void do_drain_request_body(HTTPHdr &response);
 
   void wait_for_full_body();
@@ -0,0 +1,199 @@
+/** @file
+
+  Background refresh of cached objects served within their stale-while-revalidate window.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <mutex>
+#include <unordered_set>
+
+#include "HttpStaleRefresh.h"
+#include "HttpSM.h"
+#include "HttpSessionAccept.h"
+#include "PluginVC.h"
+
+const char *const HttpStaleRefresh::TAG = "stale_refresh";
+
+extern HttpSessionAccept *plugin_http_accept;
+
+namespace
+{
+struct CryptoHashHasher {
+  size_t
+  operator()(CryptoHash const &hash) const
+  {
+    return hash.fold();
+  }
+};
+
+// Objects that have a refresh running.
+std::mutex refresh_mutex;
+std::unordered_set<CryptoHash, CryptoHashHasher> refreshing;
+
+void
+write_header(HTTPHdr *h, MIOBuffer *b)
+{
+  int dumpoffset = 0;
+  int done;
+
+  do {
+    IOBufferBlock *block = b->get_current_block();
+    int bufindex         = 0;
+    int tmp              = dumpoffset;
+
+    done       = h->print(block->start(), block->write_avail(), &bufindex, &tmp);
+    dumpoffset += bufindex;
+    b->fill(bufindex);
+    if (!done) {
+      b->add_block();
+    }
+  } while (!done);
+}
+
+} // namespace
+
+bool
+HttpStaleRefresh::start(HttpSM *sm)
+{
+  HttpTransact::State &s = sm->t_state;
+  CryptoHash key;
+
+  s.cache_info.object_read->object_key_get(&key);
+  {
+    std::lock_guard<std::mutex> lock(refresh_mutex);
+
+    if (!refreshing.insert(key).second) {
+      HTTP_INCREMENT_DYN_STAT(http_stale_refresh_collapsed_stat);
+      return false;
+    }
+  }
+  HTTP_INCREMENT_DYN_STAT(http_stale_refresh_count_stat);
+
+  HttpStaleRefresh *refresh =
+    new HttpStaleRefresh(key, s.client_info.src_addr, HRTIME_SECONDS(s.txn_conf->transaction_no_activity_timeout_out));
+  HTTPHdr request;
+
+  // Replay the request as the client sent it, so it is remapped and keyed in the same way, but
+  // unconditional, for the whole object, and without the client's cache directives.
+  request.create(HTTP_TYPE_REQUEST);
+  request.copy(&s.hdr_info.client_request);
+  request.method_set(HTTP_METHOD_GET, HTTP_LEN_GET);
+  if (s.unmapped_url.valid()) {
+    int host_len;
+    const char *host = s.unmapped_url.host_get(&host_len);
+
+    request.url_set(&s.unmapped_url);
+    if (host && host_len > 0) {
+      request.value_set(MIME_FIELD_HOST, MIME_LEN_HOST, host, host_len);
+    }
+  }
+  request.field_delete(MIME_FIELD_RANGE, MIME_LEN_RANGE);
+  request.field_delete(MIME_FIELD_IF_RANGE, MIME_LEN_IF_RANGE);
+  request.field_delete(MIME_FIELD_IF_MATCH, MIME_LEN_IF_MATCH);
+  request.field_delete(MIME_FIELD_IF_NONE_MATCH, MIME_LEN_IF_NONE_MATCH);
+  request.field_delete(MIME_FIELD_IF_MODIFIED_SINCE, MIME_LEN_IF_MODIFIED_SINCE);
+  request.field_delete(MIME_FIELD_IF_UNMODIFIED_SINCE, MIME_LEN_IF_UNMODIFIED_SINCE);
+  request.field_delete(MIME_FIELD_CACHE_CONTROL, MIME_LEN_CACHE_CONTROL);
+  request.field_delete(MIME_FIELD_PRAGMA, MIME_LEN_PRAGMA);
+  request.field_delete(MIME_FIELD_CONTENT_LENGTH, MIME_LEN_CONTENT_LENGTH);
+  request.field_delete(MIME_FIELD_TRANSFER_ENCODING, MIME_LEN_TRANSFER_ENCODING);
+  request.field_delete(MIME_FIELD_EXPECT, MIME_LEN_EXPECT);
+  request.value_set(MIME_FIELD_CONNECTION, MIME_LEN_CONNECTION, "close", 5);
+
+  write_header(&request, refresh->_req_buffer);
+  request.destroy();
+
+  Debug("http_stale_refresh", "[%" PRId64 "] starting refresh of the object served stale", sm->sm_id);
+
+  eventProcessor.schedule_imm(refresh, ET_NET);
+  return true;
+}
+
+HttpStaleRefresh::HttpStaleRefresh(CryptoHash const &key, IpEndpoint const &addr, ink_hrtime timeout)
+  : Continuation(new_ProxyMutex()), _key(key), _addr(addr), _timeout(timeout)
+{
+  _req_buffer  = new_MIOBuffer(BUFFER_SIZE_INDEX_4K);
+  _req_reader  = _req_buffer->alloc_reader();
+  _resp_buffer = new_MIOBuffer(BUFFER_SIZE_INDEX_32K);
+  _resp_reader = _resp_buffer->alloc_reader();
+
+  SET_HANDLER(&HttpStaleRefresh::state_connect);
+}
+
+HttpStaleRefresh::~HttpStaleRefresh()
+{
+  free_MIOBuffer(_req_buffer);
+  free_MIOBuffer(_resp_buffer);
+
+  std::lock_guard<std::mutex> lock(refresh_mutex);
+  refreshing.erase(_key);
+}
+
+int
+HttpStaleRefresh::state_connect(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
+{
+  if (plugin_http_accept == nullptr) {
+    delete this;
+    return EVENT_DONE;
+  }
+
+  PluginVCCore *core = PluginVCCore::alloc(plugin_http_accept);
+
+  core->set_active_addr(&_addr.sa);
+  core->set_plugin_id(0);
+  core->set_plugin_tag(TAG);
+
+  _vc = core->connect();
+  if (PluginVC *other_side = _vc->get_other_side(); other_side != nullptr) {
+    other_side->set_is_internal_request(true);
+  }
+
+  SET_HANDLER(&HttpStaleRefresh::state_fetch);
+  _vc->set_inactivity_timeout(_timeout);
+  _vc->do_io_read(this, INT64_MAX, _resp_buffer);
+  _vc->do_io_write(this, _req_reader->read_avail(), _req_reader);
+
+  return EVENT_DONE;
+}
+
+int
+HttpStaleRefresh::state_fetch(int event, void *data)
+{
+  switch (event) {
+  case VC_EVENT_WRITE_READY:
+  case VC_EVENT_WRITE_COMPLETE:
+    break;
+
+  case VC_EVENT_READ_READY:
+    // The response only matters to the cache, drop it as it arrives.
+    _resp_reader->consume(_resp_reader->read_avail());
+    static_cast<VIO *>(data)->reenable();
+    break;
+
+  default:
+    Debug("http_stale_refresh", "refresh done, event %d", event);
+    _vc->do_io_close();
+    _vc = nullptr;
+    delete this;
+    return EVENT_DONE;
+  }
+
+  return EVENT_CONT;
+}
@@ -0,0 +1,68 @@
+/** @file
+
+  Background refresh of cached objects served within their stale-while-revalidate window.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/CryptoHash.h"
+#include "tscore/ink_inet.h"
+#include "I_EventSystem.h"
+#include "HTTP.h"
+
+class HttpSM;
+class PluginVC;
+
+/** Replays a request through the proxy, on behalf of a transaction that was served a stale object,
+    so that the cache is revalidated or refilled without the client waiting on the origin.
+
+    At most one refresh runs for a cached object at a time. The refresh is an ordinary transaction
+    coming in over a PluginVC, tagged with @c TAG so that HttpTransact never serves it stale, and
+    the response is read and discarded.
+ */
+class HttpStaleRefresh : public Continuation
+{
+public:
+  /// Plugin tag of the refresh transactions.
+  static const char *const TAG;
+
+  /** Start a refresh of the object @a sm is serving.
+      @return @c false if a refresh for the object was already running.
+   */
+  static bool start(HttpSM *sm);
+
+private:
+  HttpStaleRefresh(CryptoHash const &key, IpEndpoint const &addr, ink_hrtime timeout);
+  ~HttpStaleRefresh() override;
+
+  int state_connect(int event, void *data);
+  int state_fetch(int event, void *data);
+
+  CryptoHash _key;
+  IpEndpoint _addr;
+  ink_hrtime _timeout;
+
+  PluginVC *_vc                = nullptr;
+  MIOBuffer *_req_buffer       = nullptr;
+  IOBufferReader *_req_reader  = nullptr;
+  MIOBuffer *_resp_buffer      = nullptr;
+  IOBufferReader *_resp_reader = nullptr;
+};
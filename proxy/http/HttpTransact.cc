@@ -32,6 +32,7 @@
 #include "HttpSM.h"
 #include "HttpCacheSM.h" //Added to get the scope of HttpCacheSM object - YTS Team, yamsat
 #include "HttpDebugNames.h"
+#include "HttpStaleRefresh.h"
 #include <ctime>
 #include "tscore/ParseRules.h"
 #include "tscore/Filenames.h"
@@ -1976,8 +1977,7 @@ HttpTransact::OSDNSLookup(State *s)
       ink_release_assert(s->http_config_param->redirect_actions_map != nullptr);
       ink_release_assert(s->http_config_param->redirect_actions_map->contains(s->dns_info.addr, reinterpret_cast<void **>(&x)));
       action = static_cast<RedirectEnabled::Action>(x);
-      TxnDebug("http_trans", "[OSDNSLookup] Mapped action - %d for family %d.", int(action),
-               int(s->dns_info.active->data.ip.family()));
+      TxnDebug("http_trans", "[OSDNSLookup] Mapped action - %d for family %d.", int(action), int(s->dns_info.addr.family()));
     }
 
     if (action == RedirectEnabled::Action::FOLLOW) {
@@ -2837,6 +2837,7 @@ HttpTransact::HandleCacheOpenReadHit(State *s)
 
   if (send_revalidate) {
     TxnDebug("http_trans", "CacheOpenRead --- HIT-STALE");
+    s->cache_info.stale_while_revalidate = false;
 
     TxnDebug("http_seq", "Revalidate document with server");
 
@@ -2949,6 +2950,12 @@ HttpTransact::HandleCacheOpenReadHit(State *s)
     SET_VIA_STRING(VIA_CACHE_RESULT, VIA_IN_CACHE_FRESH);
   }
 
+  if (s->cache_info.stale_while_revalidate) {
+    TxnDebug("http_trans", "CacheOpenRead --- HIT-STALE-WHILE-REVALIDATE");
+    HTTP_INCREMENT_DYN_STAT(http_cache_hit_stale_while_revalidate_stat);
+    HttpStaleRefresh::start(s->state_machine);
+  }
+
   HttpCacheSM &cache_sm = s->state_machine->get_cache_sm();
   TxnDebug("http_trans", "CacheOpenRead --- HIT-FRESH read while write %d", cache_sm.is_readwhilewrite_inprogress());
   if (cache_sm.is_readwhilewrite_inprogress())
@@ -3174,7 +3181,8 @@ HttpTransact::handle_cache_write_lock(State *s)
       //  Write failed and read retry triggered
       //  Clean up server_request and re-initiate
       //  Cache Lookup
-      ink_assert(s->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY);
+      ink_assert(s->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_RETRY ||
+                 s->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_COALESCE);
       s->cache_info.write_status = CACHE_WRITE_LOCK_MISS;
       StateMachineAction_t next;
       next           = SM_ACTION_CACHE_LOOKUP;
@@ -3280,6 +3288,10 @@ HttpTransact::HandleCacheOpenReadMiss(State *s)
     s->cache_info.action = CACHE_DO_NO_ACTION;
   } else if (s->api_server_response_no_store) { // plugin may have decided not to cache the response
     s->cache_info.action = CACHE_DO_NO_ACTION;
+  } else if (s->cache_info.action == CACHE_DO_NO_ACTION &&
+             s->txn_conf->cache_open_write_fail_action == CACHE_WL_FAIL_ACTION_READ_COALESCE) {
+    // The writer we coalesced on gave up on the document. Going for the write
+    // lock again would only queue us up behind whichever waiter got it first.
   } else {
     s->cache_info.action = CACHE_PREPARE_TO_WRITE;
   }
@@ -4327,6 +4339,19 @@ HttpTransact::handle_cache_operation_on_forward_server_response(State *s)
     SET_VIA_STRING(VIA_SERVER_RESULT, VIA_SERVER_SERVED);
     SET_VIA_STRING(VIA_PROXY_RESULT, VIA_PROXY_SERVED);
 
+    /* if we receive a 500, 502, 503 or 504 while revalidating a document that allows it
+       with stale-if-error, serve the stale document as it is.
+     */
+    if ((server_response_code == HTTP_STATUS_INTERNAL_SERVER_ERROR || server_response_code == HTTP_STATUS_GATEWAY_TIMEOUT ||
+         server_response_code == HTTP_STATUS_BAD_GATEWAY || server_response_code == HTTP_STATUS_SERVICE_UNAVAILABLE) &&
+        s->cache_info.action == CACHE_DO_UPDATE && is_stale_if_error_returnable(s)) {
+      TxnDebug("http_trans", "[hcoofsr] stale-if-error: serving stale object from cache");
+      HTTP_INCREMENT_DYN_STAT(http_cache_hit_stale_if_error_stat);
+      s->source = SOURCE_CACHE;
+      build_response_from_cache(s, HTTP_WARNING_CODE_REVALIDATION_FAILED);
+      return;
+    }
+
     /* if we receive a 500, 502, 503 or 504 while revalidating
        a document, treat the response as a 304 and in effect revalidate the document for
        negative_revalidating_lifetime. (negative revalidating)
@@ -5993,6 +6018,106 @@ HttpTransact::is_stale_cache_response_returnable(State *s)
   return true;
 }
 
+// The delta-seconds of a Cache-Control extension directive, which are not cooked, or -1 if the
+// header does not have the directive.
+static int
+cache_control_extension_secs(HTTPHdr *hdr, std::string_view directive)
+{
+  MIMEField *field = hdr->field_find(MIME_FIELD_CACHE_CONTROL, MIME_LEN_CACHE_CONTROL);
+  HdrCsvIter iter;
+
+  if (field == nullptr) {
+    return -1;
+  }
+  for (ts::TextView value = iter.get_first(field); !value.empty(); value = iter.get_next()) {
+    if (value.size() > directive.size() && value[directive.size()] == '=' &&
+        strncasecmp(value.data(), directive.data(), directive.size()) == 0) {
+      const char *c = value.data() + directive.size();
+      int secs;
+
+      if (mime_parse_integer(c, value.data_end(), &secs) && secs >= 0) {
+        return secs;
+      }
+    }
+  }
+
+  return -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Name       : is_stale_while_revalidate_returnable()
+// Description: check if a stale cached response can be served while it is refreshed
+//
+// Input      : State, the cached response, and for how long it has been stale
+// Output     : true or false
+//
+// Details    :
+//
+// RFC 5861: the origin's stale-while-revalidate=N lets the response be served for N
+// seconds after it becomes stale, while the cache revalidates it in the background.
+///////////////////////////////////////////////////////////////////////////////
+bool
+HttpTransact::is_stale_while_revalidate_returnable(State *s, HTTPHdr *cached_response, ink_time_t stale_for)
+{
+  if (!s->txn_conf->cache_stale_while_revalidate) {
+    return false;
+  }
+  // The refresh itself must go to the origin.
+  if (s->state_machine->plugin_tag == HttpStaleRefresh::TAG) {
+    return false;
+  }
+  if (s->method != HTTP_WKSIDX_GET && s->method != HTTP_WKSIDX_HEAD) {
+    return false;
+  }
+
+  int window = cache_control_extension_secs(cached_response, "stale-while-revalidate");
+
+  if (window < 0 || stale_for > window) {
+    TxnDebug("http_match", "stale for %" PRId64 "s, stale-while-revalidate %d", static_cast<int64_t>(stale_for), window);
+    return false;
+  }
+
+  return is_stale_cache_response_returnable(s);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Name       : is_stale_if_error_returnable()
+// Description: check if a stale cached response can be served when revalidation fails
+//
+// Input      : State
+// Output     : true or false
+//
+// Details    :
+//
+// RFC 5861: the origin's stale-if-error=N lets the response be served for N seconds
+// after it becomes stale, when the origin answers its revalidation with an error.
+///////////////////////////////////////////////////////////////////////////////
+bool
+HttpTransact::is_stale_if_error_returnable(State *s)
+{
+  if (!s->txn_conf->cache_stale_if_error || s->cache_info.object_read == nullptr) {
+    return false;
+  }
+
+  CacheHTTPInfo *obj       = s->cache_info.object_read;
+  HTTPHdr *cached_response = obj->response_get();
+  int window               = cache_control_extension_secs(cached_response, "stale-if-error");
+
+  if (window < 0 || !is_stale_cache_response_returnable(s)) {
+    return false;
+  }
+
+  bool heuristic;
+  time_t response_date = cached_response->get_date();
+  int fresh_limit      = calculate_document_freshness_limit(s, cached_response, response_date, &heuristic);
+  time_t current_age   = HttpTransactHeaders::calculate_document_age(obj->request_sent_time_get(), obj->response_received_time_get(),
+                                                                     cached_response, response_date, s->current.now);
+
+  TxnDebug("http_trans", "stale-if-error %d, fresh_limit %d, current_age %" PRId64, window, fresh_limit,
+           static_cast<int64_t>(current_age));
+  return current_age >= 0 && current_age <= static_cast<time_t>(fresh_limit) + window;
+}
+
 bool
 HttpTransact::url_looks_dynamic(URL *url)
 {
@@ -7445,6 +7570,13 @@ HttpTransact::what_is_document_freshness(State *s, HTTPHdr *client_request, HTTP
   ///////////////////////////////////////////
 
   if (do_revalidate || !age_limit || current_age > age_limit) { // client-modified limit
+    if (!do_revalidate && !os_specifies_revalidate && age_limit == fresh_limit &&
+        is_stale_while_revalidate_returnable(s, cached_obj_response, current_age - fresh_limit)) {
+      TxnDebug("http_match", "document is stale within its stale-while-revalidate window; "
+                             "returning FRESHNESS_FRESH");
+      s->cache_info.stale_while_revalidate = true;
+      return (FRESHNESS_FRESH);
+    }
     TxnDebug("http_match", "document needs revalidate/too old; "
                            "returning FRESHNESS_STALE");
     return (FRESHNESS_STALE);
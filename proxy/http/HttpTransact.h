@@ -504,6 +504,8 @@ public:
     SquidHitMissCode hit_miss_code    = SQUID_MISS_NONE;
     URL *parent_selection_url         = nullptr;
     URL parent_selection_url_storage;
+    // The stale object is served while a background refresh revalidates it.
+    bool stale_while_revalidate = false;
 
     _CacheLookupInfo() {}
   } CacheLookupInfo;
@@ -803,6 +805,8 @@ public:
     RangeRecord *ranges      = nullptr;
 
     OverridableHttpConfigParams const *txn_conf = nullptr;
+    /// Shared overrides that @a txn_conf points into, until the transaction needs a copy of its own.
+    Ptr<OverridableHttpConfigSnapshot> txn_conf_snapshot;
     OverridableHttpConfigParams &
     my_txn_conf() // Storage for plugins, to avoid malloc
     {
@@ -870,6 +874,8 @@ public:
       ParentConfig::release(parent_params);
       parent_params = nullptr;
 
+      txn_conf_snapshot.clear();
+
       hdr_info.client_request.destroy();
       hdr_info.client_response.destroy();
       hdr_info.server_request.destroy();
@@ -889,21 +895,21 @@ public:
       dns_info.~ResolveInfo();
       outbound_conn_track_state.clear();
 
-      delete[] ranges;
-      ranges      = nullptr;
+      ranges      = nullptr; // Allocated from @a arena.
       range_setup = RANGE_NONE;
       return;
     }
 
     int64_t state_machine_id() const;
 
-    // Little helper function to setup the per-transaction configuration copy
+    // Little helper function to setup the per-transaction configuration copy. This copies the configuration in
+    // effect, which includes the overrides of a shared snapshot if one was applied.
     void
     setup_per_txn_configs()
     {
       if (txn_conf != reinterpret_cast<OverridableHttpConfigParams *>(_my_txn_conf)) {
+        memcpy(_my_txn_conf, txn_conf, sizeof(_my_txn_conf));
         txn_conf = reinterpret_cast<OverridableHttpConfigParams *>(_my_txn_conf);
-        memcpy(_my_txn_conf, &http_config_param->oride, sizeof(_my_txn_conf));
       }
     }
 
@@ -1045,6 +1051,8 @@ public:
   static bool is_server_negative_cached(State *s);
   static bool is_cache_response_returnable(State *s);
   static bool is_stale_cache_response_returnable(State *s);
+  static bool is_stale_while_revalidate_returnable(State *s, HTTPHdr *cached_response, ink_time_t stale_for);
+  static bool is_stale_if_error_returnable(State *s);
   static bool need_to_revalidate(State *s);
   static bool url_looks_dynamic(URL *url);
   static bool is_request_cache_lookupable(State *s);
@@ -29,7 +29,9 @@
 #include <ctime>
 #include "HTTP.h"
 #include "HttpCompat.h"
+#include "HdrUtils.h"
 #include "tscore/InkErrno.h"
+#include "tscore/HashFNV.h"
 
 /**
   Find the pointer and length of an etag, after stripping off any leading
@@ -172,6 +174,11 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
   float best_Q         = -1.0;
   float unacceptable_Q = 0.0;
 
+  // Keys of the client request for the Vary lists seen so far, see below.
+  static constexpr int N_CLIENT_VARY_KEYS = 4;
+  CacheVaryKey client_keys[N_CLIENT_VARY_KEYS];
+  int n_client_keys = 0;
+
   int alt_count = cache_vector->count();
   if (alt_count == 0) {
     return -1;
@@ -189,6 +196,18 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
     return 0;
   }
 
+  // An alternate whose Vary headers do not match the request scores -1 no matter how well it
+  // matches otherwise, so with many variants most of the quality scoring is wasted. Instead the
+  // Vary headers of each alternate are hashed once, and kept with the vector, and only the
+  // alternates whose key equals the request's are scored. PURGE matches anything, and a
+  // SELECT_ALT hook can force an alternate past Vary, so those still score every alternate.
+  int vary_config = -1;
+  if (alt_count > 1 && client_request->method_get_wksidx() != HTTP_WKSIDX_PURGE &&
+      http_global_hooks->get(TS_HTTP_SELECT_ALT_HOOK) == nullptr) {
+    vary_config =
+      (http_config_params->global_user_agent_header ? 1 : 0) | (http_config_params->ignore_accept_encoding_mismatch ? 2 : 0);
+  }
+
   for (int i = 0; i < alt_count; i++) {
     float Q;
     CacheHTTPInfo *obj       = cache_vector->get(i);
@@ -199,6 +218,36 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
       ink_assert(cached_request->valid());
       ink_assert(cached_response->valid());
 
+      if (vary_config >= 0) {
+        CacheVaryKey *key = cache_vector->vary_key_get(i);
+
+        if (key->config != vary_config) {
+          calculate_vary_key(http_config_params, cached_response, cached_request, key);
+          key->config = vary_config;
+        }
+        if (key->wildcard) {
+          continue;
+        }
+        if (key->names != 0) {
+          int k = 0;
+          while (k < n_client_keys && client_keys[k].names != key->names) {
+            ++k;
+          }
+          if (k == n_client_keys) {
+            if (n_client_keys < N_CLIENT_VARY_KEYS) {
+              ++n_client_keys;
+            } else {
+              k = 0; // Too many different Vary lists, recycle the first key.
+            }
+            calculate_vary_key(http_config_params, cached_response, client_request, &client_keys[k]);
+          }
+          if (client_keys[k].values != key->values) {
+            Debug("http_match", "[SelectFromAlternates] alternate #%d varies", i);
+            continue;
+          }
+        }
+      }
+
       Q = calculate_quality_of_match(http_config_params, client_request, cached_request, cached_response);
 
       if (alt_count > 1) {
@@ -261,6 +310,77 @@ HttpTransactCache::SelectFromAlternates(CacheHTTPInfoVector *cache_vector, HTTPH
   }
 }
 
+/**
+  Hash the headers of @a request named in the Vary of @a response into @a key.
+
+  Any two requests that CalcVariability() finds to match for @a response get
+  the same key: header names and values are folded to one case, and each
+  value of a list is hashed separately so whitespace around commas does not
+  count. The converse does not hold, so equal keys still need to be checked.
+
+*/
+void
+HttpTransactCache::calculate_vary_key(const OverridableHttpConfigParams *http_config_params, HTTPHdr *response, HTTPHdr *request,
+                                      CacheVaryKey *key)
+{
+  ATSHash64FNV1a names, values;
+  StrList vary_list;
+
+  key->wildcard = false;
+  key->names    = 0;
+  key->values   = 0;
+
+  if (!response->presence(MIME_PRESENCE_VARY) || response->value_get_comma_list(MIME_FIELD_VARY, MIME_LEN_VARY, &vary_list) <= 0) {
+    return;
+  }
+
+  for (Str *field = vary_list.head; field != nullptr; field = field->next) {
+    if (field->len == 0) {
+      continue;
+    }
+    if ((field->str[0] == '*') && (field->str[1] == NUL)) {
+      key->wildcard = true;
+      return;
+    }
+    // Skip the same fields as CalcVariability().
+    if (http_config_params->global_user_agent_header && !strcasecmp(field->str, "User-Agent")) {
+      continue;
+    }
+    if (http_config_params->ignore_accept_encoding_mismatch && !strcasecmp(field->str, "Accept-Encoding")) {
+      continue;
+    }
+
+    const char *field_name_str = hdrtoken_string_to_wks(field->str, field->len);
+    if (field_name_str == nullptr) {
+      field_name_str = field->str;
+    }
+    names.update(field->str, field->len + 1, ATSHash::nocase());
+
+    MIMEField *hdr_field = request->field_find(field_name_str, field->len);
+    if (hdr_field == nullptr) {
+      values.update("\x01", 1);
+      continue;
+    }
+
+    HdrCsvIter iter;
+    int value_len;
+    const char *value = iter.get_first(hdr_field, &value_len);
+
+    values.update("\x02", 1);
+    while (value) {
+      values.update(&value_len, sizeof(value_len));
+      values.update(value, value_len, ATSHash::nocase());
+      value = iter.get_next(&value_len);
+    }
+  }
+
+  names.final();
+  values.final();
+  // Zero is kept for responses without Vary.
+  key->names  = names.get() | 1;
+  key->values = values.get();
+}
+
 /**
   For cached req/res and incoming req, return quality of match.
 
@@ -37,6 +37,7 @@
 // readily available in the cache. ToDo: We should fix this with TS-1919
 static const time_t CacheHighAgeWatermark = UINT_MAX;
 struct CacheHTTPInfoVector;
+struct CacheVaryKey;
 
 enum Variability_t {
   VARIABILITY_NONE = 0,
@@ -78,6 +79,9 @@ public:
   static Variability_t CalcVariability(const OverridableHttpConfigParams *http_config_params, HTTPHdr *client_request,
                                        HTTPHdr *obj_client_request, HTTPHdr *obj_origin_server_response);
 
+  static void calculate_vary_key(const OverridableHttpConfigParams *http_config_params, HTTPHdr *response, HTTPHdr *request,
+                                 CacheVaryKey *key);
+
   static HTTPStatus match_response_to_request_conditionals(HTTPHdr *ua_request, HTTPHdr *c_response,
                                                            ink_time_t response_received_time);
 
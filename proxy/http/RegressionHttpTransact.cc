@@ -24,6 +24,9 @@
 #include "tscore/Regression.h"
 #include "HttpTransact.h"
 #include "HttpSM.h"
+#include "HttpDebugNames.h"
+
+extern ClassAllocator<HttpSM> httpSMAllocator;
 
 void
 forceLinkRegressionHttpTransact()
@@ -140,3 +143,274 @@ REGRESSION_TEST(HttpTransact_handle_request)(RegressionTest * /* t */, int /* le
   // To be added..
   *pstatus = REGRESSION_TEST_PASSED;
 }
+
+REGRESSION_TEST(HttpSM_transaction_footprint)(RegressionTest *t, int /* level */, int *pstatus)
+{
+  HttpSM sm;
+  *pstatus = REGRESSION_TEST_PASSED;
+
+  rprintf(t, "sizeof(HttpSM) = %zu, sizeof(HttpTransact::State) = %zu, sizeof(ResolveInfo) = %zu\n", sizeof(HttpSM),
+          sizeof(HttpTransact::State), sizeof(ResolveInfo));
+  // The SRV host name is kept in the transaction arena, not in a buffer in every transaction.
+  if (sizeof(ResolveInfo) >= MAXDNAME) {
+    rprintf(t, "ResolveInfo embeds a host name buffer\n");
+    *pstatus = REGRESSION_TEST_FAILED;
+  }
+
+  setup_client_request(&sm, "http", "GET / HTTP/1.1\r\nHost: abc.com\r\nRange: bytes=0-9,20-29,90-\r\n\r\n");
+
+  MIMEField *field = sm.t_state.hdr_info.client_request.field_find(MIME_FIELD_RANGE, MIME_LEN_RANGE);
+  sm.parse_range_and_compare(field, 100);
+  if (sm.t_state.range_setup != HttpTransact::RANGE_REQUESTED || sm.t_state.num_range_fields != 3 ||
+      sm.t_state.ranges[1]._start != 20 || sm.t_state.ranges[2]._end != 99) {
+    rprintf(t, "HttpSM::parse_range_and_compare - failed, range setup %d with %d ranges\n", sm.t_state.range_setup,
+            sm.t_state.num_range_fields);
+    *pstatus = REGRESSION_TEST_FAILED;
+  }
+  sm.t_state.destroy();
+}
+
+/*
+  Replay harness
+
+  Drives HttpTransact through recorded transactions, doing what HttpSM does for each action with
+  the results taken from the scenario instead of the cache, HostDB and the network. This covers
+  the transaction logic only, the tunnels that move the body are not run. Each scenario is timed
+  over a number of transactions, with a new HttpSM for each one as in the proxy.
+ */
+namespace
+{
+struct ReplayScenario {
+  const char *name;
+  const char *request;
+  const char *cached;     ///< Response in the cache, @c nullptr for a miss.
+  const char *origin[3];  ///< Responses to successive server connections, @c nullptr if the connection fails.
+  const char *parents;    ///< parent.config rules, if the request goes through parents.
+  int redirections;       ///< Redirections to follow.
+  HTTPStatus status;      ///< Status of the response to the client.
+  HttpTransact::StateMachineAction_t last; ///< Action ending the transaction.
+};
+
+// Addresses are from TEST-NET-1, they are never connected to. Parents are given by address, so that
+// a name is only resolved when the request goes to the origin.
+const ReplayScenario replay_scenarios[] = {
+  {"miss", "GET http://192.0.2.10/miss HTTP/1.1\r\nHost: 192.0.2.10\r\n\r\n", nullptr,
+   {"HTTP/1.1 200 OK\r\nCache-Control: max-age=300\r\nContent-Length: 10\r\n\r\n"}, nullptr, 0, HTTP_STATUS_OK,
+   HttpTransact::SM_ACTION_SERVER_READ},
+  {"hit-fresh", "GET http://192.0.2.10/hit HTTP/1.1\r\nHost: 192.0.2.10\r\n\r\n",
+   "HTTP/1.1 200 OK\r\nCache-Control: max-age=300\r\nContent-Length: 10\r\n\r\n", {}, nullptr, 0, HTTP_STATUS_OK,
+   HttpTransact::SM_ACTION_SERVE_FROM_CACHE},
+  {"revalidate-304", "GET http://192.0.2.10/stale HTTP/1.1\r\nHost: 192.0.2.10\r\n\r\n",
+   "HTTP/1.1 200 OK\r\nCache-Control: max-age=0\r\nETag: \"v1\"\r\nContent-Length: 10\r\n\r\n",
+   {"HTTP/1.1 304 Not Modified\r\nCache-Control: max-age=0\r\nETag: \"v1\"\r\n\r\n"}, nullptr, 0, HTTP_STATUS_OK,
+   HttpTransact::SM_ACTION_SERVE_FROM_CACHE},
+  {"revalidate-200", "GET http://192.0.2.10/stale HTTP/1.1\r\nHost: 192.0.2.10\r\n\r\n",
+   "HTTP/1.1 200 OK\r\nCache-Control: max-age=0\r\nETag: \"v1\"\r\nContent-Length: 10\r\n\r\n",
+   {"HTTP/1.1 200 OK\r\nCache-Control: max-age=300\r\nETag: \"v2\"\r\nContent-Length: 12\r\n\r\n"}, nullptr, 0, HTTP_STATUS_OK,
+   HttpTransact::SM_ACTION_SERVER_READ},
+  {"redirect", "GET http://192.0.2.10/moved HTTP/1.1\r\nHost: 192.0.2.10\r\n\r\n", nullptr,
+   {"HTTP/1.1 302 Found\r\nLocation: http://192.0.2.11/target\r\nContent-Length: 0\r\n\r\n",
+    "HTTP/1.1 200 OK\r\nCache-Control: max-age=300\r\nContent-Length: 10\r\n\r\n"},
+   nullptr, 1, HTTP_STATUS_OK, HttpTransact::SM_ACTION_SERVER_READ},
+  {"parent-failover", "GET http://origin.test/parent HTTP/1.1\r\nHost: origin.test\r\n\r\n", nullptr,
+   {nullptr, "HTTP/1.1 200 OK\r\nCache-Control: max-age=300\r\nContent-Length: 10\r\n\r\n"},
+   "dest_domain=origin.test parent=192.0.2.20:8080,192.0.2.21:8080 round_robin=false go_direct=false\n", 0, HTTP_STATUS_OK,
+   HttpTransact::SM_ACTION_SERVER_READ},
+};
+
+struct ReplayResult {
+  HTTPStatus status                   = HTTP_STATUS_NONE;
+  HttpTransact::StateMachineAction_t last = HttpTransact::SM_ACTION_UNDEFINED;
+  int heaps                           = 0; ///< Header heaps the transaction holds when it ends.
+};
+
+int
+held_header_heaps(EThread *thread)
+{
+  return -(thread->hdrHeapAllocator.allocated + thread->strHeapAllocator.allocated);
+}
+
+void
+parse_response(HTTPHdr *hdr, const char *text)
+{
+  HTTPParser parser;
+  const char *start = text;
+
+  http_parser_init(&parser);
+  hdr->create(HTTP_TYPE_RESPONSE);
+  hdr->parse_resp(&parser, &start, text + strlen(text), true);
+  hdr->set_date(ink_local_time());
+  http_parser_clear(&parser);
+}
+
+ReplayResult
+replay_transaction(ReplayScenario const &scenario, ParentConfigParams *parents)
+{
+  ReplayResult result;
+  EThread *thread         = this_ethread();
+  HttpSM *sm              = THREAD_ALLOC(httpSMAllocator, thread);
+  HttpTransact::State &s  = sm->t_state;
+  CacheHTTPInfo cached;
+  HTTPParser parser;
+  const char *start = scenario.request;
+  int origin        = 0;
+
+  int heaps = held_header_heaps(thread);
+  sm->init();
+
+  http_parser_init(&parser);
+  s.hdr_info.client_request.create(HTTP_TYPE_REQUEST);
+  s.hdr_info.client_request.parse_req(&parser, &start, start + strlen(start), true);
+  http_parser_clear(&parser);
+  s.method = s.hdr_info.client_request.method_get_wksidx();
+  s.setup_per_txn_configs();
+  s.my_txn_conf().number_of_redirections = scenario.redirections;
+  ParentConfigParams *configured_parents = s.parent_params;
+  if (parents) {
+    // Keep the parents up, so that every run fails over in the same way.
+    s.parent_params                          = parents;
+    s.my_txn_conf().disable_parent_markdowns = 1;
+  }
+
+  TransactEntryFunc_t next = HttpTransact::ModifyRequest;
+  for (int steps = 0; next != nullptr && steps < 64; ++steps) {
+    next(&s);
+    next = s.transact_return_point;
+
+    switch (s.next_action) {
+    case HttpTransact::SM_ACTION_API_SM_START:
+    case HttpTransact::SM_ACTION_API_READ_REQUEST_HDR:
+    case HttpTransact::SM_ACTION_API_PRE_REMAP:
+    case HttpTransact::SM_ACTION_API_POST_REMAP:
+    case HttpTransact::SM_ACTION_API_OS_DNS:
+    case HttpTransact::SM_ACTION_API_SEND_REQUEST_HDR:
+    case HttpTransact::SM_ACTION_API_READ_CACHE_HDR:
+    case HttpTransact::SM_ACTION_API_READ_RESPONSE_HDR:
+    case HttpTransact::SM_ACTION_API_CACHE_LOOKUP_COMPLETE:
+    case HttpTransact::SM_ACTION_POST_REMAP_SKIP:
+      // No plugins.
+      break;
+
+    case HttpTransact::SM_ACTION_REMAP_REQUEST:
+      // The requests carry their origin in the URL, take them as mapped.
+      s.url_remap_success = true;
+      break;
+
+    case HttpTransact::SM_ACTION_DNS_LOOKUP:
+      // Only literal addresses, which need no HostDB.
+      if (!s.dns_info.resolve_immediate()) {
+        next = nullptr;
+      }
+      break;
+
+    case HttpTransact::SM_ACTION_CACHE_LOOKUP:
+      if (scenario.cached) {
+        HTTPHdr response;
+
+        parse_response(&response, scenario.cached);
+        cached.create();
+        cached.request_set(&s.hdr_info.client_request);
+        cached.response_set(&response);
+        cached.request_sent_time_set(ink_local_time());
+        cached.response_received_time_set(ink_local_time());
+        cached.object_size_set(response.get_content_length());
+        response.destroy();
+        s.cache_info.object_read   = &cached;
+        s.cache_info.hit_miss_code = SQUID_HIT_RAM;
+        s.source                   = HttpTransact::SOURCE_CACHE;
+      } else {
+        s.cache_lookup_result = HttpTransact::CACHE_LOOKUP_MISS;
+      }
+      next = HttpTransact::HandleCacheOpenRead;
+      break;
+
+    case HttpTransact::SM_ACTION_CACHE_ISSUE_WRITE:
+      s.cache_info.write_lock_state = HttpTransact::CACHE_WL_SUCCESS;
+      break;
+
+    case HttpTransact::SM_ACTION_ORIGIN_SERVER_OPEN:
+      if (origin < static_cast<int>(countof(scenario.origin)) && scenario.origin[origin]) {
+        s.current.server->clear_connect_fail();
+        parse_response(&s.hdr_info.server_response, scenario.origin[origin]);
+        s.current.state = HttpTransact::CONNECTION_ALIVE;
+      } else {
+        s.set_connect_fail(ECONNREFUSED);
+        s.current.state = HttpTransact::CONNECTION_ERROR;
+      }
+      ++origin;
+      next = HttpTransact::HandleResponse;
+      break;
+
+    case HttpTransact::SM_ACTION_SERVER_READ:
+      // Follow redirects as HttpSM::do_redirect() does.
+      if (sm->enable_redirection && sm->redirection_tries < s.txn_conf->number_of_redirections && sm->is_redirect_required()) {
+        int length      = 0;
+        const char *url = s.hdr_info.client_response.value_get(MIME_FIELD_LOCATION, MIME_LEN_LOCATION, &length);
+        if (url != nullptr) {
+          ++sm->redirection_tries;
+          sm->redirect_request(url, length);
+          next = HttpTransact::HandleRequest;
+          break;
+        }
+      }
+      next = nullptr;
+      break;
+
+    default:
+      // Serving the response, from the cache, the origin or an error.
+      next = nullptr;
+      break;
+    }
+  }
+
+  result.last   = s.next_action;
+  result.status = s.hdr_info.client_response.valid() ? s.hdr_info.client_response.status_get() : HTTP_STATUS_NONE;
+  result.heaps  = held_header_heaps(thread) - heaps;
+
+  s.cache_info.object_read = nullptr;
+  s.parent_params          = configured_parents;
+  cached.destroy();
+  sm->destroy();
+
+  return result;
+}
+} // namespace
+
+REGRESSION_TEST(HttpTransact_replay)(RegressionTest *t, int level, int *pstatus)
+{
+  int const iterations = level < REGRESSION_TEST_NIGHTLY ? 100 : 10000;
+  *pstatus             = REGRESSION_TEST_PASSED;
+
+  for (auto const &scenario : replay_scenarios) {
+    ParentConfigParams *parents = nullptr;
+
+    if (scenario.parents) {
+      P_table *table = new P_table("", "HttpTransact replay", &http_dest_tags,
+                                   ALLOW_HOST_TABLE | ALLOW_REGEX_TABLE | ALLOW_URL_TABLE | ALLOW_IP_TABLE | DONT_BUILD_TABLE);
+      std::string rules(scenario.parents);
+
+      table->BuildTableFromString(rules.data());
+      parents = new ParentConfigParams(table);
+    }
+
+    // The first run warms up the thread allocators, so that the heap counts are the same for every run.
+    ReplayResult result = replay_transaction(scenario, parents);
+
+    if (result.status != scenario.status || result.last != scenario.last) {
+      rprintf(t, "%s: got status %d after %s, expected %d after %s\n", scenario.name, result.status,
+              HttpDebugNames::get_action_name(result.last), scenario.status, HttpDebugNames::get_action_name(scenario.last));
+      *pstatus = REGRESSION_TEST_FAILED;
+      delete parents;
+      continue;
+    }
+
+    ink_hrtime start = Thread::get_hrtime_updated();
+    for (int i = 0; i < iterations; ++i) {
+      result = replay_transaction(scenario, parents);
+    }
+    ink_hrtime elapsed = Thread::get_hrtime_updated() - start;
+    delete parents;
+
+    rprintf(t, "%-16s %8" PRId64 " ns/transaction %4d header heaps\n", scenario.name, elapsed / iterations, result.heaps);
+  }
+}
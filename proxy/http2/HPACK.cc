@@ -413,6 +413,12 @@ HpackIndexingTable::update_maximum_size(uint32_t new_size)
   _dynamic_table.update_maximum_size(new_size);
 }
 
+void
+HpackIndexingTable::compact()
+{
+  _dynamic_table.compact();
+}
+
 //
 // HpackDynamicTable
 //
@@ -536,6 +542,41 @@ HpackDynamicTable::length() const
   return this->_headers.size();
 }
 
+/**
+   Copy the live entries into a new MIMEHdr and HdrHeap and free the current ones, dropping the
+   space left behind by evicted entries. The order of the entries, and so their indexes, is kept.
+ */
+void
+HpackDynamicTable::compact()
+{
+  MIMEHdr *mhdr = new MIMEHdr();
+  mhdr->create();
+
+  std::deque<MIMEField *> headers;
+  for (auto h : this->_headers) {
+    std::string_view name  = h->name_get();
+    std::string_view value = h->value_get();
+
+    MIMEField *new_field = mhdr->field_create(name.data(), name.size());
+    new_field->value_set(mhdr->m_heap, mhdr->m_mime, value.data(), value.size());
+    mhdr->field_attach(new_field);
+    headers.push_back(new_field);
+  }
+  this->_headers.swap(headers);
+
+  this->_mhdr->fields_clear();
+  this->_mhdr->destroy();
+  delete this->_mhdr;
+  this->_mhdr = mhdr;
+
+  if (this->_mhdr_old != nullptr) {
+    this->_mhdr_old->fields_clear();
+    this->_mhdr_old->destroy();
+    delete this->_mhdr_old;
+    this->_mhdr_old = nullptr;
+  }
+}
+
 void
 HpackDynamicTable::_evict_overflowed_entries()
 {
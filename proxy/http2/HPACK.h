@@ -127,6 +127,7 @@ public:
   void update_maximum_size(uint32_t new_size);
 
   uint32_t length() const;
+  void compact();
 
 private:
   void _evict_overflowed_entries();
@@ -158,6 +159,7 @@ public:
   uint32_t maximum_size() const;
   uint32_t size() const;
   void update_maximum_size(uint32_t new_size);
+  void compact();
 
 private:
   HpackDynamicTable _dynamic_table;
@@ -208,6 +208,13 @@ Http2ClientSession::main_event_handler(int event, void *edata)
     retval = 0;
     break;
 
+  case NET_EVENT_PARKED:
+    // Idle in the keep-alive queue, give back the slack in the HPACK tables
+    this->connection_state.local_hpack_handle->compact();
+    this->connection_state.peer_hpack_handle->compact();
+    retval = 0;
+    break;
+
   case HTTP2_SESSION_EVENT_XMIT:
   default:
     Http2SsnDebug("unexpected event=%d edata=%p", event, edata);
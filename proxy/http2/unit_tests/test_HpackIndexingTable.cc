@@ -519,4 +519,39 @@ TEST_CASE("HPACK high level APIs", "[hpack]")
       CHECK(len == HPACK_ERROR_COMPRESSION_ERROR);
     }
   }
+
+  SECTION("compact")
+  {
+    HpackIndexingTable indexing_table(128);
+
+    // evict a few entries so the table leaves some dead space behind
+    for (int i = 0; i < 8; ++i) {
+      std::string value = "value-" + std::to_string(i);
+      indexing_table.add_header_field({"x-test", value});
+    }
+    uint32_t const size = indexing_table.size();
+
+    indexing_table.compact();
+    CHECK(indexing_table.size() == size);
+
+    // the newest entry keeps the first dynamic index, 62
+    HpackLookupResult result = indexing_table.lookup({"x-test", "value-7"});
+    CHECK(result.index == 62);
+    CHECK(result.index_type == HpackIndex::DYNAMIC);
+    CHECK(result.match_type == HpackMatch::EXACT);
+
+    result = indexing_table.lookup({"x-test", "value-6"});
+    CHECK(result.index == 63);
+    CHECK(result.match_type == HpackMatch::EXACT);
+
+    // evicted entries stay gone
+    result = indexing_table.lookup({"x-test", "value-0"});
+    CHECK(result.match_type == HpackMatch::NONE);
+
+    // the table is still usable after compaction
+    indexing_table.add_header_field({"x-test", "value-8"});
+    result = indexing_table.lookup({"x-test", "value-8"});
+    CHECK(result.index == 62);
+    CHECK(result.match_type == HpackMatch::EXACT);
+  }
 }
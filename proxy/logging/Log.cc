@@ -55,6 +55,10 @@
 
 #include "MgmtDefs.h"
 
+#include <algorithm>
+#include <vector>
+#include <sys/uio.h>
+
 #define PERIODIC_TASKS_INTERVAL_FALLBACK 5
 
 // Log global objects
@@ -1301,14 +1305,132 @@ Log::preproc_thread_main(void *args)
   return nullptr;
 }
 
+/*-------------------------------------------------------------------------
+  Log::flush_thread_main
+
+  The flush thread writes the data handed off by the preproc threads to the
+  log files.  Every pass takes the whole flush_data_list, groups the entries
+  by destination file and writes each group with as few writev(2) calls as
+  possible.  Data for any one file is written in the order it was queued,
+  which is the order the preproc threads handed it off; there is no
+  ordering between different files.
+  -------------------------------------------------------------------------*/
+
+static int
+flush_data_bytes(LogFlushData *fdata)
+{
+  LogFile *logfile = fdata->m_logfile.get();
+
+  if (logfile->m_file_format == LOG_FILE_BINARY) {
+    return static_cast<LogBuffer *>(fdata->m_data)->header()->byte_count;
+  } else if (logfile->m_file_format == LOG_FILE_ASCII || logfile->m_file_format == LOG_FILE_PIPE ||
+             logfile->m_file_format == LOG_FILE_COLUMNAR) {
+    return fdata->m_len;
+  }
+
+  ink_release_assert(!"Unknown file format type!");
+  return 0;
+}
+
+static char *
+flush_data_buf(LogFlushData *fdata)
+{
+  if (fdata->m_logfile->m_file_format == LOG_FILE_BINARY) {
+    return reinterpret_cast<char *>(static_cast<LogBuffer *>(fdata->m_data)->header());
+  }
+  return static_cast<char *>(fdata->m_data);
+}
+
+// Write count entries, all destined to the same file, then delete them.
+static void
+flush_data_batch(LogFlushData **batch, int count, ProxyMutex *mutex)
+{
+  LogFile *logfile = batch[0]->m_logfile.get();
+  struct iovec iov[LOG_FLUSH_MAX_IOV];
+  int64_t total_bytes = 0, bytes_written = 0;
+
+  ink_assert(count <= LOG_FLUSH_MAX_IOV);
+  for (int i = 0; i < count; ++i) {
+    iov[i].iov_base = flush_data_buf(batch[i]);
+    iov[i].iov_len  = flush_data_bytes(batch[i]);
+    total_bytes    += iov[i].iov_len;
+  }
+
+  // make sure we're open & ready to write
+  logfile->check_fd();
+  if (!logfile->is_open()) {
+    SiteThrottledWarning("File:%s was closed, have dropped (%" PRId64 ") bytes.", logfile->get_name(), total_bytes);
+
+    RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_lost_before_written_to_disk_stat, total_bytes);
+    for (int i = 0; i < count; ++i) {
+      delete batch[i];
+    }
+    return;
+  }
+
+  int logfilefd = logfile->get_fd();
+  // This should always be true because we just checked it.
+  ink_assert(logfilefd >= 0);
+
+  // write *all* data to target file as much as possible
+  //
+  struct iovec *next = iov;
+  int remaining      = count;
+  while (total_bytes - bytes_written) {
+    if (Log::config->logging_space_exhausted) {
+      Debug("log", "logging space exhausted, failed to write file:%s, have dropped (%" PRId64 ") bytes.", logfile->get_name(),
+            (total_bytes - bytes_written));
+
+      RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_lost_before_written_to_disk_stat,
+                     total_bytes - bytes_written);
+      break;
+    }
+
+    ssize_t len = ::writev(logfilefd, next, remaining);
+    RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_flush_writes_stat, 1);
+
+    if (len < 0) {
+      SiteThrottledError("Failed to write log to %s: [tried %" PRId64 ", wrote %" PRId64 ", %s]", logfile->get_name(),
+                         total_bytes - bytes_written, bytes_written, strerror(errno));
+
+      RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_lost_before_written_to_disk_stat,
+                     total_bytes - bytes_written);
+      break;
+    }
+    Debug("log", "Successfully wrote some stuff to %s", logfile->get_name());
+    bytes_written += len;
+
+    // skip over the vectors that were completely written, and trim the
+    // first one that was partially written
+    while (remaining > 0 && static_cast<size_t>(len) >= next->iov_len) {
+      len -= next->iov_len;
+      ++next;
+      --remaining;
+    }
+    if (remaining > 0) {
+      next->iov_base  = static_cast<char *>(next->iov_base) + len;
+      next->iov_len  -= len;
+    }
+  }
+
+  RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_written_to_disk_stat, bytes_written);
+
+  if (logfile->m_log) {
+    ink_atomic_increment(&logfile->m_log->m_bytes_written, bytes_written);
+  }
+
+  for (int i = 0; i < count; ++i) {
+    delete batch[i];
+  }
+}
+
 void *
 Log::flush_thread_main(void * /* args ATS_UNUSED */)
 {
-  LogBuffer *logbuffer;
   LogFlushData *fdata;
   ink_hrtime now, last_time = 0;
-  int len, total_bytes;
-  SLL<LogFlushData, LogFlushData::Link_link> link, invert_link;
+  SLL<LogFlushData, LogFlushData::Link_link> link;
+  std::vector<LogFlushData *> pending;
   ProxyMutex *mutex = this_thread()->mutex.get();
 
   Log::flush_notify->lock();
@@ -1319,83 +1441,29 @@ Log::flush_thread_main(void * /* args ATS_UNUSED */)
     }
     fdata = static_cast<LogFlushData *>(ink_atomiclist_popall(flush_data_list));
 
-    // invert the list
+    // the list comes back newest first, restore the order it was queued in
     //
     link.head = fdata;
     while ((fdata = link.pop())) {
-      invert_link.push(fdata);
+      pending.push_back(fdata);
     }
+    std::reverse(pending.begin(), pending.end());
 
-    // process each flush data
+    // group the flush data by file, keeping the queued order within each
+    // file, then write each group out with vectored writes
     //
-    while ((fdata = invert_link.pop())) {
-      char *buf         = nullptr;
-      int bytes_written = 0;
-      LogFile *logfile  = fdata->m_logfile.get();
+    std::stable_sort(pending.begin(), pending.end(),
+                     [](LogFlushData *a, LogFlushData *b) { return a->m_logfile.get() < b->m_logfile.get(); });
 
-      if (logfile->m_file_format == LOG_FILE_BINARY) {
-        logbuffer                      = static_cast<LogBuffer *>(fdata->m_data);
-        LogBufferHeader *buffer_header = logbuffer->header();
-
-        buf         = reinterpret_cast<char *>(buffer_header);
-        total_bytes = buffer_header->byte_count;
-
-      } else if (logfile->m_file_format == LOG_FILE_ASCII || logfile->m_file_format == LOG_FILE_PIPE) {
-        buf         = static_cast<char *>(fdata->m_data);
-        total_bytes = fdata->m_len;
-
-      } else {
-        ink_release_assert(!"Unknown file format type!");
-      }
-
-      // make sure we're open & ready to write
-      logfile->check_fd();
-      if (!logfile->is_open()) {
-        SiteThrottledWarning("File:%s was closed, have dropped (%d) bytes.", logfile->get_name(), total_bytes);
-
-        RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_lost_before_written_to_disk_stat, total_bytes);
-        delete fdata;
-        continue;
+    for (size_t i = 0; i < pending.size();) {
+      size_t n = 1;
+      while (i + n < pending.size() && n < LOG_FLUSH_MAX_IOV && pending[i + n]->m_logfile == pending[i]->m_logfile) {
+        ++n;
       }
-
-      int logfilefd = logfile->get_fd();
-      // This should always be true because we just checked it.
-      ink_assert(logfilefd >= 0);
-
-      // write *all* data to target file as much as possible
-      //
-      while (total_bytes - bytes_written) {
-        if (Log::config->logging_space_exhausted) {
-          Debug("log", "logging space exhausted, failed to write file:%s, have dropped (%d) bytes.", logfile->get_name(),
-                (total_bytes - bytes_written));
-
-          RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_lost_before_written_to_disk_stat,
-                         total_bytes - bytes_written);
-          break;
-        }
-
-        len = ::write(logfilefd, &buf[bytes_written], total_bytes - bytes_written);
-
-        if (len < 0) {
-          SiteThrottledError("Failed to write log to %s: [tried %d, wrote %d, %s]", logfile->get_name(),
-                             total_bytes - bytes_written, bytes_written, strerror(errno));
-
-          RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_lost_before_written_to_disk_stat,
-                         total_bytes - bytes_written);
-          break;
-        }
-        Debug("log", "Successfully wrote some stuff to %s", logfile->get_name());
-        bytes_written += len;
-      }
-
-      RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_written_to_disk_stat, bytes_written);
-
-      if (logfile->m_log) {
-        ink_atomic_increment(&logfile->m_log->m_bytes_written, bytes_written);
-      }
-
-      delete fdata;
+      flush_data_batch(&pending[i], n, mutex);
+      i += n;
     }
+    pending.clear();
 
     // Time to work on periodic events??
     //
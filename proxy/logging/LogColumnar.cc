@@ -0,0 +1,338 @@
+/** @file
+
+  Columnar log file output.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <vector>
+
+#include "tscore/ink_platform.h"
+#include "tscore/ink_align.h"
+#include "fastlz/fastlz.h"
+
+#include "LogField.h"
+#include "LogFormat.h"
+#include "LogBuffer.h"
+#include "LogColumnar.h"
+
+namespace
+{
+// fastlz needs at least 16 bytes of input, and an output buffer 5% larger
+// than the input but never smaller than 66 bytes.
+constexpr uint32_t MIN_COMPRESS_LEN = 16;
+
+inline uint32_t
+compress_bound(uint32_t len)
+{
+  return len + len / 16 + 66;
+}
+
+inline uint32_t
+padded(uint32_t len)
+{
+  return INK_ALIGN_DEFAULT(len);
+}
+
+/// Store @a len bytes of column data at @a dst, compressing it if that saves space.
+/// @return The number of bytes consumed at @a dst, including header and padding.
+uint32_t
+put_column(char *dst, const char *data, uint32_t len)
+{
+  LogColumnarColumnHeader *col = reinterpret_cast<LogColumnarColumnHeader *>(dst);
+  char *out                    = dst + sizeof(LogColumnarColumnHeader);
+  int stored                   = 0;
+
+  if (len >= MIN_COMPRESS_LEN) {
+    stored = fastlz_compress_level(1, data, len, out);
+  }
+  if (stored <= 0 || static_cast<uint32_t>(stored) >= len) {
+    memcpy(out, data, len);
+    stored = len;
+  }
+
+  col->raw_len    = len;
+  col->stored_len = stored;
+  memset(out + stored, 0, padded(stored) - stored);
+
+  return sizeof(LogColumnarColumnHeader) + padded(stored);
+}
+
+/// Load the column at @a src, which must not extend past @a end, into @a data.
+/// @a data is zero padded past the column so unmarshaling corrupt values cannot run off of it.
+/// @return The number of bytes consumed at @a src, or 0 if the column is malformed.
+uint32_t
+get_column(const char *src, const char *end, std::vector<char> &data)
+{
+  if (end - src < static_cast<ptrdiff_t>(sizeof(LogColumnarColumnHeader))) {
+    return 0;
+  }
+
+  const LogColumnarColumnHeader *col = reinterpret_cast<const LogColumnarColumnHeader *>(src);
+  const char *in                     = src + sizeof(LogColumnarColumnHeader);
+  uint32_t consumed                  = sizeof(LogColumnarColumnHeader) + padded(col->stored_len);
+
+  if (col->stored_len > col->raw_len || end - src < static_cast<ptrdiff_t>(consumed)) {
+    return 0;
+  }
+
+  data.assign(col->raw_len + LOG_MAX_FORMATTED_LINE, 0);
+  if (col->stored_len == col->raw_len) {
+    memcpy(data.data(), in, col->raw_len);
+  } else if (fastlz_decompress(in, col->stored_len, data.data(), col->raw_len) != static_cast<int>(col->raw_len)) {
+    return 0;
+  }
+
+  return consumed;
+}
+
+} // namespace
+
+char *
+LogColumnar::encode(LogBufferHeader *buffer_header, LogFieldList *fieldlist, int *block_len)
+{
+  ink_assert(buffer_header != nullptr);
+  ink_assert(fieldlist != nullptr);
+
+  if (buffer_header->version != LOG_SEGMENT_VERSION || buffer_header->format_type != LOG_FORMAT_CUSTOM) {
+    Note("Cannot write LogBuffer version %d, format type %d, as a columnar block", buffer_header->version,
+         buffer_header->format_type);
+    return nullptr;
+  }
+
+  char *fieldlist_str = buffer_header->fmt_fieldlist();
+  char *printf_str    = buffer_header->fmt_printf();
+  uint32_t n_fields   = fieldlist->count();
+  uint32_t n_entries  = buffer_header->entry_count;
+
+  if (!fieldlist_str || !printf_str || n_fields == 0) {
+    return nullptr;
+  }
+
+  // Split every entry into its fields.  The field lengths are kept so that
+  // the copy into the columns below does not have to measure them again.
+  std::vector<uint32_t> lens(static_cast<size_t>(n_entries) * n_fields);
+  std::vector<uint32_t> col_len(n_fields + 1, 0);
+  LogBufferIterator iter(buffer_header);
+  LogEntryHeader *entry_header;
+  uint32_t n = 0;
+
+  col_len[0] = n_entries * sizeof(LogEntryHeader);
+  while ((entry_header = iter.next()) && n < n_entries) {
+    char *read_from = reinterpret_cast<char *>(entry_header) + sizeof(LogEntryHeader);
+    uint32_t avail  = entry_header->entry_len - sizeof(LogEntryHeader);
+    uint32_t used   = 0;
+    uint32_t col    = 1;
+
+    for (LogField *f = fieldlist->first(); f; f = fieldlist->next(f), ++col) {
+      uint32_t len = f->marshaled_len(read_from + used);
+      if (used + len > avail) {
+        Note("Entry %u of LogBuffer does not match format %s, not writing columnar block", n, fieldlist_str);
+        return nullptr;
+      }
+      lens[static_cast<size_t>(n) * n_fields + col - 1] = len;
+      col_len[col]                                      += len;
+      used                                              += len;
+    }
+    ++n;
+  }
+  if (n != n_entries) {
+    return nullptr;
+  }
+
+  // Transpose the entries into one contiguous run of columns.
+  std::vector<char *> col_data(n_fields + 1);
+  uint32_t raw_total = 0;
+  for (uint32_t c = 0; c <= n_fields; ++c) {
+    raw_total += col_len[c];
+  }
+  char *raw   = static_cast<char *>(ats_malloc(raw_total ? raw_total : 1));
+  col_data[0] = raw;
+  for (uint32_t c = 1; c <= n_fields; ++c) {
+    col_data[c] = col_data[c - 1] + col_len[c - 1];
+  }
+
+  std::vector<char *> cursor(col_data);
+  LogBufferIterator copy_iter(buffer_header);
+  n = 0;
+  while ((entry_header = copy_iter.next()) && n < n_entries) {
+    char *read_from  = reinterpret_cast<char *>(entry_header) + sizeof(LogEntryHeader);
+    uint32_t *e_lens = &lens[static_cast<size_t>(n) * n_fields];
+    LogEntryHeader ts;
+
+    ts.timestamp      = entry_header->timestamp;
+    ts.timestamp_usec = entry_header->timestamp_usec;
+    ts.entry_len      = sizeof(LogEntryHeader);
+    for (uint32_t c = 0; c < n_fields; ++c) {
+      memcpy(cursor[c + 1], read_from, e_lens[c]);
+      cursor[c + 1] += e_lens[c];
+      read_from     += e_lens[c];
+      ts.entry_len  += e_lens[c];
+    }
+    memcpy(cursor[0], &ts, sizeof(ts));
+    cursor[0] += sizeof(ts);
+    ++n;
+  }
+
+  // Lay down the block header, the format strings and the stored columns.
+  uint32_t fieldlist_len = padded(strlen(fieldlist_str) + 1);
+  uint32_t printf_len    = padded(strlen(printf_str) + 1);
+  uint32_t max_len       = sizeof(LogColumnarBlockHeader) + fieldlist_len + printf_len;
+  for (uint32_t c = 0; c <= n_fields; ++c) {
+    max_len += sizeof(LogColumnarColumnHeader) + padded(compress_bound(col_len[c]));
+  }
+
+  char *block                    = static_cast<char *>(ats_malloc(max_len));
+  LogColumnarBlockHeader *header = reinterpret_cast<LogColumnarBlockHeader *>(block);
+  uint32_t offset                = sizeof(LogColumnarBlockHeader);
+
+  memset(block + offset, 0, fieldlist_len + printf_len);
+  ink_strlcpy(block + offset, fieldlist_str, fieldlist_len);
+  offset += fieldlist_len;
+  ink_strlcpy(block + offset, printf_str, printf_len);
+  offset += printf_len;
+
+  for (uint32_t c = 0; c <= n_fields; ++c) {
+    offset += put_column(block + offset, col_data[c], col_len[c]);
+  }
+  ats_free(raw);
+
+  header->magic          = LOG_COLUMNAR_MAGIC;
+  header->version        = LOG_COLUMNAR_VERSION;
+  header->codec          = LOG_COLUMNAR_CODEC_FASTLZ;
+  header->block_len      = offset;
+  header->entry_count    = n_entries;
+  header->column_count   = n_fields;
+  header->low_timestamp  = buffer_header->low_timestamp;
+  header->high_timestamp = buffer_header->high_timestamp;
+  header->fieldlist_len  = fieldlist_len;
+  header->printf_len     = printf_len;
+  header->reserved       = 0;
+
+  *block_len = offset;
+  return block;
+}
+
+LogBufferHeader *
+LogColumnar::decode(const LogColumnarBlockHeader *block)
+{
+  ink_assert(block != nullptr);
+
+  if (block->magic != LOG_COLUMNAR_MAGIC || block->version != LOG_COLUMNAR_VERSION ||
+      (block->codec != LOG_COLUMNAR_CODEC_NONE && block->codec != LOG_COLUMNAR_CODEC_FASTLZ)) {
+    return nullptr;
+  }
+
+  const char *src = reinterpret_cast<const char *>(block);
+  const char *end = src + block->block_len;
+  const char *ptr = src + sizeof(LogColumnarBlockHeader);
+
+  if (block->block_len < sizeof(LogColumnarBlockHeader) || end - ptr < static_cast<ptrdiff_t>(block->fieldlist_len) ||
+      end - ptr - block->fieldlist_len < block->printf_len) {
+    return nullptr;
+  }
+
+  const char *fieldlist_str = ptr;
+  const char *printf_str    = ptr + block->fieldlist_len;
+  if (!memchr(fieldlist_str, 0, block->fieldlist_len) || !memchr(printf_str, 0, block->printf_len)) {
+    return nullptr;
+  }
+  ptr += block->fieldlist_len + block->printf_len;
+
+  LogFieldList fieldlist;
+  bool contains_aggregates = false;
+  if (LogFormat::parse_symbol_string(fieldlist_str, &fieldlist, &contains_aggregates) < 0 ||
+      fieldlist.count() != block->column_count) {
+    return nullptr;
+  }
+
+  std::vector<std::vector<char>> columns(block->column_count + 1);
+  for (auto &column : columns) {
+    uint32_t consumed = get_column(ptr, end, column);
+    if (consumed == 0) {
+      return nullptr;
+    }
+    ptr += consumed;
+  }
+
+  // The padding added by get_column is not part of the data.
+  uint64_t data_len = 0;
+  for (auto &column : columns) {
+    data_len += column.size() - LOG_MAX_FORMATTED_LINE;
+  }
+  if (columns[0].size() - LOG_MAX_FORMATTED_LINE != static_cast<uint64_t>(block->entry_count) * sizeof(LogEntryHeader)) {
+    return nullptr;
+  }
+
+  // Rebuild the segment exactly as LogBuffer would have laid it down.
+  uint32_t header_len = padded(sizeof(LogBufferHeader) + block->fieldlist_len + block->printf_len);
+  uint64_t byte_count = header_len + data_len;
+  if (byte_count > UINT32_MAX) {
+    return nullptr;
+  }
+
+  char *segment                  = static_cast<char *>(ats_malloc(byte_count));
+  LogBufferHeader *buffer_header = reinterpret_cast<LogBufferHeader *>(segment);
+
+  memset(segment, 0, header_len);
+  buffer_header->cookie               = LOG_SEGMENT_COOKIE;
+  buffer_header->version              = LOG_SEGMENT_VERSION;
+  buffer_header->format_type          = LOG_FORMAT_CUSTOM;
+  buffer_header->byte_count           = byte_count;
+  buffer_header->entry_count          = block->entry_count;
+  buffer_header->low_timestamp        = block->low_timestamp;
+  buffer_header->high_timestamp       = block->high_timestamp;
+  buffer_header->fmt_fieldlist_offset = sizeof(LogBufferHeader);
+  buffer_header->fmt_printf_offset    = sizeof(LogBufferHeader) + block->fieldlist_len;
+  buffer_header->data_offset          = header_len;
+  memcpy(segment + buffer_header->fmt_fieldlist_offset, fieldlist_str, block->fieldlist_len);
+  memcpy(segment + buffer_header->fmt_printf_offset, printf_str, block->printf_len);
+
+  std::vector<char *> cursor(columns.size());
+  std::vector<char *> col_end(columns.size());
+  for (size_t c = 0; c < columns.size(); ++c) {
+    cursor[c]  = columns[c].data();
+    col_end[c] = columns[c].data() + columns[c].size() - LOG_MAX_FORMATTED_LINE;
+  }
+
+  char *write_to = segment + header_len;
+  char *seg_end  = segment + byte_count;
+  for (uint32_t n = 0; n < block->entry_count; ++n) {
+    LogEntryHeader *entry_header = reinterpret_cast<LogEntryHeader *>(write_to);
+
+    memcpy(entry_header, cursor[0], sizeof(LogEntryHeader));
+    cursor[0] += sizeof(LogEntryHeader);
+    write_to  += sizeof(LogEntryHeader);
+
+    size_t c = 1;
+    for (LogField *f = fieldlist.first(); f; f = fieldlist.next(f), ++c) {
+      uint32_t len = f->marshaled_len(cursor[c]);
+      if (cursor[c] + len > col_end[c] || write_to + len > seg_end) {
+        ats_free(segment);
+        return nullptr;
+      }
+      memcpy(write_to, cursor[c], len);
+      cursor[c] += len;
+      write_to  += len;
+    }
+    entry_header->entry_len = write_to - reinterpret_cast<char *>(entry_header);
+  }
+
+  return buffer_header;
+}
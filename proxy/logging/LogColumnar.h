@@ -0,0 +1,110 @@
+/** @file
+
+  Columnar log file output.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_platform.h"
+
+struct LogBufferHeader;
+class LogFieldList;
+
+#define LOG_COLUMNAR_MAGIC   0x434c5354 // "TSLC" when read as bytes on little endian hosts
+#define LOG_COLUMNAR_VERSION 1
+
+/*-------------------------------------------------------------------------
+  Columnar log file layout
+
+  A columnar log file is a sequence of self-contained blocks, one per
+  LogBuffer flushed by the proxy.  Each block is laid out as follows; all
+  integers are in host byte order and every section starts on an 8 byte
+  boundary.
+
+      LogColumnarBlockHeader
+      field symbol list   (NUL terminated, e.g. "chi,cqtx,pssc")
+      printf string       (NUL terminated, the format's printf template)
+      column 0            (one LogEntryHeader per entry, the timestamps)
+      column 1 .. N       (one column per field in the symbol list)
+
+  Every column is a LogColumnarColumnHeader followed by stored_len bytes of
+  data.  Uncompressed, a column is the concatenation of each entry's value
+  for that field in exactly the marshaled form the proxy wrote into the
+  LogBuffer.  If stored_len is smaller than raw_len the column data is
+  compressed with the block's codec.
+
+  Because values are never converted to text on the proxy, a block can be
+  turned back into a LogBuffer and formatted by traffic_logcat, or read
+  column by column by external tools.
+  -------------------------------------------------------------------------*/
+
+enum LogColumnarCodec {
+  LOG_COLUMNAR_CODEC_NONE   = 0,
+  LOG_COLUMNAR_CODEC_FASTLZ = 1,
+};
+
+struct LogColumnarBlockHeader {
+  uint32_t magic;          // LOG_COLUMNAR_MAGIC
+  uint16_t version;        // LOG_COLUMNAR_VERSION
+  uint16_t codec;          // LogColumnarCodec used by compressed columns
+  uint32_t block_len;      // total bytes in this block, including this header
+  uint32_t entry_count;    // number of entries (rows) in every column
+  uint32_t column_count;   // number of field columns, not counting column 0
+  uint32_t low_timestamp;  // lowest timestamp value of entries
+  uint32_t high_timestamp; // highest timestamp value of entries
+  uint32_t fieldlist_len;  // padded bytes of the field symbol list
+  uint32_t printf_len;     // padded bytes of the printf string
+  uint32_t reserved;
+};
+
+struct LogColumnarColumnHeader {
+  uint32_t raw_len;    // bytes of the column once decompressed
+  uint32_t stored_len; // bytes of column data that follow this header, before padding
+};
+
+/*-------------------------------------------------------------------------
+  LogColumnar
+
+  Conversions between LogBuffer segments and columnar blocks.
+  -------------------------------------------------------------------------*/
+
+namespace LogColumnar
+{
+/** Transpose the entries of @a buffer_header into a columnar block.
+
+    @a fieldlist must describe the fields of the buffer, in the order of its
+    symbol list.  The block is allocated with @c ats_malloc and its length
+    is returned in @a block_len.
+
+    @return The block, or @c nullptr if the buffer could not be encoded.
+*/
+char *encode(LogBufferHeader *buffer_header, LogFieldList *fieldlist, int *block_len);
+
+/** Rebuild a LogBuffer segment from the columnar block at @a block.
+
+    The caller must have validated that @a block holds @c block_len bytes.
+    The segment is allocated with @c ats_malloc and may be formatted with
+    LogFile::write_ascii_logbuffer.
+
+    @return The segment, or @c nullptr if the block is malformed.
+*/
+LogBufferHeader *decode(const LogColumnarBlockHeader *block);
+} // namespace LogColumnar
@@ -557,6 +557,15 @@ LogConfig::register_stat_callbacks()
   RecRegisterRawStat(log_rsb, RECT_PROCESS, "proxy.process.log.bytes_lost_before_written_to_disk", RECD_INT, RECP_PERSISTENT,
                      (int)log_stat_bytes_lost_before_written_to_disk_stat, RecRawStatSyncSum);
   //
+  // buffers
+  //
+  RecRegisterRawStat(log_rsb, RECT_PROCESS, "proxy.process.log.buffer_checkout_retries", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)log_stat_buffer_checkout_retries_stat, RecRawStatSyncSum);
+  RecRegisterRawStat(log_rsb, RECT_PROCESS, "proxy.process.log.buffer_handoffs", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)log_stat_buffer_handoffs_stat, RecRawStatSyncSum);
+  RecRegisterRawStat(log_rsb, RECT_PROCESS, "proxy.process.log.flush_writes", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)log_stat_flush_writes_stat, RecRawStatSyncSum);
+  //
   // I/O
   //
   RecRegisterRawStat(log_rsb, RECT_PROCESS, "proxy.process.log.log_files_open", RECD_COUNTER, RECP_NON_PERSISTENT,
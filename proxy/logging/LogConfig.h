@@ -67,6 +67,11 @@ enum {
   log_stat_bytes_written_to_disk_stat,
   log_stat_bytes_lost_before_written_to_disk_stat,
 
+  // Logging Buffers
+  log_stat_buffer_checkout_retries_stat,
+  log_stat_buffer_handoffs_stat,
+  log_stat_flush_writes_stat,
+
   // Logging I/O
   log_stat_log_files_open_stat,
   log_stat_log_files_space_used_stat,
@@ -608,6 +608,43 @@ LogField::unmarshal(char **buf, char *dest, int len, LogEscapeType escape_type)
     m_unmarshal_func);
 }
 
+/*-------------------------------------------------------------------------
+  LogField::marshaled_len
+
+  Return the number of bytes the marshaled value at buf occupies in a
+  LogBuffer.  The common integer, string and address layouts are measured
+  directly; anything else is measured by unmarshaling it to a scratch area.
+  -------------------------------------------------------------------------*/
+unsigned
+LogField::marshaled_len(char *buf)
+{
+  // aggregate entries are always written as a single integer per field
+  if (m_agg_op != NO_AGGREGATE) {
+    return INK_MIN_ALIGN;
+  }
+
+  if (auto f = std::get_if<UnmarshalFuncWithSlice>(&m_unmarshal_func); f && *f == &LogAccess::unmarshal_str) {
+    return LogAccess::strlen(buf);
+  } else if (std::holds_alternative<UnmarshalFuncWithMap>(m_unmarshal_func)) {
+    return INK_MIN_ALIGN;
+  } else if (auto f = std::get_if<UnmarshalFunc>(&m_unmarshal_func); f) {
+    if (*f == &LogAccess::unmarshal_int_to_str || *f == &LogAccess::unmarshal_int_to_str_hex || *f == &LogAccess::unmarshal_ttmsf ||
+        *f == &LogAccess::unmarshal_http_status || *f == &LogAccess::unmarshal_int_to_date_str ||
+        *f == &LogAccess::unmarshal_int_to_time_str || *f == &LogAccess::unmarshal_int_to_netscape_str) {
+      return INK_MIN_ALIGN;
+    } else if (*f == &LogAccess::unmarshal_ip_to_str || *f == &LogAccess::unmarshal_ip_to_hex) {
+      IpEndpoint ip;
+      char *read_from = buf;
+      return LogAccess::unmarshal_ip(&read_from, &ip);
+    }
+  }
+
+  char scratch[LOG_MAX_FORMATTED_LINE];
+  char *read_from = buf;
+  unmarshal(&read_from, scratch, sizeof(scratch));
+  return read_from - buf;
+}
+
 /*-------------------------------------------------------------------------
   LogField::display
   -------------------------------------------------------------------------*/
@@ -140,6 +140,7 @@ public:
   unsigned marshal(LogAccess *lad, char *buf);
   unsigned marshal_agg(char *buf);
   unsigned unmarshal(char **buf, char *dest, int len, LogEscapeType escape_type = LOG_ESCAPE_NONE);
+  unsigned marshaled_len(char *buf);
   void display(FILE *fd = stdout);
   bool operator==(LogField &rhs);
   void updateField(LogAccess *lad, char *val, int len);
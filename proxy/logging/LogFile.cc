@@ -49,6 +49,7 @@
 #include "LogFilter.h"
 #include "LogFormat.h"
 #include "LogBuffer.h"
+#include "LogColumnar.h"
 #include "LogFile.h"
 #include "LogObject.h"
 #include "LogUtils.h"
@@ -217,7 +218,7 @@ LogFile::open_file()
   // file.
   //
   if (!file_exists) {
-    if (m_file_format != LOG_FILE_BINARY && m_header && m_log) {
+    if (m_file_format != LOG_FILE_BINARY && m_file_format != LOG_FILE_COLUMNAR && m_header && m_log) {
       Debug("log-file", "writing header to LogFile %s", m_name);
       writeln(m_header, strlen(m_header), fileno(m_log->m_fp), m_name);
     }
@@ -471,6 +472,10 @@ LogFile::preproc_and_try_delete(LogBuffer *lb)
   } else if (m_file_format == LOG_FILE_ASCII || m_file_format == LOG_FILE_PIPE) {
     write_ascii_logbuffer3(buffer_header);
     ret = 0;
+  } else if (m_file_format == LOG_FILE_COLUMNAR) {
+    if (write_columnar_logbuffer(lb) > 0) {
+      ret = 0;
+    }
   } else {
     Note("Cannot write LogBuffer to LogFile %s; invalid file format: %d", m_name, m_file_format);
   }
@@ -652,6 +657,46 @@ LogFile::write_ascii_logbuffer3(LogBufferHeader *buffer_header, const char *alt_
   return total_bytes;
 }
 
+/*-------------------------------------------------------------------------
+  LogFile::write_columnar_logbuffer
+
+  Transpose the given LogBuffer into a compressed columnar block (see
+  LogColumnar.h) and hand it to the flush thread.  The marshaled field
+  values are copied as they are, so no entry is converted to ASCII here.
+  -------------------------------------------------------------------------*/
+
+int
+LogFile::write_columnar_logbuffer(LogBuffer *lb)
+{
+  ProxyMutex *mutex              = this_thread()->mutex.get();
+  LogBufferHeader *buffer_header = lb->header();
+  LogObject *owner               = lb->get_owner();
+  int block_len                  = 0;
+  char *block                    = nullptr;
+
+  if (owner) {
+    block = LogColumnar::encode(buffer_header, &owner->m_format->m_field_list, &block_len);
+  }
+
+  if (block == nullptr) {
+    Note("Failed to convert LogBuffer to columnar, have dropped (%" PRIu32 ") bytes.", buffer_header->byte_count);
+    RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_num_lost_before_flush_to_disk_stat, buffer_header->entry_count);
+    RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_lost_before_flush_to_disk_stat, buffer_header->byte_count);
+    return 0;
+  }
+
+  LogFlushData *flush_data = new LogFlushData(this, block, block_len);
+
+  RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_num_flush_to_disk_stat, buffer_header->entry_count);
+  RecIncrRawStat(log_rsb, mutex->thread_holding, log_stat_bytes_flush_to_disk_stat, block_len);
+
+  ink_atomiclist_push(Log::flush_data_list, flush_data);
+
+  Log::flush_notify->signal();
+
+  return block_len;
+}
+
 bool
 LogFile::rolled_logfile(char *file)
 {
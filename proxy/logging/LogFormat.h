@@ -38,7 +38,8 @@ enum LogFormatType {
 enum LogFileFormat {
   LOG_FILE_BINARY,
   LOG_FILE_ASCII,
-  LOG_FILE_PIPE, // ie. ASCII pipe
+  LOG_FILE_PIPE,     // ie. ASCII pipe
+  LOG_FILE_COLUMNAR, // see LogColumnar.h
   N_LOGFILE_TYPES
 };
 
@@ -31,7 +31,8 @@
 enum {
   LOG_MAX_FORMAT_LINE      = 2048, /* "format:enable:..." */
   LOG_MAX_FORMATTED_BUFFER = 20480,
-  LOG_MAX_FORMATTED_LINE   = 10240
+  LOG_MAX_FORMATTED_LINE   = 10240,
+  LOG_FLUSH_MAX_IOV        = 64 /* buffers gathered into one writev */
 };
 
 #define LOG_KILOBYTE ((int64_t)1024)
@@ -117,6 +117,8 @@ LogObject::LogObject(LogConfig *cfg, const LogFormat *format, const char *log_di
     m_flags |= BINARY;
   } else if (file_format == LOG_FILE_PIPE) {
     m_flags |= WRITES_TO_PIPE;
+  } else if (file_format == LOG_FILE_COLUMNAR) {
+    m_flags |= COLUMNAR;
   }
 
   generate_filenames(log_dir, basename, file_format);
@@ -162,8 +164,8 @@ LogObject::~LogObject()
 //
 // 1.- 'stdout' and 'stderr' are treated as special strings indicating file
 //     descriptors for the stdout and stderr streams.
-// 2.- if no extension is given, add .log for ascii logs, and .blog for
-//     binary logs
+// 2.- if no extension is given, add .log for ascii logs, .blog for
+//     binary logs and .clog for columnar logs
 // 3.- if an extension is given, then do not modify filename and use that
 //     extension regardless of type of log
 // 4.- if there is a '.' at the end of the name, then do not add an extension
@@ -215,6 +217,10 @@ LogObject::generate_filenames(const char *log_dir, const char *basename, LogFile
       ext     = LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION;
       ext_len = 5;
       break;
+    case LOG_FILE_COLUMNAR:
+      ext     = LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION;
+      ext_len = 5;
+      break;
     default:
       ink_assert(!"unknown file format");
     }
@@ -281,7 +287,10 @@ LogObject::compute_signature(LogFormat *format, char *filename, unsigned int fla
     char *buffer = static_cast<char *>(ats_malloc(buf_size));
 
     ink_string_concatenate_strings(buffer, fl, ps, filename,
-                                   flags & LogObject::BINARY ? "B" : (flags & LogObject::WRITES_TO_PIPE ? "P" : "A"), NULL);
+                                   flags & LogObject::BINARY ?
+                                     "B" :
+                                     (flags & LogObject::WRITES_TO_PIPE ? "P" : (flags & LogObject::COLUMNAR ? "C" : "A")),
+                                   NULL);
 
     CryptoHash hash;
     CryptoContext().hash_immediate(hash, buffer, buf_size - 1);
@@ -376,6 +385,7 @@ LogObject::_checkout_write(size_t *write_offset, size_t bytes_needed)
           // so delete new_buffer and try again next loop iteration
           delete new_buffer;
           new_buffer = nullptr;
+          RecIncrRawStat(log_rsb, this_ethread(), log_stat_buffer_checkout_retries_stat, 1);
           break;
         }
       } while (write_pointer_version(&m_log_buffer, old_h, new_buffer, 0) == false);
@@ -383,10 +393,7 @@ LogObject::_checkout_write(size_t *write_offset, size_t bytes_needed)
       if (FREELIST_POINTER(old_h) == FREELIST_POINTER(h)) {
         ink_atomic_increment(&buffer->m_references, FREELIST_VERSION(old_h) - 1);
 
-        int idx = m_buffer_manager_idx++ % m_flush_threads;
-        Debug("log-logbuffer", "adding buffer %d to flush list after checkout", buffer->get_id());
-        m_buffer_manager[idx].add_to_flush_queue(buffer);
-        Log::preproc_notify[idx].signal();
+        flush_buffer(buffer);
         buffer = nullptr;
       }
 
@@ -396,6 +403,7 @@ LogObject::_checkout_write(size_t *write_offset, size_t bytes_needed)
     case LogBuffer::LB_RETRY:
       // no more room, but another thread should be taking care of creating a new buffer, so yield to let
       // the other thread finish, then try again
+      RecIncrRawStat(log_rsb, this_ethread(), log_stat_buffer_checkout_retries_stat, 1);
       std::this_thread::yield();
       break;
 
@@ -559,12 +567,18 @@ ThreadLocalLogBufferManager::thread_local_buffer(LogObject *o, size_t *offset, s
   return manager.current_buffer(o, offset, bytes_needed);
 }
 
+/*
+ * Hand a full (or expired) buffer off to a preproc thread.  Buffers of a LogObject are spread round robin across the
+ * preproc threads, so buffers are not guaranteed to reach the log file in the order they were handed off; entries
+ * within one buffer always stay in order.
+ */
 void
 LogObject::flush_buffer(LogBuffer *buffer)
 {
   int idx = m_buffer_manager_idx++ % m_flush_threads;
   Debug("log-logbuffer", "adding buffer %d to flush list after checkout", buffer->get_id());
   m_buffer_manager[idx].add_to_flush_queue(buffer);
+  RecIncrRawStat(log_rsb, this_ethread(), log_stat_buffer_handoffs_stat, 1);
   Log::preproc_notify[idx].signal();
 }
 
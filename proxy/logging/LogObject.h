@@ -48,6 +48,7 @@
 #define LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION  ".log"
 #define LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION ".blog"
 #define LOG_FILE_PIPE_OBJECT_FILENAME_EXTENSION   ".pipe"
+#define LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION ".clog"
 
 #define FLUSH_ARRAY_SIZE (512 * 4)
 
@@ -88,10 +89,12 @@ public:
     BINARY                   = 1,
     WRITES_TO_PIPE           = 4,
     LOG_OBJECT_FMT_TIMESTAMP = 8, // always format a timestamp into each log line (for raw text logs)
+    COLUMNAR                 = 16,
   };
 
   // BINARY: log is written in binary format (rather than ascii)
   // WRITES_TO_PIPE: object writes to a named pipe rather than to a file
+  // COLUMNAR: log is written in compressed columnar blocks (see LogColumnar.h)
 
   LogObject(LogConfig *cfg, const LogFormat *format, const char *log_dir, const char *basename, LogFileFormat file_format,
             const char *header, Log::RollingEnabledValues rolling_enabled, int flush_threads, int rolling_interval_sec = 0,
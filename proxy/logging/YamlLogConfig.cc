@@ -167,9 +167,13 @@ YamlLogConfig::decodeLogObject(const YAML::Node &node)
   LogFileFormat file_type = LOG_FILE_ASCII; // default value
   if (node["mode"]) {
     std::string mode = node["mode"].as<std::string>();
-    file_type        = (0 == strncasecmp(mode.c_str(), "bin", 3) || (1 == mode.size() && mode[0] == 'b') ?
-                          LOG_FILE_BINARY :
-                          (0 == strcasecmp(mode.c_str(), "ascii_pipe") ? LOG_FILE_PIPE : LOG_FILE_ASCII));
+    if (0 == strcasecmp(mode.c_str(), "columnar")) {
+      file_type = LOG_FILE_COLUMNAR;
+    } else {
+      file_type = (0 == strncasecmp(mode.c_str(), "bin", 3) || (1 == mode.size() && mode[0] == 'b') ?
+                     LOG_FILE_BINARY :
+                     (0 == strcasecmp(mode.c_str(), "ascii_pipe") ? LOG_FILE_PIPE : LOG_FILE_ASCII));
+    }
   }
 
   int obj_rolling_enabled      = cfg->rolling_enabled;
@@ -243,6 +247,9 @@ YamlLogConfig::decodeLogObject(const YAML::Node &node)
   case LOG_FILE_BINARY:
     ext = LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION;
     break;
+  case LOG_FILE_COLUMNAR:
+    ext = LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION;
+    break;
   default:
     break;
   }
@@ -169,5 +169,7 @@ const std::unordered_map<std::string_view, std::tuple<const TSOverridableConfigK
     {"proxy.config.http.parent_proxy.enable_parent_timeout_markdowns",
      {TS_CONFIG_HTTP_ENABLE_PARENT_TIMEOUT_MARKDOWNS, TS_RECORDDATATYPE_INT}                                                                    },
     {"proxy.config.http.parent_proxy.disable_parent_markdowns",        {TS_CONFIG_HTTP_DISABLE_PARENT_MARKDOWNS, TS_RECORDDATATYPE_INT}         },
-    {"proxy.config.net.default_inactivity_timeout",                    {TS_CONFIG_NET_DEFAULT_INACTIVITY_TIMEOUT, TS_RECORDDATATYPE_INT}        }
+    {"proxy.config.net.default_inactivity_timeout",                    {TS_CONFIG_NET_DEFAULT_INACTIVITY_TIMEOUT, TS_RECORDDATATYPE_INT}        },
+    {"proxy.config.http.cache.stale_while_revalidate",                 {TS_CONFIG_HTTP_CACHE_STALE_WHILE_REVALIDATE, TS_RECORDDATATYPE_INT}     },
+    {"proxy.config.http.cache.stale_if_error",                         {TS_CONFIG_HTTP_CACHE_STALE_IF_ERROR, TS_RECORDDATATYPE_INT}             }
 });
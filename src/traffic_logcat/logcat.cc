@@ -41,6 +41,7 @@
 #include "LogObject.h"
 #include "LogConfig.h"
 #include "LogBuffer.h"
+#include "LogColumnar.h"
 #include "LogUtils.h"
 #include "Log.h"
 
@@ -115,6 +116,56 @@ follow_rotate(const char *input_file, ino_t old_inode_num)
   }
 }
 
+/*
+ * Converts one columnar block, whose first @a have bytes are already in
+ * @a buffer, back to a LogBuffer segment and writes it out as ASCII.
+ *
+ * @returns 0 on success, otherwise 1
+ */
+static int
+process_columnar_block(int in_fd, int out_fd, char *buffer, unsigned have)
+{
+  LogColumnarBlockHeader header;
+
+  memcpy(&header, buffer, have);
+  int nread = read(in_fd, reinterpret_cast<char *>(&header) + have, sizeof(header) - have);
+  if (nread != static_cast<int>(sizeof(header) - have)) {
+    fprintf(stderr, "Bad columnar block header read!\n");
+    return 1;
+  }
+  if (header.block_len < sizeof(header)) {
+    fprintf(stderr, "Bad columnar block!\n");
+    return 1;
+  }
+
+  char *block = static_cast<char *>(ats_malloc(header.block_len));
+  memcpy(block, &header, sizeof(header));
+
+  // Read the rest of the block (allowing for "partial" reads)
+  unsigned block_bytes = header.block_len - sizeof(header);
+  unsigned total       = 0;
+  while (total < block_bytes) {
+    int rc = read(in_fd, block + sizeof(header) + total, block_bytes - total);
+    if (rc < 0 || (rc == 0 && !follow_flag)) {
+      fprintf(stderr, "Bad columnar block read!\n");
+      ats_free(block);
+      return 1;
+    }
+    total += rc;
+  }
+
+  LogBufferHeader *segment = LogColumnar::decode(reinterpret_cast<LogColumnarBlockHeader *>(block));
+  ats_free(block);
+  if (segment == nullptr) {
+    fprintf(stderr, "Bad columnar block!\n");
+    return 1;
+  }
+
+  LogFile::write_ascii_logbuffer(segment, out_fd, ".", nullptr);
+  ats_free(segment);
+  return 0;
+}
+
 static int
 process_file(int in_fd, int out_fd)
 {
@@ -139,6 +190,15 @@ process_file(int in_fd, int out_fd)
       return 0;
     }
 
+    // columnar log files hold blocks rather than logbuffers
+    //
+    if (header->cookie == LOG_COLUMNAR_MAGIC) {
+      if (process_columnar_block(in_fd, out_fd, buffer, first_read_size) != 0) {
+        return 1;
+      }
+      continue;
+    }
+
     // ensure that this is a valid logbuffer header
     //
     if (header->cookie != LOG_SEGMENT_COOKIE) {
@@ -295,6 +355,7 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
 
   if (n_file_arguments) {
     int bin_ext_len   = strlen(LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION);
+    int col_ext_len   = strlen(LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION);
     int ascii_ext_len = strlen(LOG_FILE_ASCII_OBJECT_FILENAME_EXTENSION);
 
     for (unsigned i = 0; i < n_file_arguments; ++i) {
@@ -316,13 +377,16 @@ main(int /* argc ATS_UNUSED */, const char *argv[])
         posix_fadvise(in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
 #endif
         if (auto_filenames) {
-          // change .blog to .log
+          // change .blog or .clog to .log
           //
-          int n = strlen(file_arguments[i]);
-          int copy_len =
-            (n >= bin_ext_len ?
-               (strcmp(&file_arguments[i][n - bin_ext_len], LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION) == 0 ? n - bin_ext_len : n) :
-               n);
+          int n        = strlen(file_arguments[i]);
+          int copy_len = n;
+          if (n >= bin_ext_len && strcmp(&file_arguments[i][n - bin_ext_len], LOG_FILE_BINARY_OBJECT_FILENAME_EXTENSION) == 0) {
+            copy_len = n - bin_ext_len;
+          } else if (n >= col_ext_len &&
+                     strcmp(&file_arguments[i][n - col_ext_len], LOG_FILE_COLUMNAR_OBJECT_FILENAME_EXTENSION) == 0) {
+            copy_len = n - col_ext_len;
+          }
 
           char *out_filename = (char *)ats_malloc(copy_len + ascii_ext_len + 1);
 
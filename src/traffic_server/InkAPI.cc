@@ -22,10 +22,13 @@
  */
 
 #include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <tuple>
 #include <unordered_map>
 #include <string_view>
 #include <string>
+#include <vector>
 
 #include "tscore/ink_platform.h"
 #include "tscore/ink_base64.h"
@@ -33,6 +36,7 @@
 #include "tscore/I_Layout.h"
 #include "tscore/I_Version.h"
 #include "tscore/Diags.h"
+#include "tscpp/util/TsSharedMutex.h"
 
 #include "InkAPIInternal.h"
 #include "Log.h"
@@ -1439,6 +1443,15 @@ HttpHookState::init(TSHttpHookID id, HttpAPIHooks const *global, HttpAPIHooks co
 {
   _id = id;
 
+  // Hooks are only added here by callbacks for this id, so if there are none now none can be added before the next init.
+  _empty = !((global && global->has_hooks_for(id)) || (ssn && ssn->has_hooks_for(id)) || (txn && txn->has_hooks_for(id)));
+  if (_empty) {
+    _global.clear();
+    _ssn.clear();
+    _txn.clear();
+    return;
+  }
+
   if (global) {
     _global.init(global, id);
   } else {
@@ -1462,6 +1475,9 @@ APIHook const *
 HttpHookState::getNext()
 {
   APIHook const *zret = nullptr;
+  if (_empty) {
+    return zret;
+  }
   do {
     APIHook const *hg   = _global.candidate();
     APIHook const *hssn = _ssn.candidate();
@@ -8841,6 +8857,12 @@ _conf_to_memberp(TSOverridableConfigKey conf, OverridableHttpConfigParams *overr
   case TS_CONFIG_NET_DEFAULT_INACTIVITY_TIMEOUT:
     ret = _memberp_to_generic(&overridableHttpConfig->default_inactivity_timeout, conv);
     break;
+  case TS_CONFIG_HTTP_CACHE_STALE_WHILE_REVALIDATE:
+    ret = _memberp_to_generic(&overridableHttpConfig->cache_stale_while_revalidate, conv);
+    break;
+  case TS_CONFIG_HTTP_CACHE_STALE_IF_ERROR:
+    ret = _memberp_to_generic(&overridableHttpConfig->cache_stale_if_error, conv);
+    break;
 
   // This helps avoiding compiler warnings, yet detect unhandled enum members.
   case TS_CONFIG_NULL:
@@ -8858,19 +8880,12 @@ _conf_to_memberp(TSOverridableConfigKey conf, const OverridableHttpConfigParams
   return _conf_to_memberp(conf, const_cast<OverridableHttpConfigParams *>(overridableHttpConfig), conv);
 }
 
-/* APIs to manipulate the overridable configuration options.
- */
-TSReturnCode
-TSHttpTxnConfigIntSet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtInt value)
+// Helpers to store a value into a set of overridable configurations, either those of a transaction or a snapshot.
+static TSReturnCode
+_conf_int_set(OverridableHttpConfigParams &conf_params, TSOverridableConfigKey conf, TSMgmtInt value)
 {
-  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
-
-  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
   MgmtConverter const *conv;
-
-  s->t_state.setup_per_txn_configs();
-
-  void *dest = _conf_to_memberp(conf, &(s->t_state.my_txn_conf()), conv);
+  void *dest = _conf_to_memberp(conf, &conf_params, conv);
 
   if (!dest || !conv->store_int) {
     return TS_ERROR;
@@ -8881,36 +8896,11 @@ TSHttpTxnConfigIntSet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtInt val
   return TS_SUCCESS;
 }
 
-TSReturnCode
-TSHttpTxnConfigIntGet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtInt *value)
-{
-  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
-  sdk_assert(sdk_sanity_check_null_ptr((void *)value) == TS_SUCCESS);
-
-  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
-  MgmtConverter const *conv;
-  const void *src = _conf_to_memberp(conf, s->t_state.txn_conf, conv);
-
-  if (!src || !conv->load_int) {
-    return TS_ERROR;
-  }
-
-  *value = conv->load_int(src);
-
-  return TS_SUCCESS;
-}
-
-TSReturnCode
-TSHttpTxnConfigFloatSet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtFloat value)
+static TSReturnCode
+_conf_float_set(OverridableHttpConfigParams &conf_params, TSOverridableConfigKey conf, TSMgmtFloat value)
 {
-  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
-
-  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
   MgmtConverter const *conv;
-
-  s->t_state.setup_per_txn_configs();
-
-  void *dest = _conf_to_memberp(conf, &(s->t_state.my_txn_conf()), conv);
+  void *dest = _conf_to_memberp(conf, &conf_params, conv);
 
   if (!dest || !conv->store_float) {
     return TS_ERROR;
@@ -8921,62 +8911,35 @@ TSHttpTxnConfigFloatSet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtFloat
   return TS_SUCCESS;
 }
 
-TSReturnCode
-TSHttpTxnConfigFloatGet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtFloat *value)
-{
-  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
-  sdk_assert(sdk_sanity_check_null_ptr(static_cast<void *>(value)) == TS_SUCCESS);
-
-  MgmtConverter const *conv;
-  const void *src = _conf_to_memberp(conf, reinterpret_cast<HttpSM *>(txnp)->t_state.txn_conf, conv);
-
-  if (!src || !conv->load_float) {
-    return TS_ERROR;
-  }
-  *value = conv->load_float(src);
-
-  return TS_SUCCESS;
-}
-
-TSReturnCode
-TSHttpTxnConfigStringSet(TSHttpTxn txnp, TSOverridableConfigKey conf, const char *value, int length)
+static TSReturnCode
+_conf_string_set(OverridableHttpConfigParams &conf_params, TSOverridableConfigKey conf, const char *value, int length)
 {
-  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
-
-  if (length == -1) {
-    length = strlen(value);
-  }
-
-  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
-
-  s->t_state.setup_per_txn_configs();
-
   switch (conf) {
   case TS_CONFIG_HTTP_RESPONSE_SERVER_STR:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().proxy_response_server_string     = const_cast<char *>(value); // The "core" likes non-const char*
-      s->t_state.my_txn_conf().proxy_response_server_string_len = length;
+      conf_params.proxy_response_server_string     = const_cast<char *>(value); // The "core" likes non-const char*
+      conf_params.proxy_response_server_string_len = length;
     } else {
-      s->t_state.my_txn_conf().proxy_response_server_string     = nullptr;
-      s->t_state.my_txn_conf().proxy_response_server_string_len = 0;
+      conf_params.proxy_response_server_string     = nullptr;
+      conf_params.proxy_response_server_string_len = 0;
     }
     break;
   case TS_CONFIG_HTTP_GLOBAL_USER_AGENT_HEADER:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().global_user_agent_header      = const_cast<char *>(value); // The "core" likes non-const char*
-      s->t_state.my_txn_conf().global_user_agent_header_size = length;
+      conf_params.global_user_agent_header      = const_cast<char *>(value); // The "core" likes non-const char*
+      conf_params.global_user_agent_header_size = length;
     } else {
-      s->t_state.my_txn_conf().global_user_agent_header      = nullptr;
-      s->t_state.my_txn_conf().global_user_agent_header_size = 0;
+      conf_params.global_user_agent_header      = nullptr;
+      conf_params.global_user_agent_header_size = 0;
     }
     break;
   case TS_CONFIG_BODY_FACTORY_TEMPLATE_BASE:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().body_factory_template_base     = const_cast<char *>(value);
-      s->t_state.my_txn_conf().body_factory_template_base_len = length;
+      conf_params.body_factory_template_base     = const_cast<char *>(value);
+      conf_params.body_factory_template_base_len = length;
     } else {
-      s->t_state.my_txn_conf().body_factory_template_base     = nullptr;
-      s->t_state.my_txn_conf().body_factory_template_base_len = 0;
+      conf_params.body_factory_template_base     = nullptr;
+      conf_params.body_factory_template_base_len = 0;
     }
     break;
   case TS_CONFIG_HTTP_INSERT_FORWARDED:
@@ -8984,7 +8947,7 @@ TSHttpTxnConfigStringSet(TSHttpTxn txnp, TSOverridableConfigKey conf, const char
       ts::LocalBufferWriter<1024> error;
       HttpForwarded::OptionBitSet bs = HttpForwarded::optStrToBitset(std::string_view(value, length), error);
       if (!error.size()) {
-        s->t_state.my_txn_conf().insert_forwarded = bs;
+        conf_params.insert_forwarded = bs;
       } else {
         Error("HTTP %.*s", static_cast<int>(error.size()), error.data());
       }
@@ -8992,43 +8955,43 @@ TSHttpTxnConfigStringSet(TSHttpTxn txnp, TSOverridableConfigKey conf, const char
     break;
   case TS_CONFIG_HTTP_SERVER_SESSION_SHARING_MATCH:
     if (value && length > 0) {
-      HttpConfig::load_server_session_sharing_match(value, s->t_state.my_txn_conf().server_session_sharing_match);
-      s->t_state.my_txn_conf().server_session_sharing_match_str = const_cast<char *>(value);
+      HttpConfig::load_server_session_sharing_match(value, conf_params.server_session_sharing_match);
+      conf_params.server_session_sharing_match_str = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CLIENT_VERIFY_SERVER_POLICY:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().ssl_client_verify_server_policy = const_cast<char *>(value);
+      conf_params.ssl_client_verify_server_policy = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CLIENT_VERIFY_SERVER_PROPERTIES:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().ssl_client_verify_server_properties = const_cast<char *>(value);
+      conf_params.ssl_client_verify_server_properties = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CLIENT_SNI_POLICY:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().ssl_client_sni_policy = const_cast<char *>(value);
+      conf_params.ssl_client_sni_policy = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CLIENT_CERT_FILENAME:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().ssl_client_cert_filename = const_cast<char *>(value);
+      conf_params.ssl_client_cert_filename = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CLIENT_PRIVATE_KEY_FILENAME:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().ssl_client_private_key_filename = const_cast<char *>(value);
+      conf_params.ssl_client_private_key_filename = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CLIENT_CA_CERT_FILENAME:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().ssl_client_ca_cert_filename = const_cast<char *>(value);
+      conf_params.ssl_client_ca_cert_filename = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CLIENT_ALPN_PROTOCOLS:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().ssl_client_alpn_protocols = const_cast<char *>(value);
+      conf_params.ssl_client_alpn_protocols = const_cast<char *>(value);
     }
     break;
   case TS_CONFIG_SSL_CERT_FILEPATH:
@@ -9036,12 +8999,12 @@ TSHttpTxnConfigStringSet(TSHttpTxn txnp, TSOverridableConfigKey conf, const char
     break;
   case TS_CONFIG_HTTP_HOST_RESOLUTION_PREFERENCE:
     if (value && length > 0) {
-      s->t_state.my_txn_conf().host_res_data.conf_value = const_cast<char *>(value);
+      conf_params.host_res_data.conf_value = const_cast<char *>(value);
     }
     [[fallthrough]];
   default: {
     MgmtConverter const *conv;
-    void *dest = _conf_to_memberp(conf, &(s->t_state.my_txn_conf()), conv);
+    void *dest = _conf_to_memberp(conf, &conf_params, conv);
     if (dest != nullptr && conv != nullptr && conv->store_string) {
       conv->store_string(dest, std::string_view(value, length));
     } else {
@@ -9054,6 +9017,84 @@ TSHttpTxnConfigStringSet(TSHttpTxn txnp, TSOverridableConfigKey conf, const char
   return TS_SUCCESS;
 }
 
+/* APIs to manipulate the overridable configuration options.
+ */
+TSReturnCode
+TSHttpTxnConfigIntSet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtInt value)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+
+  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
+
+  s->t_state.setup_per_txn_configs();
+
+  return _conf_int_set(s->t_state.my_txn_conf(), conf, value);
+}
+
+TSReturnCode
+TSHttpTxnConfigIntGet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtInt *value)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+  sdk_assert(sdk_sanity_check_null_ptr((void *)value) == TS_SUCCESS);
+
+  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
+  MgmtConverter const *conv;
+  const void *src = _conf_to_memberp(conf, s->t_state.txn_conf, conv);
+
+  if (!src || !conv->load_int) {
+    return TS_ERROR;
+  }
+
+  *value = conv->load_int(src);
+
+  return TS_SUCCESS;
+}
+
+TSReturnCode
+TSHttpTxnConfigFloatSet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtFloat value)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+
+  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
+
+  s->t_state.setup_per_txn_configs();
+
+  return _conf_float_set(s->t_state.my_txn_conf(), conf, value);
+}
+
+TSReturnCode
+TSHttpTxnConfigFloatGet(TSHttpTxn txnp, TSOverridableConfigKey conf, TSMgmtFloat *value)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+  sdk_assert(sdk_sanity_check_null_ptr(static_cast<void *>(value)) == TS_SUCCESS);
+
+  MgmtConverter const *conv;
+  const void *src = _conf_to_memberp(conf, reinterpret_cast<HttpSM *>(txnp)->t_state.txn_conf, conv);
+
+  if (!src || !conv->load_float) {
+    return TS_ERROR;
+  }
+  *value = conv->load_float(src);
+
+  return TS_SUCCESS;
+}
+
+TSReturnCode
+TSHttpTxnConfigStringSet(TSHttpTxn txnp, TSOverridableConfigKey conf, const char *value, int length)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+
+  if (length == -1) {
+    length = strlen(value);
+  }
+
+  HttpSM *s = reinterpret_cast<HttpSM *>(txnp);
+
+  s->t_state.setup_per_txn_configs();
+
+  return _conf_string_set(s->t_state.my_txn_conf(), conf, value, length);
+}
+
 TSReturnCode
 TSHttpTxnConfigStringGet(TSHttpTxn txnp, TSOverridableConfigKey conf, const char **value, int *length)
 {
@@ -9112,6 +9153,158 @@ TSHttpTxnConfigFind(const char *name, int length, TSOverridableConfigKey *conf,
   return TS_ERROR;
 }
 
+namespace
+{
+// A fixed set of overrides, such as those of a conf_remap rule, which is applied to many transactions.
+struct HttpConfigOverlay {
+  struct Item {
+    TSOverridableConfigKey key;
+    TSRecordDataType type;
+    TSMgmtInt int_value     = 0;
+    TSMgmtFloat float_value = 0;
+    std::string string_value;
+    bool string_null = false; ///< Override the string with no value at all.
+
+    const char *
+    string() const
+    {
+      return string_null ? nullptr : string_value.c_str();
+    }
+  };
+
+  /// Store the overrides into @a conf_params. String values refer to the items, so the overlay must outlive it.
+  void
+  apply(OverridableHttpConfigParams &conf_params) const
+  {
+    for (auto const &item : items) {
+      switch (item.type) {
+      case TS_RECORDDATATYPE_INT:
+        _conf_int_set(conf_params, item.key, item.int_value);
+        break;
+      case TS_RECORDDATATYPE_FLOAT:
+        _conf_float_set(conf_params, item.key, item.float_value);
+        break;
+      case TS_RECORDDATATYPE_STRING:
+        _conf_string_set(conf_params, item.key, item.string(), item.string_value.size());
+        break;
+      default:
+        break;
+      }
+    }
+  }
+
+  /// The shared snapshot of these overrides applied to @a params, built if there is none for it yet.
+  Ptr<OverridableHttpConfigSnapshot>
+  snapshot(HttpConfigParams *params)
+  {
+    {
+      std::shared_lock lock(mutex);
+      if (current && current->base == params) {
+        return current;
+      }
+    }
+
+    // The snapshot holds on to its base, so a match above can't be a new configuration at a recycled address.
+    Ptr<OverridableHttpConfigSnapshot> snap = make_ptr(new OverridableHttpConfigSnapshot(params));
+    apply(snap->oride);
+
+    std::unique_lock lock(mutex);
+    current = snap;
+    return snap;
+  }
+
+  /// Check that @a item can be stored, before adding it.
+  TSReturnCode
+  add(Item &&item, TSReturnCode (*check)(OverridableHttpConfigParams &, Item const &))
+  {
+    OverridableHttpConfigParams scratch;
+    if (check(scratch, item) != TS_SUCCESS) {
+      return TS_ERROR;
+    }
+    items.push_back(std::move(item));
+    return TS_SUCCESS;
+  }
+
+  std::vector<Item> items;
+  ts::shared_mutex mutex;
+  Ptr<OverridableHttpConfigSnapshot> current; ///< Snapshot for the configuration seen most recently.
+};
+} // namespace
+
+TSHttpConfigOverlay
+TSHttpConfigOverlayCreate()
+{
+  return reinterpret_cast<TSHttpConfigOverlay>(new HttpConfigOverlay);
+}
+
+void
+TSHttpConfigOverlayDestroy(TSHttpConfigOverlay overlay)
+{
+  delete reinterpret_cast<HttpConfigOverlay *>(overlay);
+}
+
+TSReturnCode
+TSHttpConfigOverlayIntSet(TSHttpConfigOverlay overlay, TSOverridableConfigKey conf, TSMgmtInt value)
+{
+  sdk_assert(sdk_sanity_check_null_ptr(overlay) == TS_SUCCESS);
+
+  HttpConfigOverlay::Item item{conf, TS_RECORDDATATYPE_INT};
+  item.int_value = value;
+  return reinterpret_cast<HttpConfigOverlay *>(overlay)->add(std::move(item), [](auto &conf_params, auto const &item) {
+    return _conf_int_set(conf_params, item.key, item.int_value);
+  });
+}
+
+TSReturnCode
+TSHttpConfigOverlayFloatSet(TSHttpConfigOverlay overlay, TSOverridableConfigKey conf, TSMgmtFloat value)
+{
+  sdk_assert(sdk_sanity_check_null_ptr(overlay) == TS_SUCCESS);
+
+  HttpConfigOverlay::Item item{conf, TS_RECORDDATATYPE_FLOAT};
+  item.float_value = value;
+  return reinterpret_cast<HttpConfigOverlay *>(overlay)->add(std::move(item), [](auto &conf_params, auto const &item) {
+    return _conf_float_set(conf_params, item.key, item.float_value);
+  });
+}
+
+TSReturnCode
+TSHttpConfigOverlayStringSet(TSHttpConfigOverlay overlay, TSOverridableConfigKey conf, const char *value, int length)
+{
+  sdk_assert(sdk_sanity_check_null_ptr(overlay) == TS_SUCCESS);
+
+  HttpConfigOverlay::Item item{conf, TS_RECORDDATATYPE_STRING};
+  if (value == nullptr) {
+    item.string_null = true;
+  } else {
+    item.string_value.assign(value, length == -1 ? strlen(value) : length);
+  }
+  return reinterpret_cast<HttpConfigOverlay *>(overlay)->add(std::move(item), [](auto &conf_params, auto const &item) {
+    return _conf_string_set(conf_params, item.key, item.string(), item.string_value.size());
+  });
+}
+
+TSReturnCode
+TSHttpTxnConfigOverlayApply(TSHttpTxn txnp, TSHttpConfigOverlay overlay)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+  sdk_assert(sdk_sanity_check_null_ptr(overlay) == TS_SUCCESS);
+
+  HttpTransact::State &s = reinterpret_cast<HttpSM *>(txnp)->t_state;
+  auto o                 = reinterpret_cast<HttpConfigOverlay *>(overlay);
+
+  if (s.txn_conf == &s.http_config_param->oride) {
+    // Nothing is overridden yet, so point at the shared snapshot rather than copy the configuration.
+    s.txn_conf_snapshot = o->snapshot(s.http_config_param);
+    s.txn_conf          = &s.txn_conf_snapshot->oride;
+  } else {
+    // Layer these overrides over the earlier ones, in a copy of the transaction's own.
+    s.setup_per_txn_configs();
+    o->apply(s.my_txn_conf());
+  }
+
+  return TS_SUCCESS;
+}
+
 TSReturnCode
 TSHttpTxnPrivateSessionSet(TSHttpTxn txnp, int private_session)
 {
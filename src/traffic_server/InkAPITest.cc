@@ -8644,7 +8644,8 @@ std::array<std::string_view, TS_CONFIG_LAST_ENTRY> SDK_Overridable_Configs = {
    "proxy.config.http.max_proxy_cycles", "proxy.config.plugin.vc.default_buffer_index",
    "proxy.config.plugin.vc.default_buffer_water_mark", "proxy.config.net.sock_notsent_lowat",
    "proxy.config.body_factory.response_suppression_mode", "proxy.config.http.parent_proxy.enable_parent_timeout_markdowns",
-   "proxy.config.http.parent_proxy.disable_parent_markdowns", "proxy.config.net.default_inactivity_timeout"}
+   "proxy.config.http.parent_proxy.disable_parent_markdowns", "proxy.config.net.default_inactivity_timeout",
+   "proxy.config.http.cache.stale_while_revalidate", "proxy.config.http.cache.stale_if_error"}
 };
 
 extern ClassAllocator<HttpSM> httpSMAllocator;
@@ -8749,6 +8750,74 @@ REGRESSION_TEST(SDK_API_OVERRIDABLE_CONFIGS)(RegressionTest *test, int /* atype
   return;
 }
 
+////////////////////////////////////////////////
+// SDK_API_OVERRIDABLE_CONFIG_OVERLAY
+//
+// Unit Test for API: TSHttpConfigOverlayCreate
+//                    TSHttpConfigOverlayIntSet
+//                    TSHttpConfigOverlayStringSet
+//                    TSHttpTxnConfigOverlayApply
+////////////////////////////////////////////////
+
+REGRESSION_TEST(SDK_API_OVERRIDABLE_CONFIG_OVERLAY)(RegressionTest *test, int /* atype ATS_UNUSED */, int *pstatus)
+{
+  HttpSM *s1                  = THREAD_ALLOC(httpSMAllocator, this_thread());
+  HttpSM *s2                  = THREAD_ALLOC(httpSMAllocator, this_thread());
+  TSHttpTxn txn1              = reinterpret_cast<TSHttpTxn>(s1);
+  TSHttpTxn txn2              = reinterpret_cast<TSHttpTxn>(s2);
+  TSHttpConfigOverlay overlay = TSHttpConfigOverlayCreate();
+  const char *server_str      = "Overlay Server";
+  const char *sval_read;
+  TSMgmtInt ival_read;
+  int len;
+
+  s1->init();
+  s2->init();
+
+  *pstatus = REGRESSION_TEST_INPROGRESS;
+
+  if (TSHttpConfigOverlayIntSet(overlay, TS_CONFIG_HTTP_KEEP_ALIVE_ENABLED_OUT, 0) != TS_SUCCESS ||
+      TSHttpConfigOverlayStringSet(overlay, TS_CONFIG_HTTP_RESPONSE_SERVER_STR, server_str, -1) != TS_SUCCESS) {
+    SDK_RPRINT(test, "TSHttpConfigOverlayIntSet", "TestCase1", TC_FAIL, "Failed to set valid configurations");
+    *pstatus = REGRESSION_TEST_FAILED;
+  } else if (TSHttpConfigOverlayIntSet(overlay, TS_CONFIG_LAST_ENTRY, 0) != TS_ERROR) {
+    SDK_RPRINT(test, "TSHttpConfigOverlayIntSet", "TestCase2", TC_FAIL, "Accepted an invalid configuration");
+    *pstatus = REGRESSION_TEST_FAILED;
+  } else {
+    TSHttpTxnConfigOverlayApply(txn1, overlay);
+    TSHttpTxnConfigOverlayApply(txn2, overlay);
+
+    // Both transactions share one copy, which is not the global one.
+    if (s1->t_state.txn_conf != s2->t_state.txn_conf || s1->t_state.txn_conf == &s1->t_state.http_config_param->oride) {
+      SDK_RPRINT(test, "TSHttpTxnConfigOverlayApply", "TestCase1", TC_FAIL, "Transactions do not share the overlay");
+      *pstatus = REGRESSION_TEST_FAILED;
+    } else if (TSHttpTxnConfigIntGet(txn2, TS_CONFIG_HTTP_KEEP_ALIVE_ENABLED_OUT, &ival_read) != TS_SUCCESS || ival_read != 0 ||
+               TSHttpTxnConfigStringGet(txn2, TS_CONFIG_HTTP_RESPONSE_SERVER_STR, &sval_read, &len) != TS_SUCCESS ||
+               std::string_view(sval_read, len) != server_str) {
+      SDK_RPRINT(test, "TSHttpTxnConfigOverlayApply", "TestCase2", TC_FAIL, "Overlay values not applied");
+      *pstatus = REGRESSION_TEST_FAILED;
+    } else {
+      // Setting a value for one transaction gives it a copy of its own, which keeps the overlay values.
+      TSHttpTxnConfigIntSet(txn1, TS_CONFIG_HTTP_KEEP_ALIVE_ENABLED_OUT, 1);
+      TSHttpTxnConfigIntGet(txn2, TS_CONFIG_HTTP_KEEP_ALIVE_ENABLED_OUT, &ival_read);
+      TSHttpTxnConfigStringGet(txn1, TS_CONFIG_HTTP_RESPONSE_SERVER_STR, &sval_read, &len);
+      if (s1->t_state.txn_conf == s2->t_state.txn_conf || ival_read != 0 || std::string_view(sval_read, len) != server_str) {
+        SDK_RPRINT(test, "TSHttpTxnConfigIntSet", "TestCase2", TC_FAIL, "Overlay not copied on write");
+        *pstatus = REGRESSION_TEST_FAILED;
+      }
+    }
+  }
+
+  s1->destroy();
+  s2->destroy();
+  TSHttpConfigOverlayDestroy(overlay);
+
+  if (*pstatus == REGRESSION_TEST_INPROGRESS) {
+    SDK_RPRINT(test, "TSHttpTxnConfigOverlayApply", "TestCase1", TC_PASS, "ok");
+    *pstatus = REGRESSION_TEST_PASSED;
+  }
+}
+
 ////////////////////////////////////////////////
 // SDK_API_TXN_HTTP_INFO_INFO_GET
 //
@@ -9157,3 +9226,92 @@ REGRESSION_TEST(SDK_API_TSStatCreate)(RegressionTest *test, int level, int *psta
 
   box.check(expected >= value, "TSStatIntGet(%s) gave %" PRId64 ", expected at least %" PRId64, name, value, expected);
 }
+
+static int
+hook_state_test_handler(TSCont /* contp ATS_UNUSED */, TSEvent /* event ATS_UNUSED */, void * /* edata ATS_UNUSED */)
+{
+  return 0;
+}
+
+REGRESSION_TEST(SDK_API_HttpHookState)(RegressionTest *test, int /* atype ATS_UNUSED */, int *pstatus)
+{
+  // A typical configuration: plugins on a couple of hook points each, most hook points empty.
+  static const int N_PLUGINS         = 15;
+  static const int ITERATIONS        = 100000;
+  static const TSHttpHookID points[] = {
+    TS_HTTP_TXN_START_HOOK,
+    TS_HTTP_READ_REQUEST_HDR_HOOK,
+    TS_HTTP_PRE_REMAP_HOOK,
+    TS_HTTP_POST_REMAP_HOOK,
+    TS_HTTP_CACHE_LOOKUP_COMPLETE_HOOK,
+    TS_HTTP_OS_DNS_HOOK,
+    TS_HTTP_SEND_REQUEST_HDR_HOOK,
+    TS_HTTP_READ_RESPONSE_HDR_HOOK,
+    TS_HTTP_SEND_RESPONSE_HDR_HOOK,
+    TS_HTTP_TXN_CLOSE_HOOK,
+  };
+
+  TestBox box(test, pstatus);
+  HttpAPIHooks global;
+  HttpAPIHooks txn;
+  TSCont conts[N_PLUGINS];
+
+  box = REGRESSION_TEST_PASSED;
+
+  for (int i = 0; i < N_PLUGINS; ++i) {
+    conts[i]              = TSContCreate(hook_state_test_handler, nullptr);
+    INKContInternal *cont = reinterpret_cast<INKContInternal *>(conts[i]);
+    global.append(i % 2 ? TS_HTTP_READ_REQUEST_HDR_HOOK : TS_HTTP_SEND_RESPONSE_HDR_HOOK, cont);
+    global.append(TS_HTTP_TXN_CLOSE_HOOK, cont);
+  }
+  txn.append(TS_HTTP_OS_DNS_HOOK, reinterpret_cast<INKContInternal *>(conts[0]));
+
+  // Every hook point must still get exactly the hooks in its lists.
+  for (int id = 0; id < TS_HTTP_LAST_HOOK; ++id) {
+    HttpHookState state;
+    int expected = 0;
+    int found    = 0;
+
+    for (APIHooks const *hooks : {global[TSHttpHookID(id)], txn[TSHttpHookID(id)]}) {
+      for (APIHook const *hook = hooks->head(); hook; hook = hook->next()) {
+        ++expected;
+      }
+    }
+    state.init(TSHttpHookID(id), &global, nullptr, &txn);
+    box.check(state.is_empty() == (expected == 0), "hook %d is %s with %d hooks", id, state.is_empty() ? "empty" : "not empty",
+              expected);
+    while (state.getNext()) {
+      ++found;
+    }
+    box.check(found == expected, "hook %d called %d hooks, expected %d", id, found, expected);
+  }
+
+  // The cost of the hook points of a transaction without the callbacks, apart for the empty ones.
+  for (bool empty : {true, false}) {
+    HttpHookState state;
+    int n_points     = 0;
+    int callbacks    = 0;
+    ink_hrtime start = Thread::get_hrtime_updated();
+    for (int i = 0; i < ITERATIONS; ++i) {
+      for (TSHttpHookID id : points) {
+        if (global.has_hooks_for(id) || txn.has_hooks_for(id) ? empty : !empty) {
+          continue;
+        }
+        n_points += i == 0;
+        state.init(id, &global, nullptr, &txn);
+        while (state.getNext()) {
+          ++callbacks;
+        }
+      }
+    }
+    ink_hrtime elapsed = Thread::get_hrtime_updated() - start;
+    rprintf(test, "%d plugins: %" PRId64 " ns per transaction for %d %s hook points, %d callbacks\n", N_PLUGINS,
+            elapsed / ITERATIONS, n_points, empty ? "empty" : "used", callbacks / ITERATIONS);
+  }
+
+  global.clear();
+  txn.clear();
+  for (TSCont cont : conts) {
+    TSContDestroy(cont);
+  }
+}
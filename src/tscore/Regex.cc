@@ -21,7 +21,11 @@
   limitations under the License.
  */
 
+#include <algorithm>
 #include <array>
+#include <cctype>
+#include <cstring>
+#include <deque>
 
 #include "tscore/ink_platform.h"
 #include "tscore/ink_thread.h"
@@ -134,6 +138,280 @@ Regex::~Regex()
   }
 }
 
+namespace
+{
+inline unsigned char
+fold(unsigned char c)
+{
+  return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+// End of a bracketed character class starting at @a i, or npos if it does not end.
+size_t
+skip_class(std::string_view pattern, size_t i)
+{
+  ++i;
+  if (i < pattern.size() && pattern[i] == '^') {
+    ++i;
+  }
+  if (i < pattern.size() && pattern[i] == ']') {
+    ++i; // a leading ']' is literal.
+  }
+  for (; i < pattern.size(); ++i) {
+    if (pattern[i] == '\\') {
+      ++i;
+    } else if (pattern[i] == '[' && i + 1 < pattern.size() && pattern[i + 1] == ':') {
+      i = pattern.find(":]", i + 2);
+      if (i == std::string_view::npos) {
+        return i;
+      }
+      ++i;
+    } else if (pattern[i] == ']') {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// End of a parenthesized group starting at @a i, or npos if it does not end.
+size_t
+skip_group(std::string_view pattern, size_t i)
+{
+  int depth = 0;
+  for (; i < pattern.size(); ++i) {
+    switch (pattern[i]) {
+    case '\\':
+      ++i;
+      break;
+    case '[':
+      i = skip_class(pattern, i);
+      if (i == std::string_view::npos) {
+        return i;
+      }
+      break;
+    case '(':
+      ++depth;
+      break;
+    case ')':
+      if (--depth == 0) {
+        return i;
+      }
+      break;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// If a counted quantifier starts at @a i, return its end and set @a min. Otherwise return npos.
+size_t
+parse_quantifier(std::string_view pattern, size_t i, int &min)
+{
+  size_t j = i + 1;
+  min      = 0;
+  if (j >= pattern.size() || !isdigit(static_cast<unsigned char>(pattern[j]))) {
+    return std::string_view::npos; // '{' is literal.
+  }
+  for (; j < pattern.size() && isdigit(static_cast<unsigned char>(pattern[j])); ++j) {
+    min = std::min(min * 10 + (pattern[j] - '0'), 0xffff);
+  }
+  if (j < pattern.size() && pattern[j] == ',') {
+    for (++j; j < pattern.size() && isdigit(static_cast<unsigned char>(pattern[j])); ++j) {
+      ;
+    }
+  }
+  return (j < pattern.size() && pattern[j] == '}') ? j : std::string_view::npos;
+}
+} // namespace
+
+std::string
+RegexPrefilter::required_literal(std::string_view pattern)
+{
+  std::string best;
+  std::string run;
+  auto end_run = [&]() {
+    if (run.size() > best.size()) {
+      best = run;
+    }
+    run.clear();
+  };
+
+  // Extended mode makes white space and '#' in the pattern insignificant.
+  for (size_t i = pattern.find("(?"); i != std::string_view::npos; i = pattern.find("(?", i + 2)) {
+    for (size_t j = i + 2; j < pattern.size() && (isalpha(static_cast<unsigned char>(pattern[j])) || pattern[j] == '-'); ++j) {
+      if (pattern[j] == 'x') {
+        return {};
+      }
+    }
+  }
+
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    char c = pattern[i];
+    int min;
+    size_t end;
+
+    switch (c) {
+    case '\\':
+      if (++i >= pattern.size()) {
+        return {};
+      }
+      c = pattern[i];
+      if (!isalnum(static_cast<unsigned char>(c))) {
+        run += c;
+      } else if (strchr("dDwWsShHvVRXbBAZzGKNC", c)) {
+        end_run(); // a character type or an assertion.
+      } else if (const char *lit = strchr("n\nt\tr\rf\fe\x1b", c); lit && lit[1]) {
+        run += lit[1];
+      } else {
+        return {}; // numeric escapes, back references, properties, \Q...\E
+      }
+      break;
+    case '[':
+      if ((i = skip_class(pattern, i)) == std::string_view::npos) {
+        return {};
+      }
+      end_run();
+      break;
+    case '(':
+      if ((i = skip_group(pattern, i)) == std::string_view::npos) {
+        return {};
+      }
+      end_run();
+      break;
+    case ')':
+    case '|':
+      return {}; // an alternative at the top level means no literal is required.
+    case '.':
+    case '^':
+    case '$':
+      end_run();
+      break;
+    case '*':
+    case '?':
+      // The preceding item is optional. A '?' after another quantifier makes it lazy, and the
+      // preceding run is already ended.
+      if (!run.empty()) {
+        run.pop_back();
+      }
+      end_run();
+      break;
+    case '+':
+      end_run();
+      break;
+    case '{':
+      if ((end = parse_quantifier(pattern, i, min)) == std::string_view::npos) {
+        run += c;
+        break;
+      }
+      if (min == 0 && !run.empty()) {
+        run.pop_back();
+      }
+      end_run();
+      i = end;
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x80) {
+        run += fold(c);
+      } else {
+        end_run(); // caseless matching of multi-byte characters is not a byte for byte fold.
+      }
+      break;
+    }
+  }
+  end_run();
+
+  return best;
+}
+
+void
+RegexPrefilter::add(std::string_view pattern)
+{
+  std::string literal = required_literal(pattern);
+
+  if (literal.size() < MIN_LITERAL_LENGTH) {
+    _always.push_back(_count);
+  } else {
+    _literals.emplace_back(std::move(literal), _count);
+  }
+  ++_count;
+}
+
+void
+RegexPrefilter::build()
+{
+  _states.clear();
+  _states.emplace_back();
+
+  for (auto const &[literal, idx] : _literals) {
+    int state = 0;
+    for (unsigned char c : literal) {
+      auto &next = _states[state].next;
+      auto spot  = std::lower_bound(next.begin(), next.end(), c, [](auto const &t, unsigned char c) { return t.first < c; });
+      if (spot != next.end() && spot->first == c) {
+        state = spot->second;
+      } else {
+        int n = _states.size();
+        next.emplace(spot, c, n);
+        _states.emplace_back(); // invalidates @a next.
+        state = n;
+      }
+    }
+    _states[state].patterns.push_back(idx);
+  }
+  _literals.clear();
+
+  // Breadth first, so every fail link points to a state whose own links are already set.
+  std::deque<int> queue;
+  for (auto const &[c, s] : _states[0].next) {
+    _states[s].output = _states[s].patterns.empty() ? 0 : s;
+    queue.push_back(s);
+  }
+  while (!queue.empty()) {
+    int r = queue.front();
+    queue.pop_front();
+    for (auto const &[c, s] : _states[r].next) {
+      State &state = _states[s];
+      state.fail   = this->step(_states[r].fail, c);
+      state.output = state.patterns.empty() ? _states[state.fail].output : s;
+      queue.push_back(s);
+    }
+  }
+}
+
+int
+RegexPrefilter::step(int state, unsigned char c) const
+{
+  while (true) {
+    auto const &next = _states[state].next;
+    auto spot        = std::lower_bound(next.begin(), next.end(), c, [](auto const &t, unsigned char c) { return t.first < c; });
+    if (spot != next.end() && spot->first == c) {
+      return spot->second;
+    }
+    if (state == 0) {
+      return 0;
+    }
+    state = _states[state].fail;
+  }
+}
+
+void
+RegexPrefilter::candidates(std::string_view str, std::vector<int> &result) const
+{
+  result.assign(_always.begin(), _always.end());
+
+  if (_states.size() > 1) {
+    int state = 0;
+    for (unsigned char c : str) {
+      state = this->step(state, fold(c));
+      for (int s = _states[state].output; s != 0; s = _states[_states[s].fail].output) {
+        result.insert(result.end(), _states[s].patterns.begin(), _states[s].patterns.end());
+      }
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
 DFA::~DFA() {}
 
 bool
@@ -158,6 +436,7 @@ DFA::compile(std::string_view const &pattern, unsigned flags)
 {
   ink_assert(_patterns.empty());
   this->build(pattern, flags);
+  this->build_prefilter();
   return _patterns.size();
 }
 
@@ -168,6 +447,7 @@ DFA::compile(std::string_view *patterns, int npatterns, unsigned flags)
   for (int i = 0; i < npatterns; ++i) {
     this->build(patterns[i], flags);
   }
+  this->build_prefilter();
   return _patterns.size();
 }
 
@@ -178,12 +458,37 @@ DFA::compile(const char **patterns, int npatterns, unsigned flags)
   for (int i = 0; i < npatterns; ++i) {
     this->build(patterns[i], flags);
   }
+  this->build_prefilter();
   return _patterns.size();
 }
 
+void
+DFA::build_prefilter()
+{
+  _prefilter = RegexPrefilter();
+  if (_patterns.size() >= PREFILTER_MIN_PATTERNS) {
+    for (auto const &p : _patterns) {
+      _prefilter.add(p._p);
+    }
+    _prefilter.build();
+  }
+}
+
 int
 DFA::match(std::string_view const &str) const
 {
+  if (_prefilter.size() > 0) {
+    thread_local std::vector<int> candidates;
+
+    _prefilter.candidates(str, candidates);
+    for (int i : candidates) {
+      if (_patterns[i]._re.exec(str)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
   for (auto spot = _patterns.begin(), limit = _patterns.end(); spot != limit; ++spot) {
     if (spot->_re.exec(str)) {
       return spot - _patterns.begin();
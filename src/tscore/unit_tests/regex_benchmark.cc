@@ -0,0 +1,191 @@
+/** @file
+
+  Micro benchmark for matching a URL against a long ordered list of regular expressions, with and
+  without RegexPrefilter.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/Regex.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Args
+std::string rules_file;
+int nrules = 3000;
+
+std::vector<std::string> patterns;
+std::vector<Regex> compiled;
+RegexPrefilter prefilter;
+
+// Rules shaped like those of a media property: per title and per rendition paths, and a few
+// catch alls at the end.
+void
+generate_rules()
+{
+  static const char *kinds[] = {"video", "audio", "images", "live", "vod"};
+  for (int i = 0; static_cast<int>(patterns.size()) < nrules - 3; ++i) {
+    std::ostringstream rule;
+    switch (i % 4) {
+    case 0:
+      rule << "^/" << kinds[i % 5] << "/title" << i << "/([0-9]+)/(.*)\\.m3u8$";
+      break;
+    case 1:
+      rule << "^/" << kinds[i % 5] << "/title" << i << "/seg-([0-9]+)\\.ts";
+      break;
+    case 2:
+      rule << "^/assets/v[0-9]+/show" << i << "_[a-z]+\\.(jpg|png)$";
+      break;
+    case 3:
+      rule << "^/api/catalog/item" << i << "(\\?.*)?$";
+      break;
+    }
+    patterns.push_back(rule.str());
+  }
+  patterns.push_back("^/favicon\\.ico$");
+  patterns.push_back("^/health$");
+  patterns.push_back("^/.*\\.(css|js)$");
+}
+
+// The first field of each line of a regex_remap configuration file.
+void
+load_rules()
+{
+  std::ifstream f(rules_file);
+  std::string line;
+  while (std::getline(f, line)) {
+    std::istringstream fields(line);
+    std::string regex;
+    if (fields >> regex && regex[0] != '#') {
+      patterns.push_back(regex);
+    }
+  }
+}
+
+int
+match_all(std::string_view url)
+{
+  for (size_t i = 0; i < compiled.size(); ++i) {
+    if (compiled[i].exec(url)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+int
+match_filtered(std::string_view url)
+{
+  static std::vector<int> candidates;
+  prefilter.candidates(url, candidates);
+  for (int i : candidates) {
+    if (compiled[i].exec(url)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+} // namespace
+
+TEST_CASE("regex list", "[libts][Regex]")
+{
+  static const std::string_view urls[] = {
+    "/nothing/here/matches/at/all?x=1", // the worst case, every rule is tried.
+    "/video/title1000/720/index.m3u8",
+    "/styles/site.css",
+  };
+
+  for (auto url : urls) {
+    REQUIRE(match_all(url) == match_filtered(url));
+  }
+
+  std::vector<int> candidates;
+  prefilter.candidates(urls[0], candidates);
+  std::cout << patterns.size() << " rules, " << candidates.size() << " candidates for an unmatched URL" << std::endl;
+
+  BENCHMARK("unmatched, every rule")
+  {
+    return match_all(urls[0]);
+  };
+  BENCHMARK("unmatched, prefilter")
+  {
+    return match_filtered(urls[0]);
+  };
+  BENCHMARK("matched, every rule")
+  {
+    return match_all(urls[1]);
+  };
+  BENCHMARK("matched, prefilter")
+  {
+    return match_filtered(urls[1]);
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  auto cli = session.cli() |
+             Opt(rules_file, "file")["--ts-rules"]("regex_remap configuration to load rules from\n"
+                                                   "(default: generated rules)") |
+             Opt(nrules, "n")["--ts-nrules"]("number of generated rules\n"
+                                             "(default: 3000)");
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  if (rules_file.empty()) {
+    generate_rules();
+  } else {
+    load_rules();
+  }
+
+  compiled.reserve(patterns.size());
+  for (auto const &p : patterns) {
+    Regex re;
+    if (!re.compile(p.c_str())) {
+      std::cerr << "failed to compile " << p << std::endl;
+      return 1;
+    }
+    compiled.push_back(std::move(re));
+    prefilter.add(p);
+  }
+  prefilter.build();
+
+  return session.run();
+}
@@ -54,3 +54,75 @@ TEST_CASE("Regex", "[libts][Regex]")
     }
   }
 }
+
+TEST_CASE("RegexPrefilter literals", "[libts][Regex]")
+{
+  static const std::array<std::pair<std::string_view, std::string_view>, 18> literals{
+    {{"^/video/([0-9]+)/play", "/video/"},
+     {"^/Static/.*\\.JS$", "/static/"},
+     {"abc*", "ab"},
+     {"abc?def", "def"},
+     {"ab+cd", "ab"},
+     {"ab{0,3}cdef", "cdef"},
+     {"ab{2}c", "ab"},
+     {"x{y}z", "x{y}z"},
+     {"foo\\.bar\\d+", "foo.bar"},
+     {"[a-z]+/(img|css)/file[[:digit:]]", "/file"},
+     {"(?i)abc", "abc"},
+     {"foo|bar", ""},
+     {"(?x) a b c d", ""},
+     {"\\x41bcdef", ""},
+     {"\\Qa.b\\E", ""},
+     {"(unbalanced", ""},
+     {"[unterminated", ""},
+     {".*", ""}}
+  };
+
+  for (auto const &[pattern, literal] : literals) {
+    CAPTURE(pattern);
+    CHECK(RegexPrefilter::required_literal(pattern) == literal);
+  }
+}
+
+TEST_CASE("RegexPrefilter candidates", "[libts][Regex]")
+{
+  std::array<std::string_view, 5> patterns{
+    {"^/video/([0-9]+)", "^/images/.*\\.png$", ".*", "/IMAGES/thumb", "deo/"}
+  };
+  RegexPrefilter filter;
+  std::vector<int> result;
+
+  for (auto p : patterns) {
+    filter.add(p);
+  }
+  filter.build();
+  REQUIRE(filter.size() == 5);
+
+  filter.candidates("/video/123", result);
+  CHECK(result == std::vector<int>{0, 2, 4});
+  filter.candidates("/images/thumb/a.png", result);
+  CHECK(result == std::vector<int>{1, 2, 3});
+  filter.candidates("/other", result);
+  CHECK(result == std::vector<int>{2});
+}
+
+TEST_CASE("DFA prefilter", "[libts][Regex]")
+{
+  // Enough patterns for the prefilter to be used, with several that can match the same subject.
+  std::vector<std::string> sources;
+  for (int i = 0; i < 40; ++i) {
+    sources.push_back("^/path" + std::to_string(i) + "/.*");
+  }
+  sources.push_back("^/path1.*");
+  sources.push_back(".*\\.jpg$");
+  std::vector<std::string_view> views(sources.begin(), sources.end());
+
+  DFA dfa;
+  REQUIRE(dfa.compile(views.data(), views.size()) == static_cast<int>(views.size()));
+
+  CHECK(dfa.match("/path12/a") == 12);
+  CHECK(dfa.match("/path1x") == 40);
+  CHECK(dfa.match("/other/a.jpg") == 41);
+  CHECK(dfa.match("/path3/a.jpg") == 3);
+  CHECK(dfa.match("/other") == -1);
+}
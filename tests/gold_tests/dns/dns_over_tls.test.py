@@ -0,0 +1,77 @@
+'''
+Verify ATS resolves origin names over DNS over TLS.
+'''
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+import os
+import sys
+
+Test.Summary = '''
+Verify ATS resolves origin names over DNS over TLS.
+'''
+
+
+class DnsOverTlsTest:
+    def __init__(self):
+        self._setupDnsServer()
+        self._setupOriginServer()
+        self._setupTS()
+
+    def _setupDnsServer(self):
+        Test.GetTcpPort("dot_port")
+        ssl_dir = os.path.join(Test.Variables.AtsTestToolsDir, "ssl")
+        self._dns = Test.Processes.Process(
+            "dot_server",
+            f"{sys.executable} {os.path.join(Test.TestDirectory, 'dot_server.py')} {Test.Variables.dot_port} "
+            f"{os.path.join(ssl_dir, 'server.pem')} {os.path.join(ssl_dir, 'server.key')}")
+
+    def _setupOriginServer(self):
+        self._server = Test.MakeOriginServer("server")
+        self._server.addResponse("sessionlog.json",
+                                 {"headers": "GET / HTTP/1.1\r\nHost: dot.test\r\n\r\n"},
+                                 {"headers": "HTTP/1.1 200 OK\r\nServer: microserver\r\nConnection: close\r\n\r\n"})
+
+    def _setupTS(self):
+        self._ts = Test.MakeATSProcess("ts", enable_cache=False)
+        self._ts.Disk.records_config.update({
+            'proxy.config.diags.debug.enabled': 1,
+            'proxy.config.diags.debug.tags': 'dns',
+            'proxy.config.dns.connection_mode': 3,
+            'proxy.config.dns.tls.verify_server': 0,
+            'proxy.config.dns.nameservers': f'127.0.0.1:{Test.Variables.dot_port}',
+            'proxy.config.dns.resolv_conf': 'NULL',
+        })
+        self._ts.Disk.remap_config.AddLine(
+            f"map / http://resolve.over.tls.test:{self._server.Variables.Port}/")
+        self._ts.Disk.traffic_out.Content = Testers.ContainsExpression(
+            "TLS connection to .* established", "The nameserver should be reached over TLS")
+
+    def _testResolve(self):
+        tr = Test.AddTestRun("Resolve the origin over TLS")
+        tr.Processes.Default.StartBefore(self._dns, ready=When.PortOpen(Test.Variables.dot_port))
+        tr.Processes.Default.StartBefore(self._server)
+        tr.Processes.Default.StartBefore(self._ts)
+        tr.Processes.Default.Command = f"curl -s -o /dev/null -w '%{{http_code}}' -H 'Host: dot.test' http://127.0.0.1:{self._ts.Variables.port}/"
+        tr.Processes.Default.ReturnCode = 0
+        tr.Processes.Default.Streams.stdout = Testers.ContainsExpression("200", "The request should be proxied to the origin")
+        tr.StillRunningAfter = self._dns
+        tr.StillRunningAfter = self._ts
+
+    def run(self):
+        self._testResolve()
+
+
+DnsOverTlsTest().run()
@@ -0,0 +1,101 @@
+'''
+A minimal DNS over TLS resolver for tests: answers every A query with one address.
+'''
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+import argparse
+import socket
+import ssl
+import struct
+import sys
+import threading
+
+
+def parse_question(query):
+    '''Return the end offset and the type of the first question.'''
+    offset = 12
+    while query[offset] != 0:
+        offset += query[offset] + 1
+    offset += 1
+    qtype, = struct.unpack('!H', query[offset:offset + 2])
+    return offset + 4, qtype
+
+
+def make_response(query, address):
+    end, qtype = parse_question(query)
+    answers = []
+    if qtype == 1:
+        # Name pointer to the question, A, IN, TTL, the address.
+        answers.append(struct.pack('!HHHIH', 0xc00c, 1, 1, 300, 4) + socket.inet_aton(address))
+    header = query[:2] + struct.pack('!HHHHH', 0x8180, 1, len(answers), 0, 0)
+    return header + query[12:end] + b''.join(answers)
+
+
+def read_exactly(conn, size):
+    data = b''
+    while len(data) < size:
+        chunk = conn.recv(size - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+def serve(conn, address, log):
+    with conn:
+        while True:
+            length = read_exactly(conn, 2)
+            if length is None:
+                return
+            query = read_exactly(conn, struct.unpack('!H', length)[0])
+            if query is None:
+                return
+            response = make_response(query, address)
+            conn.sendall(struct.pack('!H', len(response)) + response)
+            log.write('answered query {}\n'.format(struct.unpack('!H', query[:2])[0]))
+            log.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('port', type=int)
+    parser.add_argument('cert')
+    parser.add_argument('key')
+    parser.add_argument('--address', default='127.0.0.1', help='The address returned for every A query.')
+    args = parser.parse_args()
+
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    context.load_cert_chain(args.cert, args.key)
+
+    listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    listener.bind(('127.0.0.1', args.port))
+    listener.listen()
+    while True:
+        conn, _ = listener.accept()
+        try:
+            tls = context.wrap_socket(conn, server_side=True)
+        except (ssl.SSLError, OSError) as e:
+            sys.stdout.write('handshake failed: {}\n'.format(e))
+            continue
+        sys.stdout.write('accepted TLS connection\n')
+        sys.stdout.flush()
+        threading.Thread(target=serve, args=(tls, args.address, sys.stdout), daemon=True).start()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,148 @@
+/** @file
+
+  Load generator and origin stub for benchmarking Traffic Server.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Histogram.h"
+
+namespace traffic_bench
+{
+using Clock = std::chrono::steady_clock;
+
+inline int64_t
+now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+/** Parse a byte count with an optional k, m or g suffix.
+ *
+ * @return The count, or -1 if @a text is not one.
+ */
+int64_t parse_size(std::string_view text);
+
+enum class Protocol { HTTP1, HTTP2 };
+
+/** The paths requested, in the proportions given.
+ *
+ * Paths either come from a file, one per line with an optional weight in front, or are generated
+ * for the origin stub. Generated paths are for a hot set of cacheable objects with probability
+ * @c hit_ratio, and otherwise for an object that was not requested before, so the hit ratio of the
+ * proxy can be set. The size of each object is drawn from a weighted list of sizes.
+ */
+class RequestMix
+{
+public:
+  /// Load weighted paths from @a path. @return An error message, empty on success.
+  std::string load(std::string const &path);
+
+  /// Set the sizes from a list like "1k:70,64k:25,1m:5". @return An error message, empty on success.
+  std::string set_sizes(std::string_view spec);
+
+  /** The path for the next request.
+   *
+   * @a rng and @a unique belong to the calling thread, @a thread numbers it so that the
+   * paths of objects not requested before differ between threads.
+   */
+  std::string next(std::mt19937_64 &rng, int thread, uint64_t &unique) const;
+
+  /// @return A one line description of the mix.
+  std::string describe() const;
+
+  double hit_ratio = 0.9;
+  int hot_objects  = 1000;
+  int ttl          = 3600; ///< max-age of the objects, in seconds.
+
+private:
+  struct Weighted {
+    std::string value;
+    double cumulative; ///< Sum of the weights up to and including this one.
+  };
+
+  static std::string const &pick(std::vector<Weighted> const &list, double r);
+
+  std::vector<Weighted> _paths;
+  std::vector<Weighted> _sizes{
+    {"1024", 1.0}
+  };
+};
+
+struct Options {
+  std::string host = "127.0.0.1";
+  int port         = 8080;
+  std::string authority; ///< Host header and :authority, host:port if empty.
+  Protocol protocol = Protocol::HTTP1;
+  bool tls          = false;
+  std::string sni;
+  bool tls_resume = false;
+
+  int threads     = 1;
+  int connections = 10; ///< In total, spread over the threads.
+  int streams     = 10; ///< Concurrent streams per HTTP/2 connection.
+  int keepalive   = 0;  ///< Requests per connection, 0 for no limit.
+
+  double duration   = 10; ///< Seconds to run at most.
+  uint64_t requests = 0;  ///< Requests to make at most, 0 for no limit.
+  uint64_t seed     = 1;
+
+  RequestMix mix;
+};
+
+/// What one client thread saw. Threads are combined with @c merge at the end of the run.
+struct Stats {
+  Histogram latency; ///< Nanoseconds from sending the request to the last byte of the response.
+  Histogram ttfb;    ///< Nanoseconds from sending the request to the end of the response header.
+  Histogram connect; ///< Nanoseconds to connect, including the TLS handshake.
+
+  uint64_t responses   = 0;
+  uint64_t errors      = 0;
+  uint64_t bytes       = 0; ///< Body bytes received.
+  uint64_t opened      = 0;
+  uint64_t failed      = 0; ///< Connections that could not be established.
+  uint64_t resumed     = 0; ///< TLS handshakes that resumed a session.
+  int64_t last_done_ns = 0;
+  std::map<int, uint64_t> status;
+
+  void merge(Stats const &that);
+};
+
+/// Run the client described by @a opts, filling in @a stats. @return An error message, empty on success.
+std::string run_client(Options const &opts, Stats &stats);
+
+/** Serve objects for generated paths until killed.
+ *
+ * The query of the path sets the object: @c size is the body size and @c ttl the max-age, with 0
+ * making it uncacheable.
+ *
+ * @return An error message, the server does not return otherwise.
+ */
+std::string run_origin(std::string const &host, int port, int threads);
+} // namespace traffic_bench
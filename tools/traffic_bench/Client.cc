@@ -0,0 +1,1184 @@
+/** @file
+
+  The load generating side of traffic_bench: HTTP/1.1 and HTTP/2 clients, with or without TLS.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "Bench.h"
+#include "Hpack.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+using namespace traffic_bench;
+
+namespace
+{
+constexpr int64_t NS_PER_SEC       = 1000000000;
+constexpr int64_t RETRY_DELAY_NS   = NS_PER_SEC / 10; ///< Before connecting again after a connection failed.
+constexpr int64_t STOP_GRACE_NS    = 2 * NS_PER_SEC;  ///< For requests in flight to finish once the run is over.
+constexpr size_t READ_BUFFER_SIZE  = 64 * 1024;
+constexpr size_t MAX_HEADER_LENGTH = 64 * 1024;
+
+class Connection;
+
+/// A client thread, with its own connections, event loop and statistics.
+class Worker
+{
+public:
+  Worker(Options const &opts, int id, int n_connections, sockaddr_storage const &addr, std::atomic<uint64_t> &issued);
+  ~Worker();
+
+  std::string init();
+  void run(int64_t deadline);
+
+  /** Get the path of the next request to send.
+   *
+   * @return @c false if the run is over, in which case no more requests should be sent.
+   */
+  bool take_request(std::string &path);
+
+  Options const &opts;
+  Stats stats;
+  SSL_CTX *ssl_ctx     = nullptr;
+  SSL_SESSION *session = nullptr; ///< To resume, if enabled.
+  int epoll_fd         = -1;
+  bool stopping        = false;
+  bool alpn_warned     = false;
+  sockaddr_storage const &addr;
+  std::string authority;
+  std::string sni;
+
+private:
+  static int new_session(SSL *ssl, SSL_SESSION *session);
+
+  int _id;
+  std::atomic<uint64_t> &_issued;
+  std::vector<std::unique_ptr<Connection>> _connections;
+  std::mt19937_64 _rng;
+  uint64_t _unique; ///< Starts from the seed, so runs with different seeds request different new objects.
+};
+
+/// A connection to the server. The protocol spoken over it is implemented by subclasses.
+class Connection
+{
+public:
+  explicit Connection(Worker &worker) : _worker(worker) {}
+  virtual ~Connection();
+
+  void open();
+  void close(bool error);
+  void on_event(uint32_t events);
+
+  bool
+  is_open() const
+  {
+    return _state != State::CLOSED;
+  }
+
+  bool
+  is_established() const
+  {
+    return _state == State::OPEN;
+  }
+
+  /// @return @c true if the connection has nothing in flight and will not send more.
+  virtual bool is_done() const = 0;
+
+  int64_t retry_at = 0;
+
+protected:
+  /// The connection is ready for requests.
+  virtual void on_established() = 0;
+  /// @a data was received. @return @c false on a protocol error.
+  virtual bool on_data(std::string_view data) = 0;
+  /// The server closed the connection.
+  virtual void on_eof() {}
+  /// The connection is closing, with whatever was in flight lost.
+  virtual void on_close() = 0;
+
+  /// Send what is in @c out.
+  void flush();
+
+  Worker &_worker;
+  std::string out;
+
+private:
+  enum class State { CLOSED, CONNECTING, HANDSHAKE, OPEN };
+
+  void handshake();
+  void established();
+  void fail();
+  void read_ready();
+  void set_events(uint32_t events);
+
+  State _state     = State::CLOSED;
+  int _fd          = -1;
+  SSL *_ssl        = nullptr;
+  uint32_t _events = 0;
+  int64_t _start   = 0;
+  size_t _out_sent = 0;
+};
+
+Connection::~Connection()
+{
+  // Nothing is reported from here, the subclass is gone.
+  if (_ssl) {
+    SSL_free(_ssl);
+  }
+  if (_fd >= 0) {
+    ::close(_fd);
+  }
+}
+
+void
+Connection::open()
+{
+  sockaddr const *sa = reinterpret_cast<sockaddr const *>(&_worker.addr);
+  socklen_t len      = sa->sa_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+  int one            = 1;
+
+  _fd = socket(sa->sa_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (_fd < 0) {
+    this->fail();
+    return;
+  }
+  setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+  _start    = now_ns();
+  _state    = State::CONNECTING;
+  _out_sent = 0;
+  out.clear();
+  if (connect(_fd, sa, len) < 0 && errno != EINPROGRESS) {
+    this->fail();
+    return;
+  }
+  this->set_events(EPOLLOUT);
+}
+
+void
+Connection::close(bool error)
+{
+  if (_state == State::CLOSED) {
+    return;
+  }
+  if (_state == State::OPEN) {
+    this->on_close();
+  }
+  if (_ssl) {
+    SSL_free(_ssl);
+    _ssl = nullptr;
+  }
+  ::close(_fd);
+  _fd      = -1;
+  _events  = 0;
+  _state   = State::CLOSED;
+  retry_at = now_ns() + (error ? RETRY_DELAY_NS : 0);
+}
+
+void
+Connection::fail()
+{
+  ++_worker.stats.failed;
+  if (_fd >= 0) {
+    this->close(true);
+  } else {
+    retry_at = now_ns() + RETRY_DELAY_NS;
+  }
+}
+
+void
+Connection::set_events(uint32_t events)
+{
+  if (events == _events) {
+    return;
+  }
+
+  epoll_event ev;
+  ev.events   = events;
+  ev.data.ptr = this;
+  epoll_ctl(_worker.epoll_fd, _events ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, _fd, &ev);
+  _events = events;
+}
+
+void
+Connection::on_event(uint32_t events)
+{
+  switch (_state) {
+  case State::CONNECTING: {
+    int err       = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(_fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0) {
+      this->fail();
+    } else if (_worker.ssl_ctx) {
+      _ssl = SSL_new(_worker.ssl_ctx);
+      SSL_set_fd(_ssl, _fd);
+      SSL_set_mode(_ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+      if (!_worker.sni.empty()) {
+        SSL_set_tlsext_host_name(_ssl, _worker.sni.c_str());
+      }
+      if (_worker.session) {
+        SSL_set_session(_ssl, _worker.session);
+      }
+      _state = State::HANDSHAKE;
+      this->handshake();
+    } else {
+      this->established();
+    }
+    break;
+  }
+  case State::HANDSHAKE:
+    this->handshake();
+    break;
+  case State::OPEN:
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+      this->read_ready();
+    }
+    if (_state == State::OPEN) {
+      this->flush();
+    }
+    break;
+  case State::CLOSED:
+    break;
+  }
+
+  if (_state == State::OPEN && this->is_done()) {
+    this->close(false);
+  }
+}
+
+void
+Connection::handshake()
+{
+  int r = SSL_connect(_ssl);
+  if (r == 1) {
+    if (SSL_session_reused(_ssl)) {
+      ++_worker.stats.resumed;
+    }
+    if (_worker.opts.protocol == Protocol::HTTP2) {
+      const unsigned char *proto = nullptr;
+      unsigned len               = 0;
+      SSL_get0_alpn_selected(_ssl, &proto, &len);
+      if (len != 2 || memcmp(proto, "h2", 2) != 0) {
+        if (!_worker.alpn_warned) {
+          fprintf(stderr, "traffic_bench: server did not negotiate h2\n");
+          _worker.alpn_warned = true;
+        }
+        this->fail();
+        return;
+      }
+    }
+    this->established();
+    return;
+  }
+
+  switch (SSL_get_error(_ssl, r)) {
+  case SSL_ERROR_WANT_READ:
+    this->set_events(EPOLLIN);
+    break;
+  case SSL_ERROR_WANT_WRITE:
+    this->set_events(EPOLLIN | EPOLLOUT);
+    break;
+  default:
+    ERR_clear_error();
+    this->fail();
+    break;
+  }
+}
+
+void
+Connection::established()
+{
+  _state = State::OPEN;
+  ++_worker.stats.opened;
+  _worker.stats.connect.record(now_ns() - _start);
+  this->set_events(EPOLLIN);
+  this->on_established();
+  this->flush();
+}
+
+void
+Connection::read_ready()
+{
+  static thread_local char buf[READ_BUFFER_SIZE];
+
+  while (_state == State::OPEN) {
+    ssize_t n;
+    if (_ssl) {
+      n = SSL_read(_ssl, buf, sizeof(buf));
+      if (n <= 0) {
+        int err = SSL_get_error(_ssl, n);
+        if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+          return;
+        }
+        ERR_clear_error();
+        if (err != SSL_ERROR_ZERO_RETURN && !(err == SSL_ERROR_SYSCALL && n == 0)) {
+          this->close(true);
+          return;
+        }
+        n = 0;
+      }
+    } else {
+      n = recv(_fd, buf, sizeof(buf), 0);
+      if (n < 0) {
+        if (errno != EAGAIN && errno != EINTR) {
+          this->close(true);
+        }
+        return;
+      }
+    }
+
+    if (n == 0) {
+      this->on_eof();
+      this->close(false);
+      return;
+    }
+    if (!this->on_data(std::string_view(buf, n))) {
+      this->close(true);
+      return;
+    }
+  }
+}
+
+void
+Connection::flush()
+{
+  while (_state == State::OPEN && _out_sent < out.size()) {
+    ssize_t n;
+    if (_ssl) {
+      n = SSL_write(_ssl, out.data() + _out_sent, out.size() - _out_sent);
+      if (n <= 0) {
+        int err = SSL_get_error(_ssl, n);
+        if (err != SSL_ERROR_WANT_WRITE && err != SSL_ERROR_WANT_READ) {
+          ERR_clear_error();
+          this->close(true);
+          return;
+        }
+        break;
+      }
+    } else {
+      n = send(_fd, out.data() + _out_sent, out.size() - _out_sent, MSG_NOSIGNAL);
+      if (n < 0) {
+        if (errno != EAGAIN && errno != EINTR) {
+          this->close(true);
+          return;
+        }
+        break;
+      }
+    }
+    _out_sent += n;
+  }
+
+  if (_state != State::OPEN) {
+    return;
+  }
+  if (_out_sent == out.size()) {
+    out.clear();
+    _out_sent = 0;
+  }
+  this->set_events(out.empty() ? EPOLLIN : EPOLLIN | EPOLLOUT);
+}
+
+/*-------------------------------------------------------------------------
+  HTTP/1.1
+  -------------------------------------------------------------------------*/
+
+class Http1Connection : public Connection
+{
+public:
+  using Connection::Connection;
+
+  bool
+  is_done() const override
+  {
+    return _state == State::IDLE;
+  }
+
+protected:
+  void on_established() override;
+  bool on_data(std::string_view data) override;
+  void on_eof() override;
+  void on_close() override;
+
+private:
+  enum class State { IDLE, HEADER, BODY_LENGTH, BODY_EOF, CHUNK_SIZE, CHUNK_DATA, CHUNK_END, TRAILER };
+
+  void send_request();
+  bool parse_header();
+  void complete();
+  /// Take one line from @a data into _line. @return @c true if the line is complete.
+  bool take_line(std::string_view &data);
+
+  State _state        = State::IDLE;
+  int _sent           = 0;
+  bool _server_close  = false;
+  int64_t _start      = 0;
+  int _status         = 0;
+  uint64_t _bytes     = 0;
+  uint64_t _remaining = 0;
+  std::string _header;
+  std::string _line;
+};
+
+void
+Http1Connection::on_established()
+{
+  _sent         = 0;
+  _server_close = false;
+  this->send_request();
+}
+
+void
+Http1Connection::send_request()
+{
+  std::string path;
+  int keepalive = _worker.opts.keepalive;
+
+  _state = State::IDLE;
+  if (_server_close || (keepalive > 0 && _sent >= keepalive) || !_worker.take_request(path)) {
+    return;
+  }
+
+  out += "GET " + path + " HTTP/1.1\r\nHost: " + _worker.authority + "\r\nUser-Agent: traffic_bench\r\n\r\n";
+  ++_sent;
+  _start  = now_ns();
+  _state  = State::HEADER;
+  _status = 0;
+  _bytes  = 0;
+  _header.clear();
+}
+
+bool
+Http1Connection::take_line(std::string_view &data)
+{
+  size_t nl = data.find('\n');
+  size_t n  = nl == data.npos ? data.size() : nl + 1;
+
+  _line.append(data.data(), n);
+  data.remove_prefix(n);
+  return nl != data.npos || (!_line.empty() && _line.back() == '\n');
+}
+
+bool
+Http1Connection::on_data(std::string_view data)
+{
+  while (!data.empty()) {
+    switch (_state) {
+    case State::IDLE:
+      // Nothing was asked for
+      return false;
+    case State::HEADER: {
+      size_t scan_from = _header.size() < 3 ? 0 : _header.size() - 3;
+      _header.append(data.data(), data.size());
+      size_t end = _header.find("\r\n\r\n", scan_from);
+      if (end == _header.npos) {
+        if (_header.size() > MAX_HEADER_LENGTH) {
+          return false;
+        }
+        data = {};
+        break;
+      }
+      // Give back what follows the header
+      size_t extra = _header.size() - (end + 4);
+      data         = data.substr(data.size() - extra);
+      _header.resize(end + 4);
+      if (!this->parse_header()) {
+        return false;
+      }
+      break;
+    }
+    case State::BODY_LENGTH: {
+      size_t n    = std::min<uint64_t>(_remaining, data.size());
+      _bytes     += n;
+      _remaining -= n;
+      data.remove_prefix(n);
+      if (_remaining == 0) {
+        this->complete();
+      }
+      break;
+    }
+    case State::BODY_EOF:
+      _bytes += data.size();
+      data   = {};
+      break;
+    case State::CHUNK_SIZE:
+      if (this->take_line(data)) {
+        char *end  = nullptr;
+        _remaining = strtoull(_line.c_str(), &end, 16);
+        if (end == _line.c_str()) {
+          return false;
+        }
+        _line.clear();
+        _state = _remaining ? State::CHUNK_DATA : State::TRAILER;
+      }
+      break;
+    case State::CHUNK_DATA: {
+      size_t n    = std::min<uint64_t>(_remaining, data.size());
+      _bytes     += n;
+      _remaining -= n;
+      data.remove_prefix(n);
+      if (_remaining == 0) {
+        _state = State::CHUNK_END;
+      }
+      break;
+    }
+    case State::CHUNK_END:
+      if (this->take_line(data)) {
+        _line.clear();
+        _state = State::CHUNK_SIZE;
+      }
+      break;
+    case State::TRAILER:
+      if (this->take_line(data)) {
+        bool last = _line == "\r\n" || _line == "\n";
+        _line.clear();
+        if (last) {
+          this->complete();
+        }
+      }
+      break;
+    }
+  }
+  return true;
+}
+
+bool
+Http1Connection::parse_header()
+{
+  std::string_view header{_header};
+  bool chunked          = false;
+  int64_t content_length = -1;
+
+  if (header.size() < 12 || header.substr(0, 5) != "HTTP/") {
+    return false;
+  }
+  _status = atoi(std::string(header.substr(9, 3)).c_str());
+
+  // Informational responses come before the real one
+  if (_status >= 100 && _status < 200) {
+    _header.clear();
+    return true;
+  }
+
+  _server_close = header.substr(0, 8) == "HTTP/1.0";
+  for (size_t pos = header.find("\r\n") + 2; pos < header.size();) {
+    size_t eol            = header.find("\r\n", pos);
+    std::string_view line = header.substr(pos, eol - pos);
+    pos                   = eol + 2;
+
+    size_t colon = line.find(':');
+    if (colon == line.npos) {
+      continue;
+    }
+    std::string name(line.substr(0, colon));
+    std::string_view value = line.substr(colon + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+      value.remove_prefix(1);
+    }
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+    if (name == "content-length") {
+      content_length = strtoll(std::string(value).c_str(), nullptr, 10);
+    } else if (name == "transfer-encoding") {
+      chunked = strncasecmp(value.data(), "chunked", 7) == 0;
+    } else if (name == "connection") {
+      _server_close = strncasecmp(value.data(), "close", 5) == 0;
+    }
+  }
+
+  _worker.stats.ttfb.record(now_ns() - _start);
+  if (_status == 204 || _status == 304 || content_length == 0) {
+    this->complete();
+  } else if (chunked) {
+    _state = State::CHUNK_SIZE;
+    _line.clear();
+  } else if (content_length > 0) {
+    _state     = State::BODY_LENGTH;
+    _remaining = content_length;
+  } else {
+    _state        = State::BODY_EOF;
+    _server_close = true;
+  }
+  return true;
+}
+
+void
+Http1Connection::complete()
+{
+  int64_t now = now_ns();
+  Stats &stats = _worker.stats;
+
+  stats.latency.record(now - _start);
+  ++stats.responses;
+  ++stats.status[_status];
+  stats.bytes        += _bytes;
+  stats.last_done_ns  = now;
+  this->send_request();
+}
+
+void
+Http1Connection::on_eof()
+{
+  if (_state == State::BODY_EOF) {
+    _server_close = true;
+    this->complete();
+  }
+}
+
+void
+Http1Connection::on_close()
+{
+  if (_state != State::IDLE && !_worker.stopping) {
+    ++_worker.stats.errors;
+  }
+  _state = State::IDLE;
+}
+
+/*-------------------------------------------------------------------------
+  HTTP/2
+  -------------------------------------------------------------------------*/
+
+class Http2Connection : public Connection
+{
+public:
+  using Connection::Connection;
+
+  bool
+  is_done() const override
+  {
+    return _streams.empty() && _exhausted;
+  }
+
+protected:
+  void on_established() override;
+  bool on_data(std::string_view data) override;
+  void on_close() override;
+
+private:
+  enum FrameType : uint8_t {
+    DATA          = 0x0,
+    HEADERS       = 0x1,
+    RST_STREAM    = 0x3,
+    SETTINGS      = 0x4,
+    PING          = 0x6,
+    GOAWAY        = 0x7,
+    WINDOW_UPDATE = 0x8,
+    CONTINUATION  = 0x9,
+  };
+  static constexpr uint8_t FLAG_END_STREAM  = 0x1;
+  static constexpr uint8_t FLAG_ACK         = 0x1;
+  static constexpr uint8_t FLAG_END_HEADERS = 0x4;
+  static constexpr uint8_t FLAG_PADDED      = 0x8;
+  static constexpr uint8_t FLAG_PRIORITY    = 0x20;
+
+  static constexpr uint32_t MAX_WINDOW       = 0x7fffffff;
+  static constexpr uint32_t DEFAULT_WINDOW   = 65535;
+  static constexpr uint32_t WINDOW_THRESHOLD = 1 << 30; ///< Received bytes to acknowledge at once.
+
+  struct Stream {
+    int64_t start    = 0;
+    int status       = 0;
+    uint64_t bytes   = 0;
+    uint64_t unacked = 0; ///< Received but not yet acknowledged with a WINDOW_UPDATE.
+  };
+
+  void frame(uint8_t type, uint8_t flags, uint32_t stream, std::string_view payload);
+  void window_update(uint32_t stream, uint32_t increment);
+  void fill();
+  bool on_frame(uint8_t type, uint8_t flags, uint32_t stream_id, std::string_view payload);
+  bool on_header_block(uint32_t stream_id, bool end_stream);
+  void finish(uint32_t stream_id);
+
+  std::unordered_map<uint32_t, Stream> _streams;
+  uint32_t _next_id        = 1;
+  uint32_t _max_concurrent = UINT32_MAX; ///< From the server's SETTINGS.
+  int _sent                = 0;
+  bool _exhausted          = false; ///< No more requests are sent on this connection.
+  uint64_t _unacked        = 0;     ///< Received on the connection but not yet acknowledged.
+  std::string _in;
+  std::string _block; ///< Header block being received.
+  uint32_t _block_stream = 0;
+  bool _block_end_stream = false;
+  HpackDecoder _hpack;
+};
+
+void
+Http2Connection::frame(uint8_t type, uint8_t flags, uint32_t stream, std::string_view payload)
+{
+  char header[9];
+  header[0] = payload.size() >> 16;
+  header[1] = payload.size() >> 8;
+  header[2] = payload.size();
+  header[3] = type;
+  header[4] = flags;
+  stream    = htonl(stream);
+  memcpy(header + 5, &stream, 4);
+  out.append(header, sizeof(header));
+  out.append(payload.data(), payload.size());
+}
+
+void
+Http2Connection::window_update(uint32_t stream, uint32_t increment)
+{
+  increment = htonl(increment);
+  this->frame(WINDOW_UPDATE, 0, stream, std::string_view(reinterpret_cast<char *>(&increment), 4));
+}
+
+void
+Http2Connection::on_established()
+{
+  static const char settings[] = {
+    0x0, 0x2, 0x0, 0x0, 0x0, 0x0,                             // SETTINGS_ENABLE_PUSH 0
+    0x0, 0x4, 0x7f, char(0xff), char(0xff), char(0xff),       // SETTINGS_INITIAL_WINDOW_SIZE MAX_WINDOW
+  };
+
+  _streams.clear();
+  _next_id        = 1;
+  _max_concurrent = UINT32_MAX;
+  _sent           = 0;
+  _exhausted      = false;
+  _unacked        = 0;
+  _block_stream   = 0;
+  _in.clear();
+  _hpack = HpackDecoder();
+
+  out += "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+  this->frame(SETTINGS, 0, 0, std::string_view(settings, sizeof(settings)));
+  this->window_update(0, MAX_WINDOW - DEFAULT_WINDOW);
+  this->fill();
+}
+
+void
+Http2Connection::fill()
+{
+  uint32_t limit = std::min<uint32_t>(_worker.opts.streams, _max_concurrent);
+  int keepalive  = _worker.opts.keepalive;
+  std::string path;
+  std::string block;
+
+  while (!_exhausted && _streams.size() < limit) {
+    if ((keepalive > 0 && _sent >= keepalive) || !_worker.take_request(path)) {
+      _exhausted = true;
+      break;
+    }
+
+    block.clear();
+    hpack_encode_request(block, "GET", _worker.ssl_ctx ? "https" : "http", _worker.authority, path);
+    this->frame(HEADERS, FLAG_END_STREAM | FLAG_END_HEADERS, _next_id, block);
+    _streams[_next_id].start  = now_ns();
+    _next_id                 += 2;
+    ++_sent;
+  }
+}
+
+bool
+Http2Connection::on_data(std::string_view data)
+{
+  _in.append(data.data(), data.size());
+
+  size_t pos = 0;
+  while (_in.size() - pos >= 9) {
+    const uint8_t *h = reinterpret_cast<const uint8_t *>(_in.data() + pos);
+    uint32_t length  = (h[0] << 16) | (h[1] << 8) | h[2];
+    uint32_t stream  = ((h[5] & 0x7f) << 24) | (h[6] << 16) | (h[7] << 8) | h[8];
+    if (_in.size() - pos - 9 < length) {
+      break;
+    }
+    if (!this->on_frame(h[3], h[4], stream, std::string_view(_in.data() + pos + 9, length))) {
+      return false;
+    }
+    pos += 9 + length;
+  }
+  _in.erase(0, pos);
+
+  this->fill();
+  return true;
+}
+
+bool
+Http2Connection::on_frame(uint8_t type, uint8_t flags, uint32_t stream_id, std::string_view payload)
+{
+  // A header block must not be interrupted by other frames
+  if (_block_stream != 0 && (type != CONTINUATION || stream_id != _block_stream)) {
+    return false;
+  }
+
+  switch (type) {
+  case DATA: {
+    size_t length = payload.size();
+    if ((flags & FLAG_PADDED) && !payload.empty()) {
+      length -= std::min<size_t>(length, 1 + uint8_t(payload[0]));
+    }
+
+    _unacked += payload.size();
+    if (_unacked >= WINDOW_THRESHOLD) {
+      this->window_update(0, _unacked);
+      _unacked = 0;
+    }
+
+    auto spot = _streams.find(stream_id);
+    if (spot != _streams.end()) {
+      Stream &stream  = spot->second;
+      stream.bytes   += length;
+      stream.unacked += payload.size();
+      if (stream.unacked >= WINDOW_THRESHOLD && !(flags & FLAG_END_STREAM)) {
+        this->window_update(stream_id, stream.unacked);
+        stream.unacked = 0;
+      }
+      if (flags & FLAG_END_STREAM) {
+        this->finish(stream_id);
+      }
+    }
+    break;
+  }
+  case HEADERS: {
+    size_t skip = 0;
+    size_t pad  = 0;
+    if (flags & FLAG_PADDED) {
+      if (payload.empty()) {
+        return false;
+      }
+      pad  = uint8_t(payload[0]);
+      skip = 1;
+    }
+    if (flags & FLAG_PRIORITY) {
+      skip += 5;
+    }
+    if (skip + pad > payload.size()) {
+      return false;
+    }
+    _block.assign(payload.data() + skip, payload.size() - skip - pad);
+    _block_stream     = stream_id;
+    _block_end_stream = flags & FLAG_END_STREAM;
+    if (flags & FLAG_END_HEADERS) {
+      return this->on_header_block(stream_id, _block_end_stream);
+    }
+    break;
+  }
+  case CONTINUATION:
+    _block.append(payload.data(), payload.size());
+    if (flags & FLAG_END_HEADERS) {
+      return this->on_header_block(stream_id, _block_end_stream);
+    }
+    break;
+  case RST_STREAM:
+    if (_streams.erase(stream_id) && !_worker.stopping) {
+      ++_worker.stats.errors;
+    }
+    break;
+  case SETTINGS:
+    if (!(flags & FLAG_ACK)) {
+      for (size_t i = 0; i + 6 <= payload.size(); i += 6) {
+        const uint8_t *s = reinterpret_cast<const uint8_t *>(payload.data() + i);
+        if (((s[0] << 8) | s[1]) == 0x3) {
+          _max_concurrent = (uint32_t(s[2]) << 24) | (s[3] << 16) | (s[4] << 8) | s[5];
+        }
+      }
+      this->frame(SETTINGS, FLAG_ACK, 0, {});
+    }
+    break;
+  case PING:
+    if (!(flags & FLAG_ACK)) {
+      this->frame(PING, FLAG_ACK, 0, payload);
+    }
+    break;
+  case GOAWAY: {
+    if (payload.size() < 4) {
+      return false;
+    }
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(payload.data());
+    uint32_t last    = ((p[0] & 0x7f) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+    for (auto spot = _streams.begin(); spot != _streams.end();) {
+      if (spot->first > last) {
+        if (!_worker.stopping) {
+          ++_worker.stats.errors;
+        }
+        spot = _streams.erase(spot);
+      } else {
+        ++spot;
+      }
+    }
+    _exhausted = true;
+    break;
+  }
+  default:
+    break;
+  }
+  return true;
+}
+
+bool
+Http2Connection::on_header_block(uint32_t stream_id, bool end_stream)
+{
+  int status = 0;
+
+  _block_stream = 0;
+  // Blocks of streams that are gone must be decoded too, to keep the table in step with the server.
+  if (!_hpack.decode(_block, [&status](std::string_view name, std::string_view value) {
+        if (name == ":status") {
+          status = atoi(std::string(value).c_str());
+        }
+      })) {
+    return false;
+  }
+
+  auto spot = _streams.find(stream_id);
+  if (spot == _streams.end()) {
+    return true;
+  }
+  // Informational responses and trailers do not set the status
+  if (status >= 200 && spot->second.status == 0) {
+    spot->second.status = status;
+    _worker.stats.ttfb.record(now_ns() - spot->second.start);
+  }
+  if (end_stream) {
+    this->finish(stream_id);
+  }
+  return true;
+}
+
+void
+Http2Connection::finish(uint32_t stream_id)
+{
+  auto spot    = _streams.find(stream_id);
+  int64_t now  = now_ns();
+  Stats &stats = _worker.stats;
+
+  stats.latency.record(now - spot->second.start);
+  ++stats.responses;
+  ++stats.status[spot->second.status];
+  stats.bytes        += spot->second.bytes;
+  stats.last_done_ns  = now;
+  _streams.erase(spot);
+}
+
+void
+Http2Connection::on_close()
+{
+  if (!_worker.stopping) {
+    _worker.stats.errors += _streams.size();
+  }
+  _streams.clear();
+}
+
+/*-------------------------------------------------------------------------
+  Worker
+  -------------------------------------------------------------------------*/
+
+Worker::Worker(Options const &opts, int id, int n_connections, sockaddr_storage const &addr, std::atomic<uint64_t> &issued)
+  : opts(opts), addr(addr), _id(id), _issued(issued), _rng(opts.seed + id), _unique(opts.seed << 32)
+{
+  for (int i = 0; i < n_connections; ++i) {
+    if (opts.protocol == Protocol::HTTP2) {
+      _connections.emplace_back(new Http2Connection(*this));
+    } else {
+      _connections.emplace_back(new Http1Connection(*this));
+    }
+  }
+}
+
+Worker::~Worker()
+{
+  _connections.clear();
+  if (session) {
+    SSL_SESSION_free(session);
+  }
+  if (ssl_ctx) {
+    SSL_CTX_free(ssl_ctx);
+  }
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
+  }
+}
+
+int
+Worker::new_session(SSL *ssl, SSL_SESSION *session)
+{
+  Worker *self = static_cast<Worker *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+  if (self->session) {
+    SSL_SESSION_free(self->session);
+  }
+  self->session = session;
+  return 1;
+}
+
+std::string
+Worker::init()
+{
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0) {
+    return std::string("epoll_create1: ") + strerror(errno);
+  }
+
+  authority = opts.authority;
+  if (authority.empty()) {
+    authority = opts.host + ":" + std::to_string(opts.port);
+  }
+
+  if (!opts.tls) {
+    return {};
+  }
+
+  ssl_ctx = SSL_CTX_new(TLS_client_method());
+  if (!ssl_ctx) {
+    return "can not create the TLS context";
+  }
+  SSL_CTX_set_verify(ssl_ctx, SSL_VERIFY_NONE, nullptr);
+  if (opts.protocol == Protocol::HTTP2) {
+    SSL_CTX_set_alpn_protos(ssl_ctx, reinterpret_cast<const unsigned char *>("\x02h2"), 3);
+  } else {
+    SSL_CTX_set_alpn_protos(ssl_ctx, reinterpret_cast<const unsigned char *>("\x08http/1.1"), 9);
+  }
+  if (opts.tls_resume) {
+    SSL_CTX_set_app_data(ssl_ctx, this);
+    SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ssl_ctx, &Worker::new_session);
+  } else {
+    SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(ssl_ctx, SSL_OP_NO_TICKET);
+  }
+
+  sni = opts.sni;
+  in6_addr ignored;
+  bool literal = inet_pton(AF_INET, opts.host.c_str(), &ignored) == 1 || inet_pton(AF_INET6, opts.host.c_str(), &ignored) == 1;
+  if (sni.empty() && !literal) {
+    sni = opts.host;
+  }
+  return {};
+}
+
+bool
+Worker::take_request(std::string &path)
+{
+  if (stopping) {
+    return false;
+  }
+  if (opts.requests > 0 && _issued.fetch_add(1) >= opts.requests) {
+    stopping = true;
+    return false;
+  }
+  path = opts.mix.next(_rng, _id, _unique);
+  return true;
+}
+
+void
+Worker::run(int64_t deadline)
+{
+  epoll_event events[256];
+  int64_t stop_by = 0;
+
+  for (auto &conn : _connections) {
+    conn->open();
+  }
+
+  while (true) {
+    int64_t now = now_ns();
+
+    if (!stopping && now >= deadline) {
+      stopping = true;
+    }
+    if (stopping) {
+      stop_by = stop_by ? stop_by : now + STOP_GRACE_NS;
+
+      bool busy = false;
+      for (auto &conn : _connections) {
+        if (conn->is_open() && (!conn->is_established() || conn->is_done())) {
+          conn->close(false);
+        }
+        busy = busy || conn->is_open();
+      }
+      if (!busy || now >= stop_by) {
+        break;
+      }
+    } else {
+      for (auto &conn : _connections) {
+        if (!conn->is_open() && now >= conn->retry_at) {
+          conn->open();
+        }
+      }
+    }
+
+    int n = epoll_wait(epoll_fd, events, sizeof(events) / sizeof(events[0]), 10);
+    for (int i = 0; i < n; ++i) {
+      static_cast<Connection *>(events[i].data.ptr)->on_event(events[i].events);
+    }
+  }
+
+  for (auto &conn : _connections) {
+    conn->close(false);
+  }
+}
+} // namespace
+
+std::string
+traffic_bench::run_client(Options const &opts, Stats &stats)
+{
+  addrinfo hints;
+  addrinfo *result = nullptr;
+  sockaddr_storage addr;
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_socktype = SOCK_STREAM;
+  if (int r = getaddrinfo(opts.host.c_str(), std::to_string(opts.port).c_str(), &hints, &result); r != 0) {
+    return "can not resolve " + opts.host + ": " + gai_strerror(r);
+  }
+  memset(&addr, 0, sizeof(addr));
+  memcpy(&addr, result->ai_addr, result->ai_addrlen);
+  freeaddrinfo(result);
+
+  std::atomic<uint64_t> issued{0};
+  std::vector<std::unique_ptr<Worker>> workers;
+  for (int i = 0; i < opts.threads; ++i) {
+    int n = opts.connections / opts.threads + (i < opts.connections % opts.threads ? 1 : 0);
+    workers.emplace_back(new Worker(opts, i, n, addr, issued));
+    if (std::string error = workers.back()->init(); !error.empty()) {
+      return error;
+    }
+  }
+
+  int64_t deadline = now_ns() + int64_t(opts.duration * NS_PER_SEC);
+  std::vector<std::thread> threads;
+  for (auto &worker : workers) {
+    threads.emplace_back([&worker, deadline]() { worker->run(deadline); });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto &worker : workers) {
+    stats.merge(worker->stats);
+  }
+  return {};
+}
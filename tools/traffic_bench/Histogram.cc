@@ -0,0 +1,140 @@
+/** @file
+
+  Latency histogram with bounded relative error, in the style of HdrHistogram.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "Histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace traffic_bench;
+
+Histogram::Histogram() : _counts(index_of(UINT64_MAX) + 1, 0) {}
+
+size_t
+Histogram::index_of(uint64_t value)
+{
+  if (value < SUB_BUCKET_COUNT) {
+    return value;
+  }
+  int bucket = (63 - __builtin_clzll(value)) - (SUB_BUCKET_BITS - 1);
+  return bucket * SUB_BUCKET_HALF + (value >> bucket);
+}
+
+uint64_t
+Histogram::value_of(size_t index)
+{
+  if (index < SUB_BUCKET_COUNT) {
+    return index;
+  }
+  int bucket   = index / SUB_BUCKET_HALF - 1;
+  uint64_t sub = index - bucket * SUB_BUCKET_HALF;
+  return (sub << bucket) + ((uint64_t(1) << bucket) - 1);
+}
+
+void
+Histogram::record(uint64_t value)
+{
+  ++_counts[index_of(value)];
+  ++_count;
+  _sum += value;
+  _max = std::max(_max, value);
+}
+
+void
+Histogram::merge(Histogram const &that)
+{
+  for (size_t i = 0; i < _counts.size(); ++i) {
+    _counts[i] += that._counts[i];
+  }
+  _count += that._count;
+  _sum   += that._sum;
+  _max   = std::max(_max, that._max);
+}
+
+double
+Histogram::mean() const
+{
+  return _count ? _sum / _count : 0;
+}
+
+double
+Histogram::stddev() const
+{
+  if (_count == 0) {
+    return 0;
+  }
+
+  double mean = this->mean();
+  double sum  = 0;
+  for (size_t i = 0; i < _counts.size(); ++i) {
+    if (_counts[i]) {
+      double delta = value_of(i) - mean;
+      sum          += delta * delta * _counts[i];
+    }
+  }
+  return std::sqrt(sum / _count);
+}
+
+uint64_t
+Histogram::percentile(double percentile) const
+{
+  if (_count == 0) {
+    return 0;
+  }
+
+  uint64_t target = std::max<uint64_t>(1, std::ceil(_count * std::min(percentile, 100.0) / 100.0));
+  uint64_t seen   = 0;
+  for (size_t i = 0; i < _counts.size(); ++i) {
+    seen += _counts[i];
+    if (seen >= target) {
+      return std::min(value_of(i), _max);
+    }
+  }
+  return _max;
+}
+
+void
+Histogram::print_distribution(FILE *out, double scale) const
+{
+  fprintf(out, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < _counts.size(); ++i) {
+    if (_counts[i] == 0) {
+      continue;
+    }
+    seen              += _counts[i];
+    double percentile = double(seen) / _count;
+    double value      = std::min(value_of(i), _max) / scale;
+    if (seen < _count) {
+      fprintf(out, "%12.3f %14.12f %10llu %14.2f\n", value, percentile, static_cast<unsigned long long>(seen),
+              1 / (1 - percentile));
+    } else {
+      fprintf(out, "%12.3f %14.12f %10llu\n", value, percentile, static_cast<unsigned long long>(seen));
+    }
+  }
+
+  fprintf(out, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean() / scale, stddev() / scale);
+  fprintf(out, "#[Max     = %12.3f, Total count    = %12llu]\n", _max / scale, static_cast<unsigned long long>(_count));
+  fprintf(out, "#[Buckets = %12zu, SubBuckets     = %12d]\n", _counts.size() / SUB_BUCKET_HALF - 1, SUB_BUCKET_COUNT);
+}
@@ -0,0 +1,84 @@
+/** @file
+
+  Latency histogram with bounded relative error, in the style of HdrHistogram.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace traffic_bench
+{
+/** Counts of recorded values, kept in buckets whose width is proportional to their value.
+ *
+ * Values below 2048 are counted exactly. Above that every power of two range is split into 1024
+ * buckets, so a reported value is within 0.1% of the recorded one. Histograms from different
+ * threads are combined with @c merge.
+ */
+class Histogram
+{
+public:
+  Histogram();
+
+  void record(uint64_t value);
+  void merge(Histogram const &that);
+
+  uint64_t
+  count() const
+  {
+    return _count;
+  }
+
+  uint64_t
+  max() const
+  {
+    return _max;
+  }
+
+  double mean() const;
+  double stddev() const;
+
+  /// @return The smallest value that at least @a percentile percent of the values are at or below.
+  uint64_t percentile(double percentile) const;
+
+  /** Write the distribution in the HdrHistogram percentile text format.
+   *
+   * @a scale divides the values, to print them in a larger unit than they were recorded in.
+   */
+  void print_distribution(FILE *out, double scale) const;
+
+private:
+  static constexpr int SUB_BUCKET_BITS  = 11;
+  static constexpr int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+  static constexpr int SUB_BUCKET_HALF  = SUB_BUCKET_COUNT / 2;
+
+  static size_t index_of(uint64_t value);
+  /// @return The largest value counted in the bucket at @a index.
+  static uint64_t value_of(size_t index);
+
+  std::vector<uint64_t> _counts;
+  uint64_t _count = 0;
+  uint64_t _max   = 0;
+  double _sum     = 0;
+};
+} // namespace traffic_bench
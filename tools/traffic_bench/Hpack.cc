@@ -0,0 +1,260 @@
+/** @file
+
+  The parts of HPACK (RFC 7541) the HTTP/2 client needs.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "Hpack.h"
+
+#include "XPACK.h"
+
+using namespace traffic_bench;
+
+namespace
+{
+struct StaticEntry {
+  std::string_view name;
+  std::string_view value;
+};
+
+// RFC 7541 Appendix A, indexed from 1.
+const StaticEntry STATIC_TABLE[] = {
+  {"",                            ""             },
+  {":authority",                  ""             },
+  {":method",                     "GET"          },
+  {":method",                     "POST"         },
+  {":path",                       "/"            },
+  {":path",                       "/index.html"  },
+  {":scheme",                     "http"         },
+  {":scheme",                     "https"        },
+  {":status",                     "200"          },
+  {":status",                     "204"          },
+  {":status",                     "206"          },
+  {":status",                     "304"          },
+  {":status",                     "400"          },
+  {":status",                     "404"          },
+  {":status",                     "500"          },
+  {"accept-charset",              ""             },
+  {"accept-encoding",             "gzip, deflate"},
+  {"accept-language",             ""             },
+  {"accept-ranges",               ""             },
+  {"accept",                      ""             },
+  {"access-control-allow-origin", ""             },
+  {"age",                         ""             },
+  {"allow",                       ""             },
+  {"authorization",               ""             },
+  {"cache-control",               ""             },
+  {"content-disposition",         ""             },
+  {"content-encoding",            ""             },
+  {"content-language",            ""             },
+  {"content-length",              ""             },
+  {"content-location",            ""             },
+  {"content-range",               ""             },
+  {"content-type",                ""             },
+  {"cookie",                      ""             },
+  {"date",                        ""             },
+  {"etag",                        ""             },
+  {"expect",                      ""             },
+  {"expires",                     ""             },
+  {"from",                        ""             },
+  {"host",                        ""             },
+  {"if-match",                    ""             },
+  {"if-modified-since",           ""             },
+  {"if-none-match",               ""             },
+  {"if-range",                    ""             },
+  {"if-unmodified-since",         ""             },
+  {"last-modified",               ""             },
+  {"link",                        ""             },
+  {"location",                    ""             },
+  {"max-forwards",                ""             },
+  {"proxy-authenticate",          ""             },
+  {"proxy-authorization",         ""             },
+  {"range",                       ""             },
+  {"referer",                     ""             },
+  {"refresh",                     ""             },
+  {"retry-after",                 ""             },
+  {"server",                      ""             },
+  {"set-cookie",                  ""             },
+  {"strict-transport-security",   ""             },
+  {"transfer-encoding",           ""             },
+  {"user-agent",                  ""             },
+  {"vary",                        ""             },
+  {"via",                         ""             },
+  {"www-authenticate",            ""             },
+};
+constexpr uint64_t STATIC_TABLE_SIZE = sizeof(STATIC_TABLE) / sizeof(STATIC_TABLE[0]) - 1;
+
+// Entries are accounted with this overhead on top of their name and value (RFC 7541 4.1).
+constexpr size_t ENTRY_OVERHEAD = 32;
+
+// Indices into STATIC_TABLE used to encode requests.
+constexpr uint64_t INDEX_AUTHORITY    = 1;
+constexpr uint64_t INDEX_METHOD_GET   = 2;
+constexpr uint64_t INDEX_METHOD       = 2;
+constexpr uint64_t INDEX_PATH         = 4;
+constexpr uint64_t INDEX_SCHEME_HTTP  = 6;
+constexpr uint64_t INDEX_SCHEME_HTTPS = 7;
+
+void
+append_integer(std::string &out, uint8_t prefix, uint64_t value, uint8_t n)
+{
+  uint8_t buf[16] = {prefix};
+  int64_t len     = xpack_encode_integer(buf, buf + sizeof(buf), value, n);
+  out.append(reinterpret_cast<char *>(buf), len);
+}
+
+// A field the server must not add to its dynamic table, with its name taken from the static table.
+void
+append_literal(std::string &out, uint64_t name_index, std::string_view value)
+{
+  append_integer(out, 0x00, name_index, 4);
+
+  std::string buf(value.size() * 2 + 16, '\0');
+  uint8_t *start = reinterpret_cast<uint8_t *>(buf.data());
+  int64_t len    = xpack_encode_string(start, start + buf.size(), value.data(), value.size());
+  out.append(buf.data(), len);
+}
+} // namespace
+
+void
+traffic_bench::hpack_encode_request(std::string &out, std::string_view method, std::string_view scheme, std::string_view authority,
+                                    std::string_view path)
+{
+  if (method == "GET") {
+    append_integer(out, 0x80, INDEX_METHOD_GET, 7);
+  } else {
+    append_literal(out, INDEX_METHOD, method);
+  }
+  append_integer(out, 0x80, scheme == "https" ? INDEX_SCHEME_HTTPS : INDEX_SCHEME_HTTP, 7);
+  append_literal(out, INDEX_AUTHORITY, authority);
+  append_literal(out, INDEX_PATH, path);
+}
+
+bool
+HpackDecoder::lookup(uint64_t index, std::string_view &name, std::string_view &value) const
+{
+  if (index == 0) {
+    return false;
+  }
+  if (index <= STATIC_TABLE_SIZE) {
+    name  = STATIC_TABLE[index].name;
+    value = STATIC_TABLE[index].value;
+    return true;
+  }
+  index -= STATIC_TABLE_SIZE + 1;
+  if (index >= _table.size()) {
+    return false;
+  }
+  name  = _table[index].name;
+  value = _table[index].value;
+  return true;
+}
+
+void
+HpackDecoder::evict(size_t max_size)
+{
+  while (_size > max_size && !_table.empty()) {
+    _size -= _table.back().name.size() + _table.back().value.size() + ENTRY_OVERHEAD;
+    _table.pop_back();
+  }
+}
+
+void
+HpackDecoder::insert(std::string_view name, std::string_view value)
+{
+  // Copy first, the name may refer to an entry that is evicted.
+  Entry entry{std::string(name), std::string(value)};
+  size_t size = name.size() + value.size() + ENTRY_OVERHEAD;
+
+  // An entry larger than the table empties it and is not added.
+  this->evict(size > _max_size ? 0 : _max_size - size);
+  if (size <= _max_size) {
+    _table.push_front(std::move(entry));
+    _size += size;
+  }
+}
+
+bool
+HpackDecoder::decode(std::string_view block, FieldFunc const &field)
+{
+  const uint8_t *p   = reinterpret_cast<const uint8_t *>(block.data());
+  const uint8_t *end = p + block.size();
+  Arena arena;
+
+  while (p < end) {
+    uint64_t index = 0;
+    int64_t len;
+    std::string_view name;
+    std::string_view value;
+
+    if (*p & 0x80) {
+      // Indexed header field
+      if ((len = xpack_decode_integer(index, p, end, 7)) < 0 || !this->lookup(index, name, value)) {
+        return false;
+      }
+      p += len;
+      field(name, value);
+      continue;
+    }
+
+    if ((*p & 0xe0) == 0x20) {
+      // Dynamic table size update
+      uint64_t size = 0;
+      if ((len = xpack_decode_integer(size, p, end, 5)) < 0 || size > 4096) {
+        return false;
+      }
+      p         += len;
+      _max_size = size;
+      this->evict(_max_size);
+      continue;
+    }
+
+    // Literal header field, with incremental indexing if the top bits are 01
+    bool indexing = (*p & 0xc0) == 0x40;
+    uint8_t n     = indexing ? 6 : 4;
+    if ((len = xpack_decode_integer(index, p, end, n)) < 0) {
+      return false;
+    }
+    p += len;
+
+    char *str;
+    uint64_t str_len;
+    if (index == 0) {
+      if ((len = xpack_decode_string(arena, &str, str_len, p, end)) < 0) {
+        return false;
+      }
+      p    += len;
+      name = std::string_view(str, str_len);
+    } else if (!this->lookup(index, name, value)) {
+      return false;
+    }
+    if ((len = xpack_decode_string(arena, &str, str_len, p, end)) < 0) {
+      return false;
+    }
+    p     += len;
+    value = std::string_view(str, str_len);
+
+    field(name, value);
+    if (indexing) {
+      this->insert(name, value);
+    }
+  }
+  return true;
+}
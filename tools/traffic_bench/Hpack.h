@@ -0,0 +1,67 @@
+/** @file
+
+  The parts of HPACK (RFC 7541) the HTTP/2 client needs.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace traffic_bench
+{
+/** Append the header block of a request to @a out.
+ *
+ * Nothing is added to the server's dynamic table, so blocks can be encoded in any order.
+ */
+void hpack_encode_request(std::string &out, std::string_view method, std::string_view scheme, std::string_view authority,
+                          std::string_view path);
+
+/// Decodes the header blocks of the responses on one connection.
+class HpackDecoder
+{
+public:
+  using FieldFunc = std::function<void(std::string_view name, std::string_view value)>;
+
+  /** Decode the header block in @a block, calling @a field for each field in it.
+   *
+   * @return @c false if the block is malformed, in which case the connection can not be used any more.
+   */
+  bool decode(std::string_view block, FieldFunc const &field);
+
+private:
+  struct Entry {
+    std::string name;
+    std::string value;
+  };
+
+  bool lookup(uint64_t index, std::string_view &name, std::string_view &value) const;
+  void insert(std::string_view name, std::string_view value);
+  void evict(size_t max_size);
+
+  std::deque<Entry> _table; ///< Dynamic table, newest first.
+  size_t _size     = 0;
+  size_t _max_size = 4096; ///< SETTINGS_HEADER_TABLE_SIZE, which the client leaves at its default.
+};
+} // namespace traffic_bench
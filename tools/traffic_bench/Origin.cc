@@ -0,0 +1,268 @@
+/** @file
+
+  The origin stub of traffic_bench, serving objects of the size and freshness asked for in the path.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <strings.h>
+#include <thread>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace traffic_bench;
+
+namespace
+{
+constexpr size_t BODY_BUFFER_SIZE  = 64 * 1024;
+constexpr size_t MAX_HEADER_LENGTH = 64 * 1024;
+
+char body_buffer[BODY_BUFFER_SIZE];
+
+/// A client connection, answering one request at a time.
+struct OriginConnection {
+  int fd = -1;
+  std::string in;
+  std::string header; ///< Response header not yet sent.
+  size_t header_sent = 0;
+  uint64_t body_left = 0; ///< Response body not yet sent.
+  bool close_after   = false;
+  bool writing       = false; ///< Registered for EPOLLOUT.
+};
+
+// The value of @a name in the query of @a target, or @a dflt if it is not there.
+int64_t
+query_value(std::string_view target, std::string_view name, int64_t dflt)
+{
+  size_t q = target.find('?');
+  if (q == target.npos) {
+    return dflt;
+  }
+
+  std::string_view query = target.substr(q + 1);
+  while (!query.empty()) {
+    std::string_view item = query.substr(0, query.find('&'));
+    query.remove_prefix(std::min(query.size(), item.size() + 1));
+    if (item.size() > name.size() && item.substr(0, name.size()) == name && item[name.size()] == '=') {
+      int64_t value = parse_size(item.substr(name.size() + 1));
+      return value < 0 ? dflt : value;
+    }
+  }
+  return dflt;
+}
+
+// Start the response to the next request in @a conn, if a whole one was received.
+// @return @c false if the request is malformed.
+bool
+next_request(OriginConnection &conn)
+{
+  size_t end = conn.in.find("\r\n\r\n");
+  if (end == conn.in.npos) {
+    return conn.in.size() <= MAX_HEADER_LENGTH;
+  }
+
+  std::string_view request(conn.in.data(), end + 4);
+  size_t sp1 = request.find(' ');
+  size_t sp2 = sp1 == request.npos ? request.npos : request.find(' ', sp1 + 1);
+  if (sp2 == request.npos) {
+    return false;
+  }
+  std::string_view method = request.substr(0, sp1);
+  std::string_view target = request.substr(sp1 + 1, sp2 - sp1 - 1);
+
+  // A close header anywhere is enough, the clients are ours.
+  for (size_t pos = request.find("\r\n"); pos != request.npos && pos + 2 < request.size(); pos = request.find("\r\n", pos + 2)) {
+    if (strncasecmp(request.data() + pos + 2, "connection: close", 17) == 0) {
+      conn.close_after = true;
+    }
+  }
+  if (request.substr(sp2 + 1, 8) == "HTTP/1.0") {
+    conn.close_after = true;
+  }
+
+  int64_t size = query_value(target, "size", 1024);
+  int64_t ttl  = query_value(target, "ttl", 3600);
+
+  conn.header = "HTTP/1.1 200 OK\r\nServer: traffic_bench\r\nContent-Type: application/octet-stream\r\nContent-Length: " +
+                std::to_string(size) + "\r\n";
+  conn.header += ttl > 0 ? "Cache-Control: max-age=" + std::to_string(ttl) + "\r\n" : "Cache-Control: no-store\r\n";
+  conn.header += conn.close_after ? "Connection: close\r\n\r\n" : "\r\n";
+
+  conn.header_sent = 0;
+  conn.body_left   = method == "HEAD" ? 0 : size;
+
+  conn.in.erase(0, end + 4);
+  return true;
+}
+
+// Send what can be sent of the current response. @return @c false if the connection should be closed.
+bool
+send_response(OriginConnection &conn)
+{
+  while (conn.header_sent < conn.header.size() || conn.body_left > 0) {
+    ssize_t n;
+    if (conn.header_sent < conn.header.size()) {
+      n = send(conn.fd, conn.header.data() + conn.header_sent, conn.header.size() - conn.header_sent, MSG_NOSIGNAL | MSG_MORE);
+    } else {
+      n = send(conn.fd, body_buffer, std::min<uint64_t>(conn.body_left, sizeof(body_buffer)), MSG_NOSIGNAL);
+    }
+    if (n < 0) {
+      return errno == EAGAIN || errno == EINTR;
+    }
+
+    if (conn.header_sent < conn.header.size()) {
+      conn.header_sent += n;
+    } else {
+      conn.body_left -= n;
+    }
+  }
+
+  conn.header.clear();
+  conn.header_sent = 0;
+  return true;
+}
+
+bool
+response_pending(OriginConnection const &conn)
+{
+  return conn.header_sent < conn.header.size() || conn.body_left > 0;
+}
+
+void
+serve(int listen_fd)
+{
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  epoll_event events[256];
+  epoll_event ev;
+
+  ev.events   = EPOLLIN;
+  ev.data.ptr = nullptr;
+  epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &ev);
+
+  while (true) {
+    int n = epoll_wait(epoll_fd, events, sizeof(events) / sizeof(events[0]), -1);
+    for (int i = 0; i < n; ++i) {
+      auto *conn = static_cast<OriginConnection *>(events[i].data.ptr);
+
+      if (conn == nullptr) {
+        int fd;
+        while ((fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+          int one = 1;
+          setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+          conn        = new OriginConnection;
+          conn->fd    = fd;
+          ev.events   = EPOLLIN;
+          ev.data.ptr = conn;
+          epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+        }
+        continue;
+      }
+
+      bool ok = true;
+      if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+        char buf[16 * 1024];
+        ssize_t r;
+        while ((r = recv(conn->fd, buf, sizeof(buf), 0)) > 0) {
+          conn->in.append(buf, r);
+        }
+        ok = r < 0 && (errno == EAGAIN || errno == EINTR);
+      }
+
+      // Answer requests in order, starting the next only when the last one is sent.
+      while (ok) {
+        if (response_pending(*conn)) {
+          if (!(ok = send_response(*conn)) || response_pending(*conn)) {
+            break;
+          }
+        }
+        if (conn->close_after) {
+          ok = false;
+          break;
+        }
+        size_t before = conn->in.size();
+        if (!(ok = next_request(*conn)) || conn->in.size() == before) {
+          break;
+        }
+      }
+
+      if (!ok) {
+        close(conn->fd);
+        delete conn;
+        continue;
+      }
+      if (response_pending(*conn) != conn->writing) {
+        conn->writing = !conn->writing;
+        ev.events     = conn->writing ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        ev.data.ptr   = conn;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn->fd, &ev);
+      }
+    }
+  }
+}
+} // namespace
+
+std::string
+traffic_bench::run_origin(std::string const &host, int port, int threads)
+{
+  addrinfo hints;
+  addrinfo *result = nullptr;
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags    = AI_PASSIVE;
+  if (int r = getaddrinfo(host.empty() ? nullptr : host.c_str(), std::to_string(port).c_str(), &hints, &result); r != 0) {
+    return "can not resolve " + host + ": " + gai_strerror(r);
+  }
+
+  // One listening socket per thread, the kernel spreads the connections over them.
+  std::vector<int> listeners;
+  for (int i = 0; i < threads; ++i) {
+    int one = 1;
+    int fd  = socket(result->ai_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) < 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0 || bind(fd, result->ai_addr, result->ai_addrlen) < 0 ||
+        listen(fd, 1024) < 0) {
+      std::string error = "can not listen on port " + std::to_string(port) + ": " + strerror(errno);
+      freeaddrinfo(result);
+      return error;
+    }
+    listeners.push_back(fd);
+  }
+  freeaddrinfo(result);
+
+  memset(body_buffer, 'x', sizeof(body_buffer));
+  std::vector<std::thread> workers;
+  for (int fd : listeners) {
+    workers.emplace_back(serve, fd);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return {};
+}
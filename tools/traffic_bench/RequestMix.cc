@@ -0,0 +1,207 @@
+/** @file
+
+  The requests a benchmark run makes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace traffic_bench;
+
+int64_t
+traffic_bench::parse_size(std::string_view text)
+{
+  if (text.empty()) {
+    return -1;
+  }
+
+  int64_t scale = 1;
+  switch (text.back()) {
+  case 'k':
+  case 'K':
+    scale = int64_t(1) << 10;
+    break;
+  case 'm':
+  case 'M':
+    scale = int64_t(1) << 20;
+    break;
+  case 'g':
+  case 'G':
+    scale = int64_t(1) << 30;
+    break;
+  default:
+    break;
+  }
+  if (scale != 1) {
+    text.remove_suffix(1);
+  }
+
+  std::string digits(text);
+  char *end     = nullptr;
+  int64_t value = strtoll(digits.c_str(), &end, 10);
+  if (digits.empty() || *end != '\0' || value < 0) {
+    return -1;
+  }
+  return value * scale;
+}
+
+std::string
+RequestMix::load(std::string const &path)
+{
+  std::ifstream in(path);
+  if (!in) {
+    return "can not open " + path;
+  }
+
+  std::string line;
+  double total = 0;
+  _paths.clear();
+  while (std::getline(in, line)) {
+    std::istringstream fields(line);
+    std::string first, second;
+    if (!(fields >> first) || first[0] == '#') {
+      continue;
+    }
+
+    double weight = 1;
+    if (fields >> second) {
+      char *end = nullptr;
+      weight    = strtod(first.c_str(), &end);
+      if (*end != '\0' || weight <= 0) {
+        return "bad weight in " + path + ": " + line;
+      }
+      first = second;
+    }
+    total += weight;
+    _paths.push_back(Weighted{first, total});
+  }
+
+  if (_paths.empty()) {
+    return "no paths in " + path;
+  }
+  return {};
+}
+
+std::string
+RequestMix::set_sizes(std::string_view spec)
+{
+  double total = 0;
+  _sizes.clear();
+  while (!spec.empty()) {
+    std::string_view item = spec.substr(0, spec.find(','));
+    spec.remove_prefix(std::min(spec.size(), item.size() + 1));
+
+    double weight = 1;
+    if (auto colon = item.find(':'); colon != item.npos) {
+      std::string text(item.substr(colon + 1));
+      char *end = nullptr;
+      weight    = strtod(text.c_str(), &end);
+      if (text.empty() || *end != '\0' || weight <= 0) {
+        return "bad weight in size " + std::string(item);
+      }
+      item = item.substr(0, colon);
+    }
+
+    int64_t size = parse_size(item);
+    if (size < 0) {
+      return "bad size " + std::string(item);
+    }
+    total += weight;
+    _sizes.push_back(Weighted{std::to_string(size), total});
+  }
+
+  if (_sizes.empty()) {
+    return "no sizes given";
+  }
+  return {};
+}
+
+std::string const &
+RequestMix::pick(std::vector<Weighted> const &list, double r)
+{
+  double target = r * list.back().cumulative;
+  auto spot     = std::upper_bound(list.begin(), list.end(), target, [](double t, Weighted const &w) { return t < w.cumulative; });
+  return spot == list.end() ? list.back().value : spot->value;
+}
+
+std::string
+RequestMix::next(std::mt19937_64 &rng, int thread, uint64_t &unique) const
+{
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  if (!_paths.empty()) {
+    return pick(_paths, uniform(rng));
+  }
+
+  std::string path;
+  double size_r;
+  if (uniform(rng) < hit_ratio && hot_objects > 0) {
+    int id = std::uniform_int_distribution<int>(0, hot_objects - 1)(rng);
+
+    // The size of a hot object must not change between requests.
+    size_r = std::mt19937_64(id)() / 18446744073709551616.0;
+    path   = "/obj/hot-" + std::to_string(id);
+  } else {
+    size_r = uniform(rng);
+    path   = "/obj/t" + std::to_string(thread) + "-" + std::to_string(unique++);
+  }
+  return path + "?size=" + pick(_sizes, size_r) + "&ttl=" + std::to_string(ttl);
+}
+
+std::string
+RequestMix::describe() const
+{
+  if (!_paths.empty()) {
+    return std::to_string(_paths.size()) + " paths from file";
+  }
+
+  std::string sizes;
+  double last = 0;
+  for (auto const &size : _sizes) {
+    int percent = (size.cumulative - last) * 100 / _sizes.back().cumulative;
+    sizes       += (sizes.empty() ? "" : ",") + size.value + ":" + std::to_string(percent) + "%";
+    last        = size.cumulative;
+  }
+  return "hit ratio " + std::to_string(int(hit_ratio * 100)) + "% over " + std::to_string(hot_objects) +
+         " hot objects, sizes " + sizes + ", ttl " + std::to_string(ttl) + "s";
+}
+
+void
+Stats::merge(Stats const &that)
+{
+  latency.merge(that.latency);
+  ttfb.merge(that.ttfb);
+  connect.merge(that.connect);
+  responses    += that.responses;
+  errors       += that.errors;
+  bytes        += that.bytes;
+  opened       += that.opened;
+  failed       += that.failed;
+  resumed      += that.resumed;
+  last_done_ns = std::max(last_done_ns, that.last_done_ns);
+  for (auto const &[code, count] : that.status) {
+    status[code] += count;
+  }
+}
@@ -0,0 +1,59 @@
+#! /usr/bin/env bash
+#
+#  Settings and helpers shared by the traffic_bench scenarios.
+#
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+# Where traffic_server listens, and where the origin stub should listen.
+# remap.config must map TB_AUTHORITY to the origin stub, e.g.
+#   map http://bench.test/ http://127.0.0.1:8090/
+TB=${TB:-traffic_bench}
+TB_HOST=${TB_HOST:-127.0.0.1}
+TB_PORT=${TB_PORT:-8080}
+TB_TLS_PORT=${TB_TLS_PORT:-8443}
+TB_AUTHORITY=${TB_AUTHORITY:-bench.test}
+TB_ORIGIN_PORT=${TB_ORIGIN_PORT:-8090}
+TB_THREADS=${TB_THREADS:-4}
+TB_DURATION=${TB_DURATION:-30}
+# Prefix of the HdrHistogram files written, empty for none.
+TB_HDR_OUT=${TB_HDR_OUT:-}
+
+# Each run gets its own seed, so that objects not requested before are not in the cache.
+seed=$(date +%s)
+
+# Start the origin stub, unless one is running already, and stop it when the scenario ends.
+function start_origin() {
+  if ! (exec 3<>/dev/tcp/127.0.0.1/${TB_ORIGIN_PORT}) 2>/dev/null; then
+    ${TB} --origin --host 127.0.0.1 --port ${TB_ORIGIN_PORT} --threads ${TB_THREADS} &
+    origin_pid=$!
+    trap 'kill ${origin_pid}' EXIT
+    sleep 1
+  fi
+}
+
+# Run traffic_bench against traffic_server with the shared settings, then the arguments given.
+# The name of the run is the first argument, used for the HdrHistogram files.
+function bench() {
+  local name=$1
+  shift
+  seed=$((seed + 1))
+
+  echo "=== ${name}"
+  ${TB} --host ${TB_HOST} --authority ${TB_AUTHORITY} --threads ${TB_THREADS} --seed ${seed} \
+    ${TB_HDR_OUT:+--hdr_out ${TB_HDR_OUT}${name}} "$@"
+  echo
+}
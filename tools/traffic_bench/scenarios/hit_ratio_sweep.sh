@@ -0,0 +1,30 @@
+#! /usr/bin/env bash
+#
+#  Throughput and latency as the share of requests for cached objects goes from none to all.
+#
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+. "$(dirname "$0")/common.sh"
+
+start_origin
+# Fill the cache with the hot set first.
+bench warmup --port ${TB_PORT} --connections 50 --hit_ratio 1 --duration 10 --sizes ${TB_SIZES:-1k:70,64k:25,1m:5} > /dev/null
+
+for ratio in 0 0.5 0.8 0.9 0.95 0.99 1; do
+  bench hit-${ratio} --port ${TB_PORT} --connections ${TB_CONNECTIONS:-100} --hit_ratio ${ratio} --duration ${TB_DURATION} \
+    --sizes ${TB_SIZES:-1k:70,64k:25,1m:5}
+done
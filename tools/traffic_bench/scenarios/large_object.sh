@@ -0,0 +1,31 @@
+#! /usr/bin/env bash
+#
+#  Streaming large objects, from the cache and through from the origin, over HTTP/1.1 and HTTP/2.
+#
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+. "$(dirname "$0")/common.sh"
+
+size=${TB_OBJECT_SIZE:-64m}
+
+start_origin
+for hit_ratio in 1 0; do
+  bench large-h1-hit${hit_ratio} --port ${TB_PORT} --connections ${TB_CONNECTIONS:-16} --hot_objects 16 \
+    --hit_ratio ${hit_ratio} --sizes ${size} --duration ${TB_DURATION}
+  bench large-h2-hit${hit_ratio} --port ${TB_TLS_PORT} --tls --protocol h2 --connections ${TB_CONNECTIONS:-16} --streams 4 \
+    --hot_objects 16 --hit_ratio ${hit_ratio} --sizes ${size} --duration ${TB_DURATION}
+done
@@ -0,0 +1,29 @@
+#! /usr/bin/env bash
+#
+#  New TLS connections for every request, with full handshakes and then with resumed sessions.
+#
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+. "$(dirname "$0")/common.sh"
+
+start_origin
+for protocol in h1 h2; do
+  bench storm-${protocol}-full --port ${TB_TLS_PORT} --tls --protocol ${protocol} --keepalive 1 \
+    --connections ${TB_CONNECTIONS:-200} --hit_ratio 1 --duration ${TB_DURATION}
+  bench storm-${protocol}-resumed --port ${TB_TLS_PORT} --tls --tls_resume --protocol ${protocol} --keepalive 1 \
+    --connections ${TB_CONNECTIONS:-200} --hit_ratio 1 --duration ${TB_DURATION}
+done
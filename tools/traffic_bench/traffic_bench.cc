@@ -0,0 +1,239 @@
+/** @file
+
+  traffic_bench: a load generator reporting latency histograms, and the origin stub it requests from.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "Bench.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <sys/resource.h>
+
+#include "tscore/ink_args.h"
+#include "tscore/I_Version.h"
+#include "HuffmanCodec.h"
+
+using namespace traffic_bench;
+
+static AppVersionInfo appVersionInfo;
+
+static char host[256]       = "127.0.0.1";
+static int port             = 8080;
+static char authority[256]  = "";
+static char protocol[16]    = "h1";
+static int tls              = 0;
+static char sni[256]        = "";
+static int tls_resume       = 0;
+static int threads          = 1;
+static int connections      = 10;
+static int streams          = 10;
+static int keepalive        = 0;
+static double duration      = 10;
+static int64_t requests     = 0;
+static int64_t seed         = 1;
+static char urls_file[1024] = "";
+static char sizes[1024]     = "1k";
+static double hit_ratio     = 0.9;
+static int hot_objects      = 1000;
+static int ttl              = 3600;
+static char hdr_out[1024]   = "";
+static int origin           = 0;
+
+static const ArgumentDescription argument_descriptions[] = {
+  {"host",        'H', "Server host",                                                    "S256",  host,         "TB_HOST",        nullptr},
+  {"port",        'p', "Server port",                                                    "I",     &port,        "TB_PORT",        nullptr},
+  {"authority",   'a', "Host header / :authority (default host:port)",                   "S256",  authority,    "TB_AUTHORITY",   nullptr},
+  {"protocol",    'P', "Protocol, h1 or h2",                                             "S16",   protocol,     "TB_PROTOCOL",    nullptr},
+  {"tls",         'T', "Use TLS",                                                        "F",     &tls,         "TB_TLS",         nullptr},
+  {"sni",         ' ', "TLS server name (default host)",                                 "S256",  sni,          "TB_SNI",         nullptr},
+  {"tls_resume",  'R', "Resume TLS sessions",                                            "F",     &tls_resume,  "TB_TLS_RESUME",  nullptr},
+  {"threads",     't', "Client threads",                                                 "I",     &threads,     "TB_THREADS",     nullptr},
+  {"connections", 'c', "Connections, spread over the threads",                           "I",     &connections, "TB_CONNECTIONS", nullptr},
+  {"streams",     's', "Concurrent streams per HTTP/2 connection",                       "I",     &streams,     "TB_STREAMS",     nullptr},
+  {"keepalive",   'k', "Requests per connection (0:unlimited)",                          "I",     &keepalive,   "TB_KEEPALIVE",   nullptr},
+  {"duration",    'd', "Seconds to run, at most",                                        "D",     &duration,    "TB_DURATION",    nullptr},
+  {"requests",    'n', "Requests to make, at most (0:unlimited)",                        "L",     &requests,    "TB_REQUESTS",    nullptr},
+  {"seed",        ' ', "Random number seed",                                             "L",     &seed,        "TB_SEED",        nullptr},
+  {"urls",        'u', "Paths to request from file, each with an optional weight first", "S1024", urls_file,    "TB_URLS",        nullptr},
+  {"sizes",       'z', "Object sizes with weights, e.g. 1k:70,64k:25,1m:5",              "S1024", sizes,        "TB_SIZES",       nullptr},
+  {"hit_ratio",   'r', "Fraction of requests for the hot set",                           "D",     &hit_ratio,   "TB_HIT_RATIO",   nullptr},
+  {"hot_objects", 'o', "Objects in the hot set",                                         "I",     &hot_objects, "TB_HOT_OBJECTS", nullptr},
+  {"ttl",         'l', "max-age of objects (0:no-store)",                                "I",     &ttl,         "TB_TTL",         nullptr},
+  {"hdr_out",     ' ', "Write HdrHistogram .hgrm files with this prefix",                "S1024", hdr_out,      "TB_HDR_OUT",     nullptr},
+  {"origin",      ' ', "Run the origin stub on host:port instead",                       "F",     &origin,      "TB_ORIGIN",      nullptr},
+  HELP_ARGUMENT_DESCRIPTION(),
+  VERSION_ARGUMENT_DESCRIPTION()
+};
+static unsigned n_argument_descriptions = countof(argument_descriptions);
+
+static void
+raise_fd_limit()
+{
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+  }
+}
+
+static void
+print_latency(char const *name, Histogram const &h)
+{
+  static const double NS_PER_MS = 1e6;
+
+  printf("%-10s", name);
+  for (double pct : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+    printf(" %9.3f", h.percentile(pct) / NS_PER_MS);
+  }
+  printf(" %9.3f %9.3f %9llu\n", h.max() / NS_PER_MS, h.mean() / NS_PER_MS, static_cast<unsigned long long>(h.count()));
+}
+
+static void
+write_distribution(char const *name, Histogram const &h)
+{
+  std::string path = std::string(hdr_out) + "." + name + ".hgrm";
+  FILE *out        = fopen(path.c_str(), "w");
+  if (!out) {
+    fprintf(stderr, "traffic_bench: can not write %s: %s\n", path.c_str(), strerror(errno));
+    return;
+  }
+  h.print_distribution(out, 1e6);
+  fclose(out);
+}
+
+static void
+report(Options const &opts, Stats const &stats, double seconds)
+{
+  constexpr double MB = 1024 * 1024;
+
+  printf("duration    %.2f s\n", seconds);
+  printf("requests    %llu (%.1f/s), %llu errors\n", static_cast<unsigned long long>(stats.responses), stats.responses / seconds,
+         static_cast<unsigned long long>(stats.errors));
+  printf("transfer    %.1f MB (%.1f MB/s)\n", stats.bytes / MB, stats.bytes / MB / seconds);
+  printf("connections %llu opened (%.1f/s), %llu failed", static_cast<unsigned long long>(stats.opened), stats.opened / seconds,
+         static_cast<unsigned long long>(stats.failed));
+  if (opts.tls) {
+    printf(", %llu resumed", static_cast<unsigned long long>(stats.resumed));
+  }
+  printf("\nstatus     ");
+  for (auto const &[code, count] : stats.status) {
+    printf(" %d:%llu", code, static_cast<unsigned long long>(count));
+  }
+  printf("\n\n%-10s %9s %9s %9s %9s %9s %9s %9s %9s\n", "(ms)", "p50", "p90", "p99", "p99.9", "p99.99", "max", "mean", "count");
+  print_latency("latency", stats.latency);
+  print_latency("ttfb", stats.ttfb);
+  print_latency("connect", stats.connect);
+
+  if (hdr_out[0]) {
+    write_distribution("latency", stats.latency);
+    write_distribution("ttfb", stats.ttfb);
+    write_distribution("connect", stats.connect);
+  }
+}
+
+int
+main(int /* argc ATS_UNUSED */, const char *argv[])
+{
+  appVersionInfo.setup(PACKAGE_NAME, "traffic_bench", PACKAGE_VERSION, __DATE__, __TIME__, BUILD_MACHINE, BUILD_PERSON, "");
+  process_args(&appVersionInfo, argument_descriptions, n_argument_descriptions, argv);
+
+  signal(SIGPIPE, SIG_IGN);
+  raise_fd_limit();
+
+  if (threads < 1 || connections < threads || streams < 1 || keepalive < 0 || requests < 0) {
+    fprintf(stderr, "traffic_bench: threads, connections and streams must be positive, with a connection per thread\n");
+    return 1;
+  }
+
+  if (origin) {
+    std::string error = run_origin(host, port, threads);
+    fprintf(stderr, "traffic_bench: %s\n", error.c_str());
+    return 1;
+  }
+
+  Options opts;
+  if (strcmp(protocol, "h1") == 0 || strcmp(protocol, "http/1.1") == 0) {
+    opts.protocol = Protocol::HTTP1;
+  } else if (strcmp(protocol, "h2") == 0) {
+    opts.protocol = Protocol::HTTP2;
+  } else if (strcmp(protocol, "h3") == 0) {
+    fprintf(stderr, "traffic_bench: HTTP/3 is not supported, there is no QUIC client library to build with\n");
+    return 1;
+  } else {
+    fprintf(stderr, "traffic_bench: unknown protocol %s\n", protocol);
+    return 1;
+  }
+
+  opts.host        = host;
+  opts.port        = port;
+  opts.authority   = authority;
+  opts.tls         = tls;
+  opts.sni         = sni;
+  opts.tls_resume  = tls_resume;
+  opts.threads     = threads;
+  opts.connections = connections;
+  opts.streams     = streams;
+  opts.keepalive   = keepalive;
+  opts.duration    = duration;
+  opts.requests    = requests;
+  opts.seed        = seed;
+
+  std::string error;
+  if (urls_file[0]) {
+    error = opts.mix.load(urls_file);
+  } else {
+    error                = opts.mix.set_sizes(sizes);
+    opts.mix.hit_ratio   = hit_ratio;
+    opts.mix.hot_objects = hot_objects;
+    opts.mix.ttl         = ttl;
+  }
+  if (!error.empty()) {
+    fprintf(stderr, "traffic_bench: %s\n", error.c_str());
+    return 1;
+  }
+
+  hpack_huffman_init();
+
+  printf("%s%s to %s:%d, %d threads, %d connections", opts.protocol == Protocol::HTTP2 ? "h2" : "http/1.1", tls ? " over TLS" : "",
+         host, port, threads, connections);
+  if (opts.protocol == Protocol::HTTP2) {
+    printf(" of %d streams", streams);
+  }
+  if (keepalive) {
+    printf(", %d requests per connection", keepalive);
+  }
+  printf("\nmix         %s\n", opts.mix.describe().c_str());
+  fflush(stdout);
+
+  Stats stats;
+  int64_t start = now_ns();
+  if (error = run_client(opts, stats); !error.empty()) {
+    fprintf(stderr, "traffic_bench: %s\n", error.c_str());
+    return 1;
+  }
+  int64_t end = stats.last_done_ns > start ? stats.last_done_ns : now_ns();
+
+  report(opts, stats, std::max<double>(end - start, 1) / 1e9);
+  return stats.errors || stats.responses == 0 ? 2 : 0;
+}